@@ -0,0 +1,308 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+
+#include "Base/AsyncLog.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <pthread.h>
+
+#include "Base/Globals.h"
+#include "Base/SysCall.h"
+#include "Base/TimeUtils.h"
+#include "securec.h"
+
+namespace MapleRuntime {
+namespace {
+constexpr size_t RING_SIZE = 64 * 1024;
+constexpr size_t RECORD_ALIGNMENT = 8;
+constexpr uint64_t FLUSH_INTERVAL_MS = 20;
+
+// kind of a ring entry
+constexpr uint16_t RECORD_LOG = 0;
+constexpr uint16_t RECORD_PADDING = 1;
+
+struct RecordHeader {
+    uint32_t size; // whole entry size including this header, aligned to RECORD_ALIGNMENT
+    uint16_t kind;
+    uint8_t type;
+    uint8_t addPrefix;
+    int32_t tid;
+    uint32_t length; // message length, not counting the terminating '\0'
+    uint64_t timestamp;
+};
+
+constexpr size_t MAX_RECORD_SIZE = sizeof(RecordHeader) + LOG_BUFFER_SIZE;
+
+// single producer (owning thread), single consumer (flusher) ring.
+struct LogRing {
+    std::atomic<uint64_t> head{ 0 }; // advanced by the flusher
+    std::atomic<uint64_t> tail{ 0 }; // advanced by the owner
+    std::atomic<bool> inUse{ false };
+    volatile bool writing = false; // set while the owner appends, catches reentrance from signal handlers
+    LogRing* next = nullptr;
+    alignas(RECORD_ALIGNMENT) char data[RING_SIZE];
+};
+
+std::atomic<LogRing*> g_rings{ nullptr };
+std::atomic<bool> g_asyncRunning{ false };
+std::atomic<size_t> g_droppedRecords[LOG_TYPE_NUMBER];
+
+std::mutex g_flushLock;
+std::condition_variable g_flushCondition;
+std::atomic<bool> g_flushRequested{ false };
+bool g_stopFlusher = false;
+pthread_t g_flusherThread;
+
+bool IsAsyncLogEnabled()
+{
+    auto env = std::getenv("MRT_LOG_ASYNC");
+    if (env == nullptr) {
+        return false;
+    }
+    return CString::ParseFlagFromEnv(env);
+}
+
+// rings are never freed, a ring released by an exited thread is reused by the next new thread.
+LogRing* ClaimRing()
+{
+    for (LogRing* ring = g_rings.load(std::memory_order_acquire); ring != nullptr; ring = ring->next) {
+        bool expected = false;
+        if (!ring->inUse.load(std::memory_order_relaxed) &&
+            ring->inUse.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+            return ring;
+        }
+    }
+    LogRing* ring = new (std::nothrow) LogRing();
+    if (ring == nullptr) {
+        return nullptr;
+    }
+    ring->inUse.store(true, std::memory_order_relaxed);
+    LogRing* head = g_rings.load(std::memory_order_relaxed);
+    do {
+        ring->next = head;
+    } while (!g_rings.compare_exchange_weak(head, ring, std::memory_order_release, std::memory_order_relaxed));
+    return ring;
+}
+
+struct RingHolder {
+    ~RingHolder()
+    {
+        if (ring != nullptr) {
+            ring->inUse.store(false, std::memory_order_release);
+        }
+    }
+    LogRing* ring = nullptr;
+};
+
+thread_local RingHolder t_ringHolder;
+
+void RequestFlush()
+{
+    if (!g_flushRequested.exchange(true, std::memory_order_relaxed)) {
+        g_flushCondition.notify_one();
+    }
+}
+
+void WriteDropped(LogType type)
+{
+    size_t dropped = g_droppedRecords[type].exchange(0, std::memory_order_relaxed);
+    if (dropped == 0) {
+        return;
+    }
+    char buf[LOG_BUFFER_SIZE];
+    int len = sprintf_s(buf, sizeof(buf), "%s async log dropped %zu records", TimeUtil::GetTimestamp().Str(),
+                        dropped);
+    if (len != -1) {
+        LogFile::WriteRecord(type, buf, len, false);
+    }
+}
+
+void WriteRecord(const RecordHeader& header, const char* msg)
+{
+    LogType type = static_cast<LogType>(header.type);
+    if (header.addPrefix == 0) {
+        LogFile::WriteRecord(type, msg, static_cast<int>(header.length), false);
+        return;
+    }
+    char buf[LOG_BUFFER_SIZE];
+    int index = sprintf_s(buf, sizeof(buf), "%s %d ", TimeUtil::GetTimestamp(header.timestamp).Str(), header.tid);
+    if (index == -1) {
+        PRINT_ERROR("AsyncLog sprintf_s failed. msg: %s\n", strerror(errno));
+        return;
+    }
+    // keep the whole line within LOG_BUFFER_SIZE, as the synchronous path does.
+    size_t length = std::min(static_cast<size_t>(header.length), sizeof(buf) - index - 1);
+    if (memcpy_s(buf + index, sizeof(buf) - index, msg, length) != EOK) {
+        return;
+    }
+    index += static_cast<int>(length);
+    buf[index] = '\0';
+    LogFile::WriteRecord(type, buf, index, false);
+}
+
+void DrainRings()
+{
+    bool touched[LOG_TYPE_NUMBER] = { false };
+    for (LogRing* ring = g_rings.load(std::memory_order_acquire); ring != nullptr; ring = ring->next) {
+        uint64_t head = ring->head.load(std::memory_order_relaxed);
+        uint64_t tail = ring->tail.load(std::memory_order_acquire);
+        while (head < tail) {
+            size_t pos = head % RING_SIZE;
+            if (RING_SIZE - pos < sizeof(RecordHeader)) {
+                head += RING_SIZE - pos;
+                continue;
+            }
+            const RecordHeader* header = reinterpret_cast<const RecordHeader*>(ring->data + pos);
+            if (header->kind == RECORD_LOG) {
+                WriteRecord(*header, ring->data + pos + sizeof(RecordHeader));
+                touched[header->type] = true;
+            }
+            head += header->size;
+        }
+        ring->head.store(head, std::memory_order_release);
+    }
+    for (int i = 0; i < LOG_TYPE_NUMBER; ++i) {
+        LogType type = static_cast<LogType>(i);
+        if (g_droppedRecords[i].load(std::memory_order_relaxed) != 0) {
+            WriteDropped(type);
+            touched[i] = true;
+        }
+        if (touched[i]) {
+            LogFile::Flush(type);
+        }
+    }
+}
+
+void* RunFlusher(void*)
+{
+#ifdef __APPLE__
+    (void)pthread_setname_np("log-flusher");
+#elif defined(__linux__) || defined(hongmeng)
+    (void)prctl(PR_SET_NAME, "log-flusher");
+#endif
+    std::unique_lock<std::mutex> lock(g_flushLock);
+    while (!g_stopFlusher) {
+        g_flushCondition.wait_for(lock, std::chrono::milliseconds(FLUSH_INTERVAL_MS), [] {
+            return g_stopFlusher || g_flushRequested.load(std::memory_order_relaxed);
+        });
+        g_flushRequested.store(false, std::memory_order_relaxed);
+        lock.unlock();
+        DrainRings();
+        lock.lock();
+    }
+    lock.unlock();
+    DrainRings();
+    return nullptr;
+}
+
+// A ring entry is written at a contiguous position, wrapping with a padding entry when the tail is short.
+bool Reserve(LogRing& ring, size_t size, uint64_t& tail, size_t& pos)
+{
+    tail = ring.tail.load(std::memory_order_relaxed);
+    uint64_t head = ring.head.load(std::memory_order_acquire);
+    pos = tail % RING_SIZE;
+    size_t contiguous = RING_SIZE - pos;
+    size_t needed = contiguous < size ? contiguous + size : size;
+    if (RING_SIZE - (tail - head) < needed) {
+        return false;
+    }
+    if (contiguous < size) {
+        if (contiguous >= sizeof(RecordHeader)) {
+            RecordHeader* padding = reinterpret_cast<RecordHeader*>(ring.data + pos);
+            padding->size = static_cast<uint32_t>(contiguous);
+            padding->kind = RECORD_PADDING;
+        }
+        tail += contiguous;
+        pos = 0;
+    }
+    return true;
+}
+} // namespace
+
+void AsyncLog::Start()
+{
+    if (!IsAsyncLogEnabled() || g_asyncRunning.load(std::memory_order_relaxed)) {
+        return;
+    }
+    g_stopFlusher = false;
+    CHECK_PTHREAD_CALL(pthread_create, (&g_flusherThread, nullptr, RunFlusher, nullptr), "create log flusher");
+    g_asyncRunning.store(true, std::memory_order_release);
+}
+
+void AsyncLog::Stop()
+{
+    if (!g_asyncRunning.exchange(false, std::memory_order_acq_rel)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(g_flushLock);
+        g_stopFlusher = true;
+    }
+    g_flushCondition.notify_one();
+    (void)pthread_join(g_flusherThread, nullptr);
+    // records appended while the flusher was exiting.
+    DrainRings();
+}
+
+bool AsyncLog::Append(bool addPrefix, LogType type, const char* format, va_list& args)
+{
+    if (!g_asyncRunning.load(std::memory_order_acquire)) {
+        return false;
+    }
+    RingHolder& holder = t_ringHolder;
+    if (holder.ring == nullptr) {
+        holder.ring = ClaimRing();
+        if (holder.ring == nullptr) {
+            return false;
+        }
+    }
+    LogRing& ring = *holder.ring;
+    if (ring.writing) {
+        return false;
+    }
+    ring.writing = true;
+
+    uint64_t tail = 0;
+    size_t pos = 0;
+    if (!Reserve(ring, MAX_RECORD_SIZE, tail, pos)) {
+        g_droppedRecords[type].fetch_add(1, std::memory_order_relaxed);
+        ring.writing = false;
+        RequestFlush();
+        return true;
+    }
+    RecordHeader* header = reinterpret_cast<RecordHeader*>(ring.data + pos);
+    char* msg = ring.data + pos + sizeof(RecordHeader);
+    int len = vsprintf_s(msg, LOG_BUFFER_SIZE, format, args);
+    if (len == -1) {
+        PRINT_ERROR("AsyncLog vsprintf_s failed. msg: %s\n", strerror(errno));
+        ring.writing = false;
+        return true;
+    }
+    header->kind = RECORD_LOG;
+    header->type = static_cast<uint8_t>(type);
+    header->addPrefix = addPrefix ? 1 : 0;
+    header->length = static_cast<uint32_t>(len);
+    header->size = static_cast<uint32_t>(AlignUp<size_t>(sizeof(RecordHeader) + len + 1, RECORD_ALIGNMENT));
+    if (addPrefix) {
+        header->tid = MapleRuntime::GetTid();
+        header->timestamp = TimeUtil::RealtimeMicroSeconds();
+    }
+    uint64_t newTail = tail + header->size;
+    ring.tail.store(newTail, std::memory_order_release);
+    ring.writing = false;
+
+    if (newTail - ring.head.load(std::memory_order_relaxed) > RING_SIZE / 2) {
+        RequestFlush();
+    }
+    return true;
+}
+} // namespace MapleRuntime
@@ -0,0 +1,30 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+
+#ifndef MRT_ASYNC_LOG_H
+#define MRT_ASYNC_LOG_H
+
+#include <cstdarg>
+
+#include "Base/LogFile.h"
+
+namespace MapleRuntime {
+// Asynchronous backend of WriteLog (VLOG/DLOG), enabled by MRT_LOG_ASYNC=1.
+// Each writing thread owns a single-producer ring buffer, so logging takes no lock. A record keeps its
+// timestamp and tid in binary form and the flusher thread formats the line prefix, writes records to the
+// LogFile files with the usual size based rotation and flushes each file once per pass. Records that do
+// not fit into a full ring are dropped and reported in the log they belong to.
+class AsyncLog {
+public:
+    static void Start();
+    static void Stop();
+
+    // returns false if the caller has to write the record synchronously.
+    static bool Append(bool addPrefix, LogType type, const char* format, va_list& args);
+};
+} // namespace MapleRuntime
+#endif // MRT_ASYNC_LOG_H
@@ -7,6 +7,7 @@
 
 #include "LogFile.h"
 
+#include "Base/AsyncLog.h"
 #include "Base/SysCall.h"
 #include "securec.h"
 
@@ -40,9 +41,15 @@ void LogFile::Init()
 #if defined(MRT_DEBUG) && (MRT_DEBUG == 1)
     OpenLogFiles();
 #endif
+    AsyncLog::Start();
 }
 
-void LogFile::Fini() { CloseLogFiles(); }
+void LogFile::Fini()
+{
+    // pending records must reach their files before those are closed.
+    AsyncLog::Stop();
+    CloseLogFiles();
+}
 
 void LogFile::SetFlagWithEnv(const char* env, LogType type)
 {
@@ -126,60 +133,79 @@ void LogFile::CloseLogFiles()
     }
 }
 
-static void WriteLogImpl(bool addPrefix, LogType type, const char* format, va_list& args)
+// Writes one formatted line (without the trailing '\n') and rotates the file like every other log line.
+void LogFile::WriteRecord(LogType type, const char* buf, int len, bool flush)
 {
-    char buf[LOG_BUFFER_SIZE];
-    if (!LogFile::LogIsEnabled(type)) {
-        return;
-    }
-    int index = 0;
-    if (addPrefix) {
-        index = sprintf_s(buf, sizeof(buf), "%s %d ", TimeUtil::GetTimestamp().Str(), MapleRuntime::GetTid());
-        if (index == -1) {
-            PRINT_ERROR("WriteLogImpl sprintf_s failed. msg: %s\n", strerror(errno));
-            return;
-        }
-    }
-
-    int ret = vsprintf_s(buf + index, sizeof(buf) - index, format, args);
-    if (ret == -1) {
-        PRINT_ERROR("WriteLogImpl vsprintf_s failed. msg: %s\n", strerror(errno));
-        return;
-    }
-    index += ret;
-
-    LogFile::LogFileLock(type);
+    LogFileLock(type);
 #if defined(__OHOS__) && (__OHOS__ == 1)
     auto env = CString(std::getenv("MRT_REPORT"));
     if (env.Str() == nullptr) {
         if (Logger::GetLogger().GetMinimumLogLevel() == RTLOG_INFO) {
             PRINT_INFO("%{public}s\n", buf);
         }
-        LogFile::LogFileUnLock(type);
+        LogFileUnLock(type);
         return;
     }
 #endif
-    FILE* file = LogFile::GetFile(type);
+    FILE* file = GetFile(type);
     if (file == nullptr) {
         PRINT_ERROR("WriteLog failed. MRT_REPORT is not a valid path. Please check again.");
-        LogFile::LogFileUnLock(type);
+        LogFileUnLock(type);
         return;
     }
     int err = fprintf(file, "%s\n", buf);
-    if ((err - 1) != index) { // 1 = '\n'
+    if ((err - 1) != len) { // 1 = '\n'
         PRINT_ERROR("WriteLogImpl fprintf failed. msg: %s\n", strerror(errno));
-        LogFile::LogFileUnLock(type);
+        LogFileUnLock(type);
         return;
     }
 #ifndef MRT_DEBUG
-    size_t curPos = LogFile::GetCurPosLocation(type);
-    LogFile::SetCurPosLocation(type, curPos + index);
-    if (Logger::MaybeRotate(curPos + index, LogFile::GetMaxFileSize(type), file)) {
-        LogFile::SetCurPosLocation(type, 0);
+    size_t curPos = GetCurPosLocation(type);
+    SetCurPosLocation(type, curPos + len);
+    if (Logger::MaybeRotate(curPos + len, GetMaxFileSize(type), file)) {
+        SetCurPosLocation(type, 0);
     }
 #endif
-    fflush(file);
-    LogFile::LogFileUnLock(type);
+    if (flush) {
+        fflush(file);
+    }
+    LogFileUnLock(type);
+}
+
+void LogFile::Flush(LogType type)
+{
+    LogFileLock(type);
+    if (logFile[type].file != nullptr) {
+        fflush(logFile[type].file);
+    }
+    LogFileUnLock(type);
+}
+
+static void WriteLogImpl(bool addPrefix, LogType type, const char* format, va_list& args)
+{
+    char buf[LOG_BUFFER_SIZE];
+    if (!LogFile::LogIsEnabled(type)) {
+        return;
+    }
+    if (AsyncLog::Append(addPrefix, type, format, args)) {
+        return;
+    }
+    int index = 0;
+    if (addPrefix) {
+        index = sprintf_s(buf, sizeof(buf), "%s %d ", TimeUtil::GetTimestamp().Str(), MapleRuntime::GetTid());
+        if (index == -1) {
+            PRINT_ERROR("WriteLogImpl sprintf_s failed. msg: %s\n", strerror(errno));
+            return;
+        }
+    }
+
+    int ret = vsprintf_s(buf + index, sizeof(buf) - index, format, args);
+    if (ret == -1) {
+        PRINT_ERROR("WriteLogImpl vsprintf_s failed. msg: %s\n", strerror(errno));
+        return;
+    }
+    index += ret;
+    LogFile::WriteRecord(type, buf, index, true);
 }
 
 void WriteLog(bool addPrefix, LogType type, const char* format, ...) noexcept
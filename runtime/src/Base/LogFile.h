@@ -238,6 +238,10 @@ public:
 
     static RTLogLevel GetLogLevel() { return logLevel; }
 
+    static void WriteRecord(LogType type, const char* buf, int len, bool flush);
+
+    static void Flush(LogType type);
+
 private:
 #if defined(MRT_DEBUG) && (MRT_DEBUG == 1)
     static void OpenLogFiles();
@@ -65,15 +65,21 @@ CString GetDigitDate()
 }
 #endif
 
-CString GetTimestamp()
+uint64_t RealtimeMicroSeconds() noexcept
 {
-    // yyyy-mm-dd hh:mm::ss.ms format
     std::chrono::system_clock::time_point now = std::chrono::system_clock::now();
-    std::chrono::microseconds us = std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch());
+    return std::chrono::duration_cast<std::chrono::microseconds>(now.time_since_epoch()).count();
+}
+
+CString GetTimestamp() { return GetTimestamp(RealtimeMicroSeconds()); }
+
+CString GetTimestamp(uint64_t realtimeMicroSeconds)
+{
+    // yyyy-mm-dd hh:mm::ss.ms format
     constexpr size_t microSecondsPerSecond = 1000000;
-    auto rem = us.count() % microSecondsPerSecond;
+    auto rem = realtimeMicroSeconds % microSecondsPerSecond;
 
-    time_t time = std::chrono::system_clock::to_time_t(now);
+    time_t time = static_cast<time_t>(realtimeMicroSeconds / microSecondsPerSecond);
     struct tm tm;
 #ifdef _WIN64
     (void)localtime_s(&tm, &time);
@@ -33,8 +33,14 @@ void SleepForNano(uint64_t ns);
 CString GetDigitDate();
 #endif
 
+// returns the wall clock time since unix epoch in microseconds
+uint64_t RealtimeMicroSeconds() noexcept;
+
 // returns the current date in ISO yyyy-mm-dd hh:mm::ss.ms format
 MRT_EXPORT CString GetTimestamp();
+
+// returns the given RealtimeMicroSeconds() value in ISO yyyy-mm-dd hh:mm::ss.ms format
+CString GetTimestamp(uint64_t realtimeMicroSeconds);
 } // namespace TimeUtil
 } // namespace MapleRuntime
 #endif // MRT_TIME_UTILS_H
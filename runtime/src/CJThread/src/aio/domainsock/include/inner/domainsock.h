@@ -94,6 +94,24 @@ int DomainsockConnect(SignedSocket fd, const struct sockaddr *addr,
  */
 int DomainsockDisconnect(SignedSocket connFd);
 
+/**
+ * @brief  domain socket wait send events
+ * @param fd            [IN] socket handle
+ * @param timeout       [IN] timeout
+ * @retval #0 The function is executed successfully
+ * @retval #error Failed to execute the function
+ */
+int DomainsockWaitSend(SignedSocket fd, unsigned long long timeout);
+
+/**
+ * @brief  domain socket wait recv events
+ * @param fd            [IN] socket handle
+ * @param timeout       [IN] timeout
+ * @retval #0 The function is executed successfully
+ * @retval #error Failed to execute the function
+ */
+int DomainsockWaitRecv(SignedSocket fd, unsigned long long timeout);
+
 #ifdef __cplusplus
 #if __cplusplus
 }
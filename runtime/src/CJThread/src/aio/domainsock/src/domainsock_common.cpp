@@ -230,6 +230,31 @@ int DomainsockBindConnect(int connFd, struct SockAddr *local, struct SockAddr *p
     return 0;
 }
 
+static int DomainsockWait(SignedSocket fd, SchdpollEventType type, unsigned long long timeout)
+{
+    int ret = SchdfdLock(fd, type);
+    if (ret != 0) {
+        return ret;
+    }
+    if (timeout == static_cast<unsigned long long>(-1)) {
+        ret = SchdfdWaitInlock(fd, type);
+    } else {
+        ret = SchdfdWaitInlockTimeout(fd, type, timeout);
+    }
+    SchdfdUnlock(fd, type);
+    return ret;
+}
+
+int DomainsockWaitSend(SignedSocket fd, unsigned long long timeout)
+{
+    return DomainsockWait(fd, SHCDPOLL_WRITE, timeout);
+}
+
+int DomainsockWaitRecv(SignedSocket fd, unsigned long long timeout)
+{
+    return DomainsockWait(fd, SHCDPOLL_READ, timeout);
+}
+
 __attribute__((constructor)) int DomainsockInit(void)
 {
     int ret;
@@ -241,17 +266,26 @@ __attribute__((constructor)) int DomainsockInit(void)
     hooks.connect = DomainsockBindConnect;
     hooks.disconnect = DomainsockDisconnect;
     hooks.send = SockSendGeneral;
-    hooks.sendNonBlock = nullptr;
-    hooks.waitSend = nullptr;
+    hooks.sendNonBlock = SockSendNonBlockGeneral;
+    hooks.waitSend = DomainsockWaitSend;
     hooks.recv = SockRecvGeneral;
-    hooks.recvNonBlock = nullptr;
-    hooks.waitRecv = nullptr;
+    hooks.sendv = SockSendvGeneral;
+    hooks.recvv = SockRecvvGeneral;
+    hooks.recvNonBlock = SockRecvNonBlockGeneral;
+    hooks.waitRecv = DomainsockWaitRecv;
     hooks.close = SockCloseGeneral;
     hooks.shutdown = SockShutdownGeneral;
     hooks.keepAliveSet = nullptr;
     hooks.sockAddrGet = SockAddrGetGeneral;
     hooks.recvfrom = SockRecvfromGeneral;
     hooks.recvfromNonBlock = nullptr;
+    hooks.recvfromBatch = nullptr;
+    hooks.sendtoBatch = nullptr;
+#ifdef MRT_LINUX
+    hooks.sendFile = SockSendFileGeneral;
+#else
+    hooks.sendFile = nullptr;
+#endif
     hooks.sendto = SockSendtoGeneral;
     hooks.sendtoNonBlock = nullptr;
     hooks.createSocket = DomainsockCreate;
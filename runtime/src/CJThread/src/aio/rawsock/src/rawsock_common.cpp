@@ -257,6 +257,11 @@ void RawsockRegisterSocketHooks(struct SockCommHooks *hooks)
     hooks->waitRecv = nullptr;
     hooks->recvfrom = SockRecvfromGeneral;
     hooks->recvfromNonBlock = nullptr;
+    hooks->recvfromBatch = nullptr;
+    hooks->sendv = nullptr;
+    hooks->recvv = nullptr;
+    hooks->sendtoBatch = nullptr;
+    hooks->sendFile = nullptr;
     hooks->sendto = SockSendtoGeneral;
     hooks->sendtoNonBlock = nullptr;
 #else
@@ -268,6 +273,11 @@ void RawsockRegisterSocketHooks(struct SockCommHooks *hooks)
     hooks->waitRecv = RawsockWaitRecv;
     hooks->recvfrom = nullptr;
     hooks->recvfromNonBlock = SockRecvfromNonBlockGeneral;
+    hooks->recvfromBatch = nullptr;
+    hooks->sendv = nullptr;
+    hooks->recvv = nullptr;
+    hooks->sendtoBatch = nullptr;
+    hooks->sendFile = nullptr;
     hooks->sendto = nullptr;
     hooks->sendtoNonBlock = SockSendtoNonBlockGeneral;
 #endif
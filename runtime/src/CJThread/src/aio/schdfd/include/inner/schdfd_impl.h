@@ -61,11 +61,6 @@ extern "C" {
  */
 #define ERRNO_SCHDFD_NOT_ADD_NETPOLL ((MID_SCHDFD) | 0x0007)
 
-/**
- * @brief 0 Set null timer to schdfd.
- */
-#define SCHDFD_TIMER_NULL 0
-
 /**
  * @brief 0xffffffff The maximum number of fd that
  * can be managed by the scheduling I/O is UINT_MAX.
@@ -299,8 +294,6 @@ int SchdfdPdPut(int fd, struct SchdpollDesc *pd);
 
 #endif
 
-int FreeSchdfdTimer(struct SchdfdFd *schdFd, SchdpollEventType type);
-
 #ifdef __cplusplus
 #if __cplusplus
 }
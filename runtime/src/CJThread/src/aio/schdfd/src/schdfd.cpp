@@ -7,10 +7,12 @@
 
 #include <cerrno>
 #include <cstdint>
+#include <cstdlib>
 #include "schdfd_impl.h"
 #include "schedule_impl.h"
 #include "processor.h"
 #include "timer_impl.h"
+#include "basetime.h"
 #include "securec.h"
 #include "log.h"
 #include "external.h"
@@ -183,8 +185,8 @@ static int SchdfdFdInit(struct SchdfdFd *schdFd)
         SemaDelete(&schdFd->readSema);
         return ERRNO_SCHDFD_INIT_RESOURCE_FAILED;
     }
-    schdFd->readTimer = SCHDFD_TIMER_NULL;
-    schdFd->writeTimer = SCHDFD_TIMER_NULL;
+    schdFd->readDeadline = nullptr;
+    schdFd->writeDeadline = nullptr;
     return 0;
 }
 
@@ -253,6 +255,204 @@ void SchdfdWakeall(struct SchdfdFd *schdFd)
     }
 }
 
+/* Slack of wait deadlines in ns, configured by cjSchdfdTimerSlack. Deadlines are rounded up to
+ * a multiple of the slack, so that waits ending close to each other share one timer wakeup. */
+static unsigned long long SchdfdTimerSlackGet(void)
+{
+    static unsigned long long slack = []() {
+        const char *env = std::getenv("cjSchdfdTimerSlack");
+        return env == nullptr ? 0ULL : strtoull(env, nullptr, 0);
+    }();
+    return slack;
+}
+
+/* Deadline timers are periodic with the maximum period, so that a fired timer keeps waiting
+ * and can be reset by its callback instead of being created again. */
+const unsigned long long SCHDFD_DEADLINE_PERIOD = static_cast<unsigned long long>(-1);
+
+/* A timer without waits is released after staying idle for this long (1s), so that busy fds keep
+ * reusing it and idle fds do not hold timers. */
+const unsigned long long SCHDFD_DEADLINE_IDLE_TIME = 1000000000ULL;
+
+/* The caller must hold deadline->lock. */
+static void SchdfdDeadlineTimerFree(struct SchdfdDeadline *deadline)
+{
+    (void)TimerStop(deadline->timer);
+    (void)TimerRelease(deadline->timer);
+    deadline->timer = nullptr;
+}
+
+/* Timer callback of a deadline. */
+static void SchdfdDeadlineExpire(void *args)
+{
+    struct SchdfdDeadline *deadline = static_cast<struct SchdfdDeadline *>(args);
+    struct CJThread *cjthread = nullptr;
+    unsigned long long now;
+    int ret;
+
+    pthread_mutex_lock(&deadline->lock);
+    if (deadline->closed) {
+        SchdfdDeadlineTimerFree(deadline);
+        pthread_mutex_unlock(&deadline->lock);
+        pthread_mutex_destroy(&deadline->lock);
+        free(deadline);
+        return;
+    }
+    now = CurrentNanotimeGet();
+    if (deadline->deadline != 0 && now < deadline->deadline) {
+        // Armed by an earlier wait, move on to the deadline of the current wait.
+        ret = TimerReset(deadline->timer, deadline->deadline - now, SCHDFD_DEADLINE_PERIOD, nullptr, nullptr);
+        if (ret == 0) {
+            deadline->armed = deadline->deadline;
+        } else {
+            LOG_ERROR(ret, "timer reset failed");
+        }
+        pthread_mutex_unlock(&deadline->lock);
+        return;
+    }
+    if (deadline->deadline != 0) {
+        // Timer timeout is also considered as a ready event, and it is up to the waiter
+        // to determine which situation it is.
+        deadline->expired = true;
+        deadline->deadline = 0;
+        cjthread = SchdpollReady(deadline->pd, static_cast<SchdpollEventType>(deadline->type), true);
+    }
+    // No wait is pending. Keep the timer for one idle period, and release it if no wait is armed meanwhile.
+    ret = -1;
+    if (!deadline->idle) {
+        ret = TimerReset(deadline->timer, SCHDFD_DEADLINE_IDLE_TIME, SCHDFD_DEADLINE_PERIOD, nullptr, nullptr);
+    }
+    if (ret == 0) {
+        deadline->idle = true;
+        deadline->armed = TimerDeadlineCheck(now, SCHDFD_DEADLINE_IDLE_TIME);
+    } else {
+        SchdfdDeadlineTimerFree(deadline);
+    }
+    pthread_mutex_unlock(&deadline->lock);
+    if (cjthread != nullptr) {
+        ProcessorLocalWrite(cjthread);
+        ProcessorWake(cjthread->schedule, nullptr);
+    }
+}
+
+static void SchdfdDeadlineRelease(struct SchdfdDeadline *deadline);
+
+/* Get the deadline of the fd in the direction of type, it is created by the first timed wait. */
+static struct SchdfdDeadline *SchdfdDeadlineGet(struct SchdfdFd *schdFd, SchdpollEventType type)
+{
+    std::atomic<struct SchdfdDeadline *> *slot = (type == SHCDPOLL_READ) ? &schdFd->readDeadline :
+                                                                           &schdFd->writeDeadline;
+    struct SchdfdDeadline *deadline = atomic_load(slot);
+    struct SchdfdDeadline *expected = nullptr;
+
+    if (deadline != nullptr) {
+        return deadline;
+    }
+    deadline = (struct SchdfdDeadline *)malloc(sizeof(struct SchdfdDeadline));
+    if (deadline == nullptr) {
+        LOG_ERROR(errno, "malloc failed, size: %u", sizeof(struct SchdfdDeadline));
+        return nullptr;
+    }
+    memset_s(deadline, sizeof(struct SchdfdDeadline), 0, sizeof(struct SchdfdDeadline));
+    if (pthread_mutex_init(&deadline->lock, nullptr) != 0) {
+        LOG_ERROR(ERRNO_SCHDFD_INIT_RESOURCE_FAILED, "mutex init failed");
+        free(deadline);
+        return nullptr;
+    }
+    deadline->pd = schdFd->pd;
+    deadline->type = type;
+    deadline->release = SchdfdDeadlineRelease;
+    if (!atomic_compare_exchange_strong(slot, &expected, deadline)) {
+        pthread_mutex_destroy(&deadline->lock);
+        free(deadline);
+        return expected;
+    }
+    return deadline;
+}
+
+/* Set the deadline of a wait. The timer is created or moved only if it would fire too late. */
+static int SchdfdDeadlineArm(struct SchdfdDeadline *deadline, unsigned long long timeout)
+{
+    unsigned long long now = CurrentNanotimeGet();
+    unsigned long long ddl = TimerDeadlineCheck(now, timeout);
+    unsigned long long slack = SchdfdTimerSlackGet();
+    int ret;
+
+    if (slack != 0 && ddl % slack != 0) {
+        ddl = TimerDeadlineCheck(ddl - ddl % slack, slack);
+    }
+    pthread_mutex_lock(&deadline->lock);
+    deadline->deadline = ddl;
+    deadline->expired = false;
+    deadline->idle = false;
+    if (deadline->timer == nullptr) {
+        deadline->timer = TimerNew(ddl - now, SCHDFD_DEADLINE_PERIOD, SchdfdDeadlineExpire, deadline);
+        if (deadline->timer == nullptr) {
+            deadline->deadline = 0;
+            pthread_mutex_unlock(&deadline->lock);
+            LOG_ERROR(ERRNO_SCHDFD_INIT_RESOURCE_FAILED, "timer init failed");
+            return ERRNO_SCHDFD_INIT_RESOURCE_FAILED;
+        }
+        deadline->armed = ddl;
+    } else if (ddl < deadline->armed) {
+        ret = TimerReset(deadline->timer, ddl - now, SCHDFD_DEADLINE_PERIOD, nullptr, nullptr);
+        if (ret != 0) {
+            deadline->deadline = 0;
+            pthread_mutex_unlock(&deadline->lock);
+            LOG_ERROR(ret, "timer reset failed");
+            return ret;
+        }
+        deadline->armed = ddl;
+    }
+    pthread_mutex_unlock(&deadline->lock);
+    return 0;
+}
+
+/* End a wait and return whether it has timed out. The timer stays armed for the next wait. */
+static bool SchdfdDeadlineDisarm(struct SchdfdDeadline *deadline)
+{
+    bool expired;
+
+    pthread_mutex_lock(&deadline->lock);
+    expired = deadline->expired;
+    deadline->expired = false;
+    deadline->deadline = 0;
+    pthread_mutex_unlock(&deadline->lock);
+    return expired;
+}
+
+/* Release a deadline that no wait can reach any more. An armed timer is fired at once and frees it. */
+static void SchdfdDeadlineRelease(struct SchdfdDeadline *deadline)
+{
+    int ret;
+
+    pthread_mutex_lock(&deadline->lock);
+    if (deadline->timer != nullptr) {
+        deadline->closed = true;
+        deadline->deadline = 0;
+        ret = TimerReset(deadline->timer, 0, SCHDFD_DEADLINE_PERIOD, nullptr, nullptr);
+        if (ret != 0) {
+            // The timer still fires at the armed deadline.
+            LOG_ERROR(ret, "timer reset failed");
+        }
+        pthread_mutex_unlock(&deadline->lock);
+        return;
+    }
+    pthread_mutex_unlock(&deadline->lock);
+    pthread_mutex_destroy(&deadline->lock);
+    free(deadline);
+}
+
+/* Release the deadline of a deregistered fd. */
+static void SchdfdDeadlineClose(std::atomic<struct SchdfdDeadline *> *slot)
+{
+    struct SchdfdDeadline *deadline = atomic_exchange(slot, static_cast<struct SchdfdDeadline *>(nullptr));
+
+    if (deadline != nullptr) {
+        SchdfdDeadlineRelease(deadline);
+    }
+}
+
 int SchdfdFdValidCheck(SignedSocket fd)
 {
     struct SchdfdManager *schdfdManager = g_scheduleManager.schdfdManager;
@@ -352,6 +552,9 @@ int SchdfdDeregister(SignedSocket fd)
     }
     SchdfdWakeall(schdFd);
     SchdfdDecref(fd, true);
+    // No wait is in progress after the references are dropped.
+    SchdfdDeadlineClose(&schdFd->readDeadline);
+    SchdfdDeadlineClose(&schdFd->writeDeadline);
 
     // release SchdFd
     schdfdManager->slots[layerIndex][lineIndex][fdIndex].schdFd = nullptr;
@@ -443,39 +646,12 @@ int SchdfdWaitInlock(SignedSocket fd, SchdpollEventType type)
     return 0;
 }
 
-void SchdfdReadTimeout(struct SchdfdFd *schdFd)
-{
-    struct CJThread *readCJThread;
-
-    // Timer timeout is also considered as a ready event, and it is up to the party
-    // who started the timer to determine which situation it is.
-    readCJThread = SchdpollReady(schdFd->pd, SHCDPOLL_READ, true);
-    (void)FreeSchdfdTimer(schdFd, SHCDPOLL_READ);
-    if (readCJThread != nullptr) {
-        ProcessorLocalWrite(readCJThread);
-        ProcessorWake(readCJThread->schedule, nullptr);
-    }
-}
-
-void SchdfdWriteTimeout(struct SchdfdFd *schdFd)
-{
-    struct CJThread *writeCJThread;
-
-    writeCJThread = SchdpollReady(schdFd->pd, SHCDPOLL_WRITE, true);
-    (void)FreeSchdfdTimer(schdFd, SHCDPOLL_WRITE);
-    if (writeCJThread != nullptr) {
-        ProcessorLocalWrite(writeCJThread);
-        ProcessorWake(writeCJThread->schedule, nullptr);
-    }
-}
-
 /* SchdfdWait with timeout. */
 int SchdfdWaitTimeout(SignedSocket fd, SchdpollEventType type, unsigned long long timeout)
 {
     struct SchdfdFd *schdFd;
+    struct SchdfdDeadline *deadline;
     int ret;
-    TimerHandle timer;
-    TimerFunc callback = (type == SHCDPOLL_READ) ? (TimerFunc)SchdfdReadTimeout : (TimerFunc)SchdfdWriteTimeout;
 
     if (timeout == 0) {
         return ERRNO_SCHDFD_TIMEOUT;
@@ -497,30 +673,23 @@ int SchdfdWaitTimeout(SignedSocket fd, SchdpollEventType type, unsigned long lon
         return ERRNO_SCHDFD_NOT_ADD_NETPOLL;
     }
 
-    timer = TimerNew(timeout, 0, callback, schdFd);
-    if (timer == nullptr) {
+    deadline = SchdfdDeadlineGet(schdFd, type);
+    ret = (deadline == nullptr) ? ERRNO_SCHDFD_INIT_RESOURCE_FAILED : SchdfdDeadlineArm(deadline, timeout);
+    if (ret != 0) {
         SchdfdDecref(fd, false);
-        LOG_ERROR(ERRNO_SCHDFD_INIT_RESOURCE_FAILED, "timer init failed");
-        return ERRNO_SCHDFD_INIT_RESOURCE_FAILED;
+        return ret;
     }
 
     if (!SchdpollWait(schdFd->pd, type)) {
-        (void) TimerTryStop(timer);
+        (void)SchdfdDeadlineDisarm(deadline);
         SchdfdDecref(fd, false);
-        TimerRelease(timer);
         return ERRNO_SCHDFD_FD_CLOSING;
     }
-    // Timer stop fail indicates that the current timeout has occurred and returns a timeout error.
+    // If the deadline has expired, the current timeout has occurred and returns a timeout error.
     // Otherwise, it is a real ready event that has occurred and returns OK.
-    ret = TimerTryStop(timer);
-    TimerRelease(timer);
-    if (ret != 0) {
-        SchdfdDecref(fd, false);
-        return ERRNO_SCHDFD_TIMEOUT;
-    }
-
+    ret = SchdfdDeadlineDisarm(deadline) ? ERRNO_SCHDFD_TIMEOUT : 0;
     SchdfdDecref(fd, false);
-    return 0;
+    return ret;
 }
 
 /* SchdfdWaitInlock with timeout. */
@@ -528,8 +697,8 @@ int SchdfdWaitInlockTimeout(SignedSocket fd, SchdpollEventType type, unsigned lo
 {
     struct SchdfdManager *schdfdManager = g_scheduleManager.schdfdManager;
     struct SchdfdFd *schdFd;
-    TimerHandle timer;
-    TimerFunc callback = (type == SHCDPOLL_READ) ? (TimerFunc)SchdfdReadTimeout : (TimerFunc)SchdfdWriteTimeout;
+    struct SchdfdDeadline *deadline;
+    int ret;
     int layerIndex = GetFirstLevel(fd);
     int lineIndex = GetSecondLevel(fd);
     int fdIndex = GetThirdLevel(fd);
@@ -543,27 +712,17 @@ int SchdfdWaitInlockTimeout(SignedSocket fd, SchdpollEventType type, unsigned lo
         LOG_ERROR(ERRNO_SCHDFD_NOT_ADD_NETPOLL, "fd %u not yet add to netpoll", fd);
         return ERRNO_SCHDFD_NOT_ADD_NETPOLL;
     }
-    timer = TimerNew(timeout, 0, callback, schdFd);
-    if (timer == nullptr) {
-        LOG_ERROR(ERRNO_SCHDFD_INIT_RESOURCE_FAILED, "timer init failed");
-        return ERRNO_SCHDFD_INIT_RESOURCE_FAILED;
-    }
-    if (type == SHCDPOLL_READ) {
-        atomic_store(&schdFd->readTimer, reinterpret_cast<uintptr_t>(timer));
-    } else {
-        atomic_store(&schdFd->writeTimer, reinterpret_cast<uintptr_t>(timer));
+    deadline = SchdfdDeadlineGet(schdFd, type);
+    ret = (deadline == nullptr) ? ERRNO_SCHDFD_INIT_RESOURCE_FAILED : SchdfdDeadlineArm(deadline, timeout);
+    if (ret != 0) {
+        return ret;
     }
     // In the case of close, close error will be returned regardless of whether the timer has timed out or not.
     if (!SchdpollWait(schdFd->pd, type)) {
-        (void)FreeSchdfdTimer(schdFd, type);
+        (void)SchdfdDeadlineDisarm(deadline);
         return ERRNO_SCHDFD_FD_CLOSING;
     }
-    int ret = FreeSchdfdTimer(schdFd, type);
-    if (ret == -1) {
-        return ERRNO_SCHDFD_TIMEOUT;
-    }
-
-    return ret;
+    return SchdfdDeadlineDisarm(deadline) ? ERRNO_SCHDFD_TIMEOUT : 0;
 }
 
 int SchdfdLock(SignedSocket fd, SchdpollEventType type)
@@ -898,35 +1057,6 @@ struct SchdpollDesc *SchdfdPdRemove(int fd)
 
 #endif
 
-int FreeSchdfdTimer(struct SchdfdFd *schdFd, SchdpollEventType type)
-{
-    int ret = 0;
-    uintptr_t old = 0;
-    std::atomic<uintptr_t> *timer;
-    uintptr_t newState = SCHDFD_TIMER_NULL;
-    if (type == SHCDPOLL_READ) {
-        timer = &schdFd->readTimer;
-    } else {
-        timer = &schdFd->writeTimer;
-    }
- 
-    while (1) {
-        old = atomic_load(timer);
-        if (old == newState) {
-            return -1;
-        }
- 
-        if (atomic_compare_exchange_weak(timer, &old, newState)) {
-            ret = TimerTryStop(reinterpret_cast<void *>(old));
-            TimerRelease(reinterpret_cast<void *>(old));
-            if (ret != 0) {
-                ret = ERRNO_SCHDFD_TIMEOUT;
-            }
-            return ret;
-        }
-    }
-}
-
 #ifdef __cplusplus
 }
 #endif
\ No newline at end of file
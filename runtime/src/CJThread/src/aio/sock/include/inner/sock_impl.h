@@ -132,6 +132,21 @@ typedef int (*SockRecvfromNonBlockHook)(int fd, void *buf, unsigned int len, Soc
 
 typedef int (*SockWaitRecvHook)(SignedSocket fd, unsigned long long timeout);
 
+typedef int (*SockRecvfromBatchHook)(SignedSocket fd, struct SockMsg *msgs, unsigned int count, SocketFlag flags,
+                                     int *msgNum, unsigned long long timeout);
+
+typedef int (*SockSendvHook)(SignedSocket fd, const struct SockIoVec *iov, unsigned int iovCnt, SocketFlag flags,
+                             int *sendLen, unsigned long long timeout);
+
+typedef int (*SockRecvvHook)(SignedSocket fd, const struct SockIoVec *iov, unsigned int iovCnt, SocketFlag flags,
+                             int *recvLen, unsigned long long timeout);
+
+typedef int (*SockSendFileHook)(SignedSocket fd, int fileFd, long long *offset, unsigned long long count,
+                                unsigned long long *sendLen, unsigned long long timeout);
+
+typedef int (*SockSendtoBatchHook)(SignedSocket fd, struct SockMsg *msgs, unsigned int count, SocketFlag flags,
+                                   int *msgNum, unsigned long long timeout);
+
 typedef int (*SockListenHook)(SignedSocket sockFd, int backlog);
 
 struct SockCommHooks {
@@ -148,6 +163,8 @@ struct SockCommHooks {
     SockSendNonBlockHook sendNonBlock;          /* Send message non-block fucntion */
     SockWaitSendHook waitSend;                  /* Message sending asynchronous waiting function */
     SockConnRecvHook recv;                      /* Message receive function */
+    SockSendvHook sendv;                        /* Gather send function */
+    SockRecvvHook recvv;                        /* Scatter receive function */
     SockRecvNonBlockHook recvNonBlock;          /* Message receive non-block function */
     SockWaitRecvHook waitRecv;                  /* Asynchronous waiting function for message receiving */
     SockCloseHook close;                        /* close fd */
@@ -157,6 +174,9 @@ struct SockCommHooks {
     SockSendtoNonBlockHook sendtoNonBlock;      /* Sendto non-block, for udp and raw socket */
     SockRecvfromHook recvfrom;                  /* Recvfrom, for udp and raw socket */
     SockRecvfromNonBlockHook recvfromNonBlock;  /* Recvfrom non-block, for udp and raw socket */
+    SockRecvfromBatchHook recvfromBatch;        /* Recvfrom several datagrams at once, for udp */
+    SockSendtoBatchHook sendtoBatch;            /* Sendto several datagrams at once, for udp */
+    SockSendFileHook sendFile;                  /* Send file content without user space copy */
     SockCreateSocketHook createSocket;          /* create socket fuction */
     SockOptionSetHook optionSet;                /* set socket option */
     SockOptionGetHook optionGet;                /* get socket option */
@@ -262,6 +282,34 @@ int SockSendtoGeneral(SignedSocket fd, void *bufAndLen, SocketFlag flags, const
 int SockRecvfromGeneral(SignedSocket fd, void *bufAndLen, SocketFlag flags, struct SockAddr *fromAddr,
                         int *recvLen, unsigned long long timeout);
 
+#ifndef MRT_WINDOWS
+/**
+ * @brief Gather send, based on sendmsg, resumes partial writes
+ * @param fd            [IN] fd
+ * @param iov           [IN] buffers
+ * @param iovCnt        [IN] number of buffers
+ * @param flags         [IN]  flags
+ * @param sendLen       [OUT] length of the sent message, also set on failure
+ * @param timeout       [IN] timeout
+ * @retval #0 or error code
+ */
+int SockSendvGeneral(int fd, const struct SockIoVec *iov, unsigned int iovCnt, SocketFlag flags,
+                     int *sendLen, unsigned long long timeout);
+
+/**
+ * @brief Scatter receive, based on recvmsg
+ * @param fd            [IN] fd
+ * @param iov           [IN] buffers
+ * @param iovCnt        [IN] number of buffers
+ * @param flags         [IN]  flags
+ * @param recvLen       [OUT] length of the received message
+ * @param timeout       [IN] timeout
+ * @retval #0 or error code
+ */
+int SockRecvvGeneral(int fd, const struct SockIoVec *iov, unsigned int iovCnt, SocketFlag flags,
+                     int *recvLen, unsigned long long timeout);
+#endif
+
 /**
  * @brief SocketSend non-block
  * @param fd            [IN] fd
@@ -318,6 +366,47 @@ int SockRecvfromNonBlockGeneral(SignedSocket fd, void *buf, unsigned int len, So
  */
 int SockGetLocalDefaultAddr(short family, struct SockAddr *addr);
 
+#ifdef MRT_LINUX
+/**
+ * @brief Recvfrom batch, based on recvmmsg
+ * @param fd            [IN] fd
+ * @param msgs          [IN/OUT] datagram buffers
+ * @param count         [IN] number of msgs
+ * @param flags         [IN]  flags
+ * @param msgNum        [OUT] number of the received datagrams
+ * @param timeout       [IN] timeout
+ * @retval #0 or error code
+ */
+int SockRecvfromBatchGeneral(int fd, struct SockMsg *msgs, unsigned int count, SocketFlag flags,
+                             int *msgNum, unsigned long long timeout);
+
+/**
+ * @brief Sendto batch, based on sendmmsg
+ * @param fd            [IN] fd
+ * @param msgs          [IN/OUT] datagrams
+ * @param count         [IN] number of msgs
+ * @param flags         [IN]  flags
+ * @param msgNum        [OUT] number of the sent datagrams
+ * @param timeout       [IN] timeout
+ * @retval #0 or error code
+ */
+int SockSendtoBatchGeneral(int fd, struct SockMsg *msgs, unsigned int count, SocketFlag flags,
+                           int *msgNum, unsigned long long timeout);
+
+/**
+ * @brief Send file content, based on sendfile, resumes partial sends
+ * @param fd            [IN] fd
+ * @param fileFd        [IN] file fd
+ * @param offset        [IN/OUT] file offset
+ * @param count         [IN] number of bytes
+ * @param sendLen       [OUT] number of bytes sent, also set on failure
+ * @param timeout       [IN] timeout
+ * @retval #0 or error code
+ */
+int SockSendFileGeneral(int fd, int fileFd, long long *offset, unsigned long long count,
+                        unsigned long long *sendLen, unsigned long long timeout);
+#endif
+
 #if defined (MRT_LINUX) || defined (MRT_MACOS)
 
 int SockCreateInternal(int domain, int type, int protocol, int *socketError);
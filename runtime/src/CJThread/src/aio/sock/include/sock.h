@@ -65,6 +65,34 @@ struct SockAddr {
     socklen_t addrLen;
 };
 
+/**
+ * one datagram of SockRecvfromBatch/SockSendtoBatch
+ */
+struct SockMsg {
+    void *buf;
+    unsigned int len;      /* buffer length */
+    unsigned int msgLen;   /* [OUT] length of the datagram received or sent */
+    struct SockAddr *addr; /* source of a received datagram, may be nullptr; destination of a sent one */
+};
+
+/**
+ * @brief maximum number of datagrams handled by one SockRecvfromBatch/SockSendtoBatch call
+ */
+#define SOCK_BATCH_MAX_MSGS 64
+
+/**
+ * one buffer of SockSendv/SockRecvv
+ */
+struct SockIoVec {
+    void *buf;
+    unsigned int len;
+};
+
+/**
+ * @brief maximum number of buffers of one SockSendv/SockRecvv call
+ */
+#define SOCK_IOV_MAX 64
+
 /**
  * keepalive cfg
  */
@@ -300,6 +328,48 @@ int SockRecv(long long sock, void *buf, unsigned int len, SocketFlag flags);
  */
 int SockRecvTimeout(long long sock, void *buf, unsigned int len, SocketFlag flags, unsigned long long timeout);
 
+/**
+ * @brief Gather send: sends the buffers in order as one byte stream, with a single system call when possible.
+ * @par Only connection-based protocols are supported. Unlike SockSend, partial writes are resumed after waiting
+ * for the socket to become writable, so all bytes are sent unless an error occurs. This interface does not block
+ * cjthreads while waiting.
+ * @param  sock         [IN]  socket handle
+ * @param  iov          [IN]  buffers, zero-length buffers are skipped
+ * @param  iovCnt       [IN]  number of buffers, at most SOCK_IOV_MAX
+ * @param  flags        [IN]  flags
+ * @param  timeout      [IN]  timeout of each wait, ns, (unsigned long long)-1 waits forever
+ * @retval #>=0 Number of bytes sent. Less than the total length only if the timeout expired after a partial write.
+ * @retval #-1
+ */
+int SockSendvTimeout(long long sock, const struct SockIoVec *iov, unsigned int iovCnt, SocketFlag flags,
+                     unsigned long long timeout);
+
+/**
+ * @brief SockSendvTimeout without timeout.
+ */
+int SockSendv(long long sock, const struct SockIoVec *iov, unsigned int iovCnt, SocketFlag flags);
+
+/**
+ * @brief Scatter receive: fills the buffers in order from one receive.
+ * @par Only connection-based protocols are supported. Returns as soon as some bytes are received, like SockRecv.
+ * @attention For the same sock, this interface does not support multiple cjthreads.
+ * @param  sock         [IN]  socket handle
+ * @param  iov          [IN]  buffers
+ * @param  iovCnt       [IN]  number of buffers, at most SOCK_IOV_MAX
+ * @param  flags        [IN]  flags
+ * @param  timeout      [IN]  timeout, ns, (unsigned long long)-1 waits forever
+ * @retval #>0 Number of bytes successfully received.
+ * @retval #-1 The function fails to be operated. You can call #SockErrnoGet to obtain the error code.
+ * @retval #0 The peer end is disconnected.
+ */
+int SockRecvvTimeout(long long sock, const struct SockIoVec *iov, unsigned int iovCnt, SocketFlag flags,
+                     unsigned long long timeout);
+
+/**
+ * @brief SockRecvvTimeout without timeout.
+ */
+int SockRecvv(long long sock, const struct SockIoVec *iov, unsigned int iovCnt, SocketFlag flags);
+
 /**
  * @brief It is used to receive messages through a connection protocol in Linux. SockRecv does not block cjthread.
  * @attention
@@ -479,6 +549,58 @@ int SockRecvfrom(long long sock, void *buf, unsigned int len, SocketFlag flags,
  */
 int SockRecvfromNonBlock(long long sock, void *buf, unsigned int len, SocketFlag flags, struct SockAddr *addr);
 
+/**
+ * @brief Receives several udp datagrams with one system call (recvmmsg on linux).
+ * @par Waits until at least one datagram is available, then returns every datagram already queued, up to
+ * count. On platforms without recvmmsg a single datagram is received. This interface does not block cjthreads.
+ * @attention For the same sock, this interface does not support multiple cjthreads.
+ * @param  sock         [IN]  socket handle
+ * @param  msgs         [IN/OUT]  datagram buffers, msgLen and addr are filled for the received ones
+ * @param  count        [IN]  number of msgs, at most SOCK_BATCH_MAX_MSGS are used
+ * @param  flags        [IN]  flags
+ * @param  timeout      [IN]  timeout, ns, (unsigned long long)-1 waits forever
+ * @retval #>0 number of datagrams received
+ * @retval #-1
+ */
+int SockRecvfromBatch(long long sock, struct SockMsg *msgs, unsigned int count, SocketFlag flags,
+                      unsigned long long timeout);
+
+/**
+ * @brief Sends several udp datagrams with one system call (sendmmsg on linux).
+ * @par Waits while the socket send buffer is full. On platforms without sendmmsg the datagrams are sent one by
+ * one. This interface does not block cjthreads.
+ * @param  sock         [IN]  socket handle
+ * @param  msgs         [IN/OUT]  datagrams with their destination address, msgLen is filled for the sent ones
+ * @param  count        [IN]  number of msgs, at most SOCK_BATCH_MAX_MSGS are used
+ * @param  flags        [IN]  flags
+ * @param  timeout      [IN]  timeout, ns, (unsigned long long)-1 waits forever
+ * @retval #>0 number of datagrams sent, may be less than count
+ * @retval #-1
+ */
+int SockSendtoBatch(long long sock, struct SockMsg *msgs, unsigned int count, SocketFlag flags,
+                    unsigned long long timeout);
+
+/**
+ * @brief Sends count bytes of a file from *offset, on linux the data goes from the page cache to the socket
+ * without being copied through user space (sendfile).
+ * @par Only connection-based protocols are supported. Partial sends are resumed after waiting for the socket to
+ * become writable, the file offset of fileFd is not changed. This interface does not block cjthreads while waiting.
+ * @param  sock         [IN]  socket handle
+ * @param  fileFd       [IN]  file descriptor opened for reading
+ * @param  offset       [IN/OUT]  file offset to send from, advanced by the number of bytes sent
+ * @param  count        [IN]  number of bytes to send
+ * @param  timeout      [IN]  timeout of each wait, ns, (unsigned long long)-1 waits forever
+ * @retval #>=0 Number of bytes sent. Less than count at end of file or if the timeout expired after a partial send.
+ * @retval #-1
+ */
+long long SockSendFileTimeout(long long sock, int fileFd, long long *offset, unsigned long long count,
+                              unsigned long long timeout);
+
+/**
+ * @brief SockSendFileTimeout without timeout.
+ */
+long long SockSendFile(long long sock, int fileFd, long long *offset, unsigned long long count);
+
 /**
  * @brief Set socket options for sock
  * @param  sock         [IN]  socket handle
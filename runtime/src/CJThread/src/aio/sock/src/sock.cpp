@@ -7,7 +7,15 @@
 
 #include <cstring>
 #include <cstdint>
+#include <climits>
 #include <cerrno>
+#include <cstdlib>
+#ifndef MRT_WINDOWS
+#include <unistd.h>
+#endif
+#ifdef MRT_LINUX
+#include <sys/sendfile.h>
+#endif
 #include "schedule_impl.h"
 #include "securec.h"
 #include "sock_impl.h"
@@ -541,6 +549,136 @@ int SockRecv(long long sock, void *buf, unsigned int len, SocketFlag flags)
     return SockRecvTimeout(sock, buf, len, flags, (unsigned long long) -1);
 }
 
+// Checks a SockSendv/SockRecvv buffer list, the total length has to fit into the int result.
+static bool SockIoVecValid(const struct SockIoVec *iov, unsigned int iovCnt)
+{
+    if (iov == nullptr || iovCnt == 0 || iovCnt > SOCK_IOV_MAX) {
+        SOCK_LOG_ERROR(ERRNO_SOCK_ARG_INVALID, "arg invalid, iovCnt: %u", iovCnt);
+        return false;
+    }
+    unsigned long long total = 0;
+    for (unsigned int i = 0; i < iovCnt; ++i) {
+        if (iov[i].buf == nullptr && iov[i].len != 0) {
+            SOCK_LOG_ERROR(ERRNO_SOCK_ARG_INVALID, "buf is nullptr, index: %u", i);
+            return false;
+        }
+        total += iov[i].len;
+    }
+    if (total == 0 || total > INT_MAX) {
+        SOCK_LOG_ERROR(ERRNO_SOCK_ARG_INVALID, "arg invalid, total len: %llu", total);
+        return false;
+    }
+    return true;
+}
+
+int SockSendvTimeout(long long sock, const struct SockIoVec *iov, unsigned int iovCnt, SocketFlag flags,
+                     unsigned long long timeout)
+{
+    unsigned int netType;
+    struct SockCommHooks *sockHooks;
+    SignedSocket rawFd;
+    SocketFlag sendFlag = flags;
+    int sendLen = 0;
+    int ret;
+
+    if (!SockIoVecValid(iov, iovCnt)) {
+        return -1;
+    }
+    if (SockHandleParse(sock, SOCK_HANDLE_CONNECTION, &netType, &rawFd) != 0) {
+        return -1;
+    }
+    sockHooks = &g_sockCommHooks[netType];
+    if (sockHooks->sendv == nullptr) {
+        // no gather send on this platform, send buffer by buffer.
+        for (unsigned int i = 0; i < iovCnt; ++i) {
+            unsigned int sent = 0;
+            while (sent < iov[i].len) {
+                int len = SockSendTimeout(sock, static_cast<const char *>(iov[i].buf) + sent, iov[i].len - sent,
+                                          flags, timeout);
+                if (len < 0) {
+                    return sendLen > 0 ? sendLen : -1;
+                }
+                sent += static_cast<unsigned int>(len);
+                sendLen += len;
+            }
+        }
+        return sendLen;
+    }
+    if (netType != NET_TYPE_RAW) {
+#ifdef MRT_WINDOWS
+        sendFlag = 0;
+#else
+        sendFlag = MSG_NOSIGNAL;
+#endif
+    }
+    ret = sockHooks->sendv(rawFd, iov, iovCnt, sendFlag, &sendLen, timeout);
+    if (ret != 0) {
+        if (ret == ERRNO_SCHDFD_TIMEOUT) {
+            SockErrnoSet(ERRNO_SOCK_TIMEOUT);
+            // report the partial write, the caller cannot tell otherwise how much was sent.
+            if (sendLen > 0) {
+                return sendLen;
+            }
+        } else {
+            SOCK_LOG_ERROR(ret, "sendv failed, sock: 0x%llx, iovCnt: %u", sock, iovCnt);
+        }
+        return -1;
+    }
+    LOG_INFO(0, "SockSendv success, sock: 0x%llx, send len: %d", sock, sendLen);
+    return sendLen;
+}
+
+int SockSendv(long long sock, const struct SockIoVec *iov, unsigned int iovCnt, SocketFlag flags)
+{
+    return SockSendvTimeout(sock, iov, iovCnt, flags, (unsigned long long)-1);
+}
+
+int SockRecvvTimeout(long long sock, const struct SockIoVec *iov, unsigned int iovCnt, SocketFlag flags,
+                     unsigned long long timeout)
+{
+    unsigned int netType;
+    struct SockCommHooks *sockHooks;
+    SignedSocket rawFd;
+    SocketFlag recvFlag = flags;
+    int recvLen = 0;
+    int ret;
+
+    if (!SockIoVecValid(iov, iovCnt)) {
+        return -1;
+    }
+    if (SockHandleParse(sock, SOCK_HANDLE_CONNECTION, &netType, &rawFd) != 0) {
+        return -1;
+    }
+    sockHooks = &g_sockCommHooks[netType];
+    if (sockHooks->recvv == nullptr) {
+        // no scatter receive on this platform, receive into the first buffer.
+        unsigned int i = 0;
+        while (iov[i].len == 0) {
+            ++i;
+        }
+        return SockRecvTimeout(sock, iov[i].buf, iov[i].len, flags, timeout);
+    }
+    if (netType != NET_TYPE_RAW) {
+        recvFlag = 0;
+    }
+    ret = sockHooks->recvv(rawFd, iov, iovCnt, recvFlag, &recvLen, timeout);
+    if (ret != 0) {
+        if (ret == ERRNO_SCHDFD_TIMEOUT) {
+            SockErrnoSet(ERRNO_SOCK_TIMEOUT);
+        } else {
+            SOCK_LOG_ERROR(ret, "recvv failed, sock: 0x%llx, iovCnt: %u", sock, iovCnt);
+        }
+        return -1;
+    }
+    LOG_INFO(0, "SockRecvv success, sock: 0x%llx, recv len: %d", sock, recvLen);
+    return recvLen;
+}
+
+int SockRecvv(long long sock, const struct SockIoVec *iov, unsigned int iovCnt, SocketFlag flags)
+{
+    return SockRecvvTimeout(sock, iov, iovCnt, flags, (unsigned long long)-1);
+}
+
 int SockRecvNonBlock(long long sock, void *buf, unsigned int len, SocketFlag flags)
 {
     unsigned int netType;
@@ -917,6 +1055,188 @@ int SockRecvfromNonBlock(long long sock, void *buf, unsigned int len, SocketFlag
     return recvLen;
 }
 
+int SockRecvfromBatch(long long sock, struct SockMsg *msgs, unsigned int count, SocketFlag flags,
+                      unsigned long long timeout)
+{
+    unsigned int netType;
+    struct SockCommHooks *sockHooks;
+    SignedSocket rawFd;
+    int msgNum = 0;
+    int ret;
+
+    if ((msgs == nullptr) || (count == 0)) {
+        SOCK_LOG_ERROR(ERRNO_SOCK_ARG_INVALID, "arg invalid, count: %u", count);
+        return -1;
+    }
+    if (SockHandleParse(sock, SOCK_HANDLE_CONNECTION, &netType, &rawFd) != 0) {
+        return -1;
+    }
+    sockHooks = &g_sockCommHooks[netType];
+    if (sockHooks->recvfromBatch == nullptr) {
+        // no batch support on this platform, fall back to a single datagram.
+        int recvLen = SockRecvfromTimeout(sock, msgs[0].buf, msgs[0].len, flags, msgs[0].addr, timeout);
+        if (recvLen < 0) {
+            return -1;
+        }
+        msgs[0].msgLen = static_cast<unsigned int>(recvLen);
+        return 1;
+    }
+    if (count > SOCK_BATCH_MAX_MSGS) {
+        count = SOCK_BATCH_MAX_MSGS;
+    }
+    ret = sockHooks->recvfromBatch(rawFd, msgs, count, 0, &msgNum, timeout);
+    if (ret != 0) {
+        if (ret == ERRNO_SCHDFD_TIMEOUT) {
+            SockErrnoSet(ERRNO_SOCK_TIMEOUT);
+        } else {
+            SOCK_LOG_ERROR(ret, "recvfrom batch failed, sock: 0x%llx, count: %u", sock, count);
+        }
+        return -1;
+    }
+    return msgNum;
+}
+
+int SockSendtoBatch(long long sock, struct SockMsg *msgs, unsigned int count, SocketFlag flags,
+                    unsigned long long timeout)
+{
+    unsigned int netType;
+    struct SockCommHooks *sockHooks;
+    SignedSocket rawFd;
+    int msgNum = 0;
+    int ret;
+
+    if ((msgs == nullptr) || (count == 0)) {
+        SOCK_LOG_ERROR(ERRNO_SOCK_ARG_INVALID, "arg invalid, count: %u", count);
+        return -1;
+    }
+    if (SockHandleParse(sock, SOCK_HANDLE_CONNECTION, &netType, &rawFd) != 0) {
+        return -1;
+    }
+    if (count > SOCK_BATCH_MAX_MSGS) {
+        count = SOCK_BATCH_MAX_MSGS;
+    }
+    sockHooks = &g_sockCommHooks[netType];
+    if (sockHooks->sendtoBatch == nullptr) {
+        // no batch support on this platform, send the datagrams one by one.
+        for (unsigned int i = 0; i < count; ++i) {
+            int sendLen = SockSendtoTimeout(sock, msgs[i].buf, msgs[i].len, flags, msgs[i].addr, timeout);
+            if (sendLen < 0) {
+                return i == 0 ? -1 : static_cast<int>(i);
+            }
+            msgs[i].msgLen = static_cast<unsigned int>(sendLen);
+        }
+        return static_cast<int>(count);
+    }
+    for (unsigned int i = 0; i < count; ++i) {
+        if (msgs[i].addr == nullptr || msgs[i].addr->sockaddr == nullptr) {
+            SOCK_LOG_ERROR(ERRNO_SOCK_ARG_INVALID, "addr is nullptr, index: %u", i);
+            return -1;
+        }
+    }
+    ret = sockHooks->sendtoBatch(rawFd, msgs, count, 0, &msgNum, timeout);
+    if (ret != 0) {
+        if (ret == ERRNO_SCHDFD_TIMEOUT) {
+            SockErrnoSet(ERRNO_SOCK_TIMEOUT);
+        } else {
+            SOCK_LOG_ERROR(ret, "sendto batch failed, sock: 0x%llx, count: %u", sock, count);
+        }
+        return -1;
+    }
+    return msgNum;
+}
+
+#ifndef MRT_WINDOWS
+const size_t SOCK_SEND_FILE_BUF_SIZE = 64 * 1024;
+
+// Used when the kernel cannot send from the file directly: reads the file with pread and sends it with SockSend.
+static long long SockSendFileByBuffer(long long sock, int fileFd, long long *offset, unsigned long long count,
+                                      unsigned long long timeout)
+{
+    char *buf = static_cast<char *>(malloc(SOCK_SEND_FILE_BUF_SIZE));
+    if (buf == nullptr) {
+        SOCK_LOG_ERROR(ENOMEM, "malloc failed, size: %zu", SOCK_SEND_FILE_BUF_SIZE);
+        return -1;
+    }
+    unsigned long long total = 0;
+    bool failed = false;
+    while (total < count && !failed) {
+        size_t chunk = static_cast<size_t>(count - total < SOCK_SEND_FILE_BUF_SIZE ? count - total :
+                                                                                    SOCK_SEND_FILE_BUF_SIZE);
+        ssize_t readLen = pread(fileFd, buf, chunk, static_cast<off_t>(*offset));
+        if (readLen < 0 && errno == EINTR) {
+            continue;
+        }
+        if (readLen <= 0) {
+            failed = readLen < 0;
+            break;
+        }
+        ssize_t sent = 0;
+        while (sent < readLen) {
+            int len = SockSendTimeout(sock, buf + sent, static_cast<unsigned int>(readLen - sent), 0, timeout);
+            if (len < 0) {
+                failed = true;
+                break;
+            }
+            sent += len;
+            *offset += len;
+            total += static_cast<unsigned long long>(len);
+        }
+    }
+    free(buf);
+    if (failed && total == 0) {
+        return -1;
+    }
+    return static_cast<long long>(total);
+}
+#endif
+
+long long SockSendFileTimeout(long long sock, int fileFd, long long *offset, unsigned long long count,
+                              unsigned long long timeout)
+{
+    unsigned int netType;
+    struct SockCommHooks *sockHooks;
+    SignedSocket rawFd;
+    unsigned long long sendLen = 0;
+    int ret;
+
+    if (fileFd < 0 || offset == nullptr || *offset < 0) {
+        SOCK_LOG_ERROR(ERRNO_SOCK_ARG_INVALID, "arg invalid, fileFd: %d", fileFd);
+        return -1;
+    }
+    if (SockHandleParse(sock, SOCK_HANDLE_CONNECTION, &netType, &rawFd) != 0) {
+        return -1;
+    }
+    if (count == 0) {
+        return 0;
+    }
+    sockHooks = &g_sockCommHooks[netType];
+    if (sockHooks->sendFile == nullptr) {
+#ifdef MRT_WINDOWS
+        SOCK_LOG_ERROR(ERRNO_SOCK_NOT_SUPPORTED, "sendfile unsupported, sock: 0x%llx", sock);
+        return -1;
+#else
+        return SockSendFileByBuffer(sock, fileFd, offset, count, timeout);
+#endif
+    }
+    ret = sockHooks->sendFile(rawFd, fileFd, offset, count, &sendLen, timeout);
+    if (ret != 0) {
+        if (ret == ERRNO_SCHDFD_TIMEOUT) {
+            SockErrnoSet(ERRNO_SOCK_TIMEOUT);
+        } else {
+            SOCK_LOG_ERROR(ret, "sendfile failed, sock: 0x%llx, fileFd: %d", sock, fileFd);
+        }
+        // report the partial send, *offset has been advanced past it.
+        return sendLen > 0 ? static_cast<long long>(sendLen) : -1;
+    }
+    LOG_INFO(0, "SockSendFile success, sock: 0x%llx, send len: %llu", sock, sendLen);
+    return static_cast<long long>(sendLen);
+}
+
+long long SockSendFile(long long sock, int fileFd, long long *offset, unsigned long long count)
+{
+    return SockSendFileTimeout(sock, fileFd, offset, count, (unsigned long long)-1);
+}
+
 int SockOptionSet(long long sock, int level, int optname, const void *optval, int optlen)
 {
     struct SockCommHooks *sockHooks;
@@ -1714,8 +2034,315 @@ int SockRecvfromNonBlockGeneral(int fd, void *buf, unsigned int len, SocketFlag
     return ret;
 }
 
+// Copies a SockIoVec list into the iovec array of msg.
+static void SockFillMsgIov(const struct SockIoVec *iov, unsigned int iovCnt, struct iovec *iovs, struct msghdr *msg)
+{
+    for (unsigned int i = 0; i < iovCnt; ++i) {
+        iovs[i].iov_base = iov[i].buf;
+        iovs[i].iov_len = static_cast<size_t>(iov[i].len);
+    }
+    (void)memset_s(msg, sizeof(struct msghdr), 0, sizeof(struct msghdr));
+    msg->msg_iov = iovs;
+    msg->msg_iovlen = iovCnt;
+}
+
+// Drops the first len bytes from the iovec array of msg after a partial write.
+static void SockAdvanceMsgIov(struct msghdr *msg, size_t len)
+{
+    while (msg->msg_iovlen > 0 && len >= msg->msg_iov->iov_len) {
+        len -= msg->msg_iov->iov_len;
+        msg->msg_iov++;
+        msg->msg_iovlen--;
+    }
+    if (msg->msg_iovlen > 0) {
+        msg->msg_iov->iov_base = static_cast<char *>(msg->msg_iov->iov_base) + len;
+        msg->msg_iov->iov_len -= len;
+    }
+}
+
+int SockSendvGeneral(int fd, const struct SockIoVec *iov, unsigned int iovCnt, SocketFlag flags,
+                     int *sendLen, unsigned long long timeout)
+{
+    struct iovec iovs[SOCK_IOV_MAX];
+    struct msghdr msg;
+    ssize_t sendRet;
+    size_t total = 0;
+    int ret = 0;
+    SchdpollEventType type = SHCDPOLL_WRITE;
+
+    SockFillMsgIov(iov, iovCnt, iovs, &msg);
+    SockAdvanceMsgIov(&msg, 0); // skip leading empty buffers
+    ret = SchdfdLock(fd, type);
+    if (ret != 0) {
+        *sendLen = 0;
+        return ret;
+    }
+
+    while (msg.msg_iovlen > 0) {
+        sendRet = sendmsg(fd, &msg, flags);
+        if (sendRet >= 0) {
+            ret = 0;
+            total += static_cast<size_t>(sendRet);
+            SockAdvanceMsgIov(&msg, static_cast<size_t>(sendRet));
+            continue;
+        }
+
+        ret = errno;
+        if (ret == 0 || ret == EINTR) {
+            continue;
+        }
+        if (ret != EAGAIN) {
+            LOG_ERROR(ret, "sendmsg failed, fd: %d, iovCnt: %u", fd, iovCnt);
+            break;
+        }
+
+        LOG_INFO(0, "sendmsg waiting, fd: %d", fd);
+        if (timeout == static_cast<unsigned long long>(-1)) {
+            ret = SchdfdWaitInlock(fd, type);
+        } else {
+            ret = SchdfdWaitInlockTimeout(fd, type, timeout);
+        }
+        LOG_INFO(0, "sendmsg wait over, fd: %d", fd);
+
+        if (ret != 0) {
+            break;
+        }
+    }
+    SchdfdUnlock(fd, type);
+    *sendLen = static_cast<int>(total);
+    return ret;
+}
+
+int SockRecvvGeneral(int fd, const struct SockIoVec *iov, unsigned int iovCnt, SocketFlag flags,
+                     int *recvLen, unsigned long long timeout)
+{
+    struct iovec iovs[SOCK_IOV_MAX];
+    struct msghdr msg;
+    ssize_t recvRet;
+    int ret;
+    SchdpollEventType type = SHCDPOLL_READ;
+
+    SockFillMsgIov(iov, iovCnt, iovs, &msg);
+    ret = SchdfdLock(fd, type);
+    if (ret != 0) {
+        return ret;
+    }
+
+    while (1) {
+        do {
+            recvRet = recvmsg(fd, &msg, flags);
+            ret = errno;
+        } while ((recvRet == -1) && (ret == EINTR || ret == 0));
+
+        if (recvRet >= 0) {
+            ret = 0;
+            *recvLen = static_cast<int>(recvRet);
+            break;
+        }
+
+        if (ret != EAGAIN) {
+            LOG_ERROR(ret, "recvmsg failed, fd: %d, iovCnt: %u", fd, iovCnt);
+            break;
+        }
+
+        LOG_INFO(0, "recvmsg waiting, fd: %d", fd);
+        if (timeout == static_cast<unsigned long long>(-1)) {
+            ret = SchdfdWaitInlock(fd, type);
+        } else {
+            ret = SchdfdWaitInlockTimeout(fd, type, timeout);
+        }
+        LOG_INFO(0, "recvmsg wait over, fd: %d", fd);
+        if (ret != 0) {
+            break;
+        }
+    }
+    SchdfdUnlock(fd, type);
+    return ret;
+}
+
 #ifdef MRT_LINUX
 
+// Fills the mmsghdr array of a batch, every datagram uses a single iovec.
+static void SockFillMsgHdrs(struct SockMsg *msgs, unsigned int count, struct mmsghdr *hdrs, struct iovec *iovs)
+{
+    for (unsigned int i = 0; i < count; ++i) {
+        iovs[i].iov_base = msgs[i].buf;
+        iovs[i].iov_len = static_cast<size_t>(msgs[i].len);
+        struct msghdr *hdr = &hdrs[i].msg_hdr;
+        (void)memset_s(hdr, sizeof(struct msghdr), 0, sizeof(struct msghdr));
+        hdr->msg_iov = &iovs[i];
+        hdr->msg_iovlen = 1;
+        if (msgs[i].addr != nullptr && msgs[i].addr->sockaddr != nullptr) {
+            hdr->msg_name = msgs[i].addr->sockaddr;
+            hdr->msg_namelen = msgs[i].addr->addrLen;
+        }
+        hdrs[i].msg_len = 0;
+    }
+}
+
+int SockRecvfromBatchGeneral(int fd, struct SockMsg *msgs, unsigned int count, SocketFlag flags,
+                             int *msgNum, unsigned long long timeout)
+{
+    struct mmsghdr hdrs[SOCK_BATCH_MAX_MSGS];
+    struct iovec iovs[SOCK_BATCH_MAX_MSGS];
+    SchdpollEventType type = SHCDPOLL_READ;
+    int recvRet;
+    int ret;
+
+    SockFillMsgHdrs(msgs, count, hdrs, iovs);
+    ret = SchdfdLock(fd, type);
+    if (ret != 0) {
+        return ret;
+    }
+
+    while (1) {
+        // The fd is non-blocking, so recvmmsg returns as soon as the queued datagrams are consumed.
+        do {
+            recvRet = recvmmsg(fd, hdrs, count, flags, nullptr);
+            ret = errno;
+        } while ((recvRet == -1) && (ret == EINTR || ret == 0));
+
+        if (recvRet >= 0) {
+            ret = 0;
+            for (int i = 0; i < recvRet; ++i) {
+                msgs[i].msgLen = hdrs[i].msg_len;
+                if (msgs[i].addr != nullptr && msgs[i].addr->sockaddr != nullptr) {
+                    msgs[i].addr->addrLen = hdrs[i].msg_hdr.msg_namelen;
+                }
+            }
+            *msgNum = recvRet;
+            break;
+        }
+
+        if (ret != EAGAIN) {
+            LOG_ERROR(ret, "recvmmsg failed, fd: %d, count: %u", fd, count);
+            break;
+        }
+
+        LOG_INFO(0, "recvmmsg waiting, fd: %d", fd);
+        if (timeout == static_cast<unsigned long long>(-1)) {
+            ret = SchdfdWaitInlock(fd, type);
+        } else {
+            ret = SchdfdWaitInlockTimeout(fd, type, timeout);
+        }
+        LOG_INFO(0, "recvmmsg wait over, fd: %d", fd);
+
+        if (ret != 0) {
+            break;
+        }
+    }
+    SchdfdUnlock(fd, type);
+    return ret;
+}
+
+int SockSendFileGeneral(int fd, int fileFd, long long *offset, unsigned long long count,
+                        unsigned long long *sendLen, unsigned long long timeout)
+{
+    // sendfile transfers at most 0x7ffff000 bytes per call.
+    const unsigned long long maxChunk = 0x7ffff000ULL;
+    SchdpollEventType type = SHCDPOLL_WRITE;
+    off_t off = static_cast<off_t>(*offset);
+    unsigned long long total = 0;
+    ssize_t sendRet;
+    int ret;
+
+    ret = SchdfdLock(fd, type);
+    if (ret != 0) {
+        *sendLen = 0;
+        return ret;
+    }
+
+    while (total < count) {
+        size_t chunk = static_cast<size_t>(count - total < maxChunk ? count - total : maxChunk);
+        sendRet = sendfile(fd, fileFd, &off, chunk);
+        if (sendRet > 0) {
+            ret = 0;
+            total += static_cast<unsigned long long>(sendRet);
+            continue;
+        }
+        if (sendRet == 0) {
+            ret = 0; // end of file
+            break;
+        }
+
+        ret = errno;
+        if (ret == 0 || ret == EINTR) {
+            continue;
+        }
+        if (ret != EAGAIN) {
+            LOG_ERROR(ret, "sendfile failed, fd: %d, fileFd: %d", fd, fileFd);
+            break;
+        }
+
+        LOG_INFO(0, "sendfile waiting, fd: %d", fd);
+        if (timeout == static_cast<unsigned long long>(-1)) {
+            ret = SchdfdWaitInlock(fd, type);
+        } else {
+            ret = SchdfdWaitInlockTimeout(fd, type, timeout);
+        }
+        LOG_INFO(0, "sendfile wait over, fd: %d", fd);
+
+        if (ret != 0) {
+            break;
+        }
+    }
+    SchdfdUnlock(fd, type);
+    *offset = static_cast<long long>(off);
+    *sendLen = total;
+    return ret;
+}
+
+int SockSendtoBatchGeneral(int fd, struct SockMsg *msgs, unsigned int count, SocketFlag flags,
+                           int *msgNum, unsigned long long timeout)
+{
+    struct mmsghdr hdrs[SOCK_BATCH_MAX_MSGS];
+    struct iovec iovs[SOCK_BATCH_MAX_MSGS];
+    SchdpollEventType type = SHCDPOLL_WRITE;
+    int sendRet;
+    int ret;
+
+    SockFillMsgHdrs(msgs, count, hdrs, iovs);
+    ret = SchdfdLock(fd, type);
+    if (ret != 0) {
+        return ret;
+    }
+
+    while (1) {
+        do {
+            sendRet = sendmmsg(fd, hdrs, count, flags);
+            ret = errno;
+        } while ((sendRet == -1) && (ret == EINTR || ret == 0));
+
+        if (sendRet >= 0) {
+            ret = 0;
+            for (int i = 0; i < sendRet; ++i) {
+                msgs[i].msgLen = hdrs[i].msg_len;
+            }
+            *msgNum = sendRet;
+            break;
+        }
+
+        if (ret != EAGAIN) {
+            LOG_ERROR(ret, "sendmmsg failed, fd: %d, count: %u", fd, count);
+            break;
+        }
+
+        LOG_INFO(0, "sendmmsg waiting, fd: %d", fd);
+        if (timeout == static_cast<unsigned long long>(-1)) {
+            ret = SchdfdWaitInlock(fd, type);
+        } else {
+            ret = SchdfdWaitInlockTimeout(fd, type, timeout);
+        }
+        LOG_INFO(0, "sendmmsg wait over, fd: %d", fd);
+
+        if (ret != 0) {
+            break;
+        }
+    }
+    SchdfdUnlock(fd, type);
+    return ret;
+}
+
 int SockCreateInternal(int domain, int type, int protocol, int *socketError)
 {
     int sockFd = socket(domain, type | SOCK_NONBLOCK | SOCK_CLOEXEC, protocol);
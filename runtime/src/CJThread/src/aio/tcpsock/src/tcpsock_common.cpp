@@ -296,11 +296,15 @@ void TcpsockRegisterSocketHooks(struct SockCommHooks *hooks)
     hooks->send = SockSendGeneral;
     hooks->recv = SockRecvGeneral;
 #ifdef MRT_WINDOWS
+    hooks->sendv = nullptr;
+    hooks->recvv = nullptr;
     hooks->sendNonBlock = nullptr;
     hooks->waitSend = nullptr;
     hooks->recvNonBlock = nullptr;
     hooks->waitRecv = nullptr;
 #else
+    hooks->sendv = SockSendvGeneral;
+    hooks->recvv = SockRecvvGeneral;
     hooks->sendNonBlock = SockSendNonBlockGeneral;
     hooks->waitSend = TcpsockWaitSend;
     hooks->recvNonBlock = SockRecvNonBlockGeneral;
@@ -312,6 +316,13 @@ void TcpsockRegisterSocketHooks(struct SockCommHooks *hooks)
     hooks->sockAddrGet = SockAddrGetGeneral;
     hooks->recvfrom = nullptr;
     hooks->recvfromNonBlock = nullptr;
+    hooks->recvfromBatch = nullptr;
+    hooks->sendtoBatch = nullptr;
+#ifdef MRT_LINUX
+    hooks->sendFile = SockSendFileGeneral;
+#else
+    hooks->sendFile = nullptr;
+#endif
     hooks->sendto = nullptr;
     hooks->sendtoNonBlock = nullptr;
     hooks->createSocket = TcpsockCreate;
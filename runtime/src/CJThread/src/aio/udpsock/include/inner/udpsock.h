@@ -101,6 +101,26 @@ int UdpsockDisconnect(SignedSocket connFd);
 int UdpsockDisconnectForIPv6(SignedSocket connFd);
 #endif
 
+#ifndef MRT_WINDOWS
+/**
+ * @brief  udp socket wait send events
+ * @param fd            [IN] socket handle
+ * @param timeout       [IN] timeout
+ * @retval #0 The function is executed successfully
+ * @retval #error Failed to execute the function
+ */
+int UdpsockWaitSend(SignedSocket fd, unsigned long long timeout);
+
+/**
+ * @brief  udp socket wait recv events
+ * @param fd            [IN] socket handle
+ * @param timeout       [IN] timeout
+ * @retval #0 The function is executed successfully
+ * @retval #error Failed to execute the function
+ */
+int UdpsockWaitRecv(SignedSocket fd, unsigned long long timeout);
+#endif
+
 /**
  * @brief register socket hooks
  * @param hooks         [OUT] SockCommHooks pointer
@@ -124,6 +124,33 @@ int UdpsockBindConnect(SignedSocket connFd, struct SockAddr *local, struct SockA
     return 0;
 }
 
+#ifndef MRT_WINDOWS
+static int UdpsockWait(SignedSocket fd, SchdpollEventType type, unsigned long long timeout)
+{
+    int ret = SchdfdLock(fd, type);
+    if (ret != 0) {
+        return ret;
+    }
+    if (timeout == static_cast<unsigned long long>(-1)) {
+        ret = SchdfdWaitInlock(fd, type);
+    } else {
+        ret = SchdfdWaitInlockTimeout(fd, type, timeout);
+    }
+    SchdfdUnlock(fd, type);
+    return ret;
+}
+
+int UdpsockWaitSend(SignedSocket fd, unsigned long long timeout)
+{
+    return UdpsockWait(fd, SHCDPOLL_WRITE, timeout);
+}
+
+int UdpsockWaitRecv(SignedSocket fd, unsigned long long timeout)
+{
+    return UdpsockWait(fd, SHCDPOLL_READ, timeout);
+}
+#endif
+
 /* register socket hooks */
 void UdpsockRegisterSocketHooks(struct SockCommHooks *hooks)
 {
@@ -136,17 +163,36 @@ void UdpsockRegisterSocketHooks(struct SockCommHooks *hooks)
     hooks->disconnectForIPv6 = UdpsockDisconnectForIPv6;
 #endif
     hooks->send = SockSendGeneral;
+    hooks->recv = SockRecvGeneral;
+#ifdef MRT_WINDOWS
+    hooks->sendv = nullptr;
+    hooks->recvv = nullptr;
     hooks->sendNonBlock = nullptr;
     hooks->waitSend = nullptr;
-    hooks->recv = SockRecvGeneral;
     hooks->recvNonBlock = nullptr;
     hooks->waitRecv = nullptr;
+#else
+    hooks->sendv = SockSendvGeneral;
+    hooks->recvv = SockRecvvGeneral;
+    hooks->sendNonBlock = SockSendNonBlockGeneral;
+    hooks->waitSend = UdpsockWaitSend;
+    hooks->recvNonBlock = SockRecvNonBlockGeneral;
+    hooks->waitRecv = UdpsockWaitRecv;
+#endif
     hooks->close = SockCloseGeneral;
     hooks->shutdown = SockShutdownGeneral;
     hooks->keepAliveSet = nullptr;
     hooks->sockAddrGet = SockAddrGetGeneral;
     hooks->recvfrom = SockRecvfromGeneral;
     hooks->recvfromNonBlock = nullptr;
+#ifdef MRT_LINUX
+    hooks->recvfromBatch = SockRecvfromBatchGeneral;
+    hooks->sendtoBatch = SockSendtoBatchGeneral;
+#else
+    hooks->recvfromBatch = nullptr;
+    hooks->sendtoBatch = nullptr;
+#endif
+    hooks->sendFile = nullptr;
     hooks->sendto = SockSendtoGeneral;
     hooks->sendtoNonBlock = nullptr;
     hooks->createSocket = UdpsockCreate;
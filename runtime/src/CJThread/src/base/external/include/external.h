@@ -97,6 +97,26 @@ struct IocpOperation {
 };
 #endif
 
+/**
+ * @brief Deadline of timed waits in one direction of a fd.
+ * The timer is reused by successive waits and re-armed lazily: a wait moves it only when its
+ * deadline is earlier than the armed one, and the timer callback re-arms it when it fires
+ * before the deadline of the current wait. The callback releases the timer once no wait is
+ * pending, and frees this structure after the fd is deregistered.
+ */
+struct SchdfdDeadline {
+    pthread_mutex_t lock;
+    struct SchdpollDesc *pd;        // schdpoll descriptor of the fd
+    int type;                       // SchdpollEventType of the waits
+    void *timer;                    // TimerHandle, nullptr if no timer is armed
+    unsigned long long armed;       // deadline the timer is armed to
+    unsigned long long deadline;    // deadline of the current wait, 0 if there is no timed wait
+    bool expired;                   // the current wait has timed out
+    bool idle;                      // the timer is kept for one period without waits
+    bool closed;                    // fd is deregistered
+    void (*release)(struct SchdfdDeadline *deadline);  // closes the deadline, see FreeSchdfdDeadline
+};
+
 /**
  * @brief fd management structure
  */
@@ -105,8 +125,8 @@ struct SchdfdFd {
     struct Sema readSema;         // Read semaphore, used to control the sequence of read operations on fd
     struct Sema writeSema;        // Write semaphore, used to control the sequence of write operations on fd
     struct SchdpollDesc *pd;      // schdpoll descriptor
-    std::atomic<uintptr_t> readTimer;
-    std::atomic<uintptr_t> writeTimer;
+    std::atomic<struct SchdfdDeadline *> readDeadline;   // created by the first timed read wait
+    std::atomic<struct SchdfdDeadline *> writeDeadline;  // created by the first timed write wait
 #ifdef MRT_WINDOWS
     struct IocpOperation readOperation;  // IOCP read operation structure
     struct IocpOperation writeOperation; // IOCP write operation structure
@@ -54,6 +54,14 @@ void FreeSchdfdManager(struct SchdfdManager *schdfdManager)
     free(schdfdManager);
 }
 
+/* A deadline is closed by the schdfd module, which leaves one with an armed timer to its timer callback. */
+static void FreeSchdfdDeadline(struct SchdfdDeadline *deadline)
+{
+    if (deadline != nullptr) {
+        deadline->release(deadline);
+    }
+}
+
 void FreeSchdfdFd(struct SchdfdFd *schdfdFd)
 {
     if (schdfdFd == nullptr) {
@@ -63,6 +71,8 @@ void FreeSchdfdFd(struct SchdfdFd *schdfdFd)
         free(schdfdFd->pd);
         schdfdFd->pd = nullptr;
     }
+    FreeSchdfdDeadline(schdfdFd->readDeadline);
+    FreeSchdfdDeadline(schdfdFd->writeDeadline);
     free(schdfdFd);
 }
 
@@ -25,8 +25,6 @@
 #define SchdfdWait                               CJ_SchdfdWait
 #define SchdfdWaitTimeout                        CJ_SchdfdWaitTimeout
 #define SchdfdWaitInlock                         CJ_SchdfdWaitInlock
-#define SchdfdReadTimeout                        CJ_SchdfdReadTimeout
-#define SchdfdWriteTimeout                       CJ_SchdfdWriteTimeout
 #define SchdfdWaitInlockTimeout                  CJ_SchdfdWaitInlockTimeout
 #define SchdfdLock                               CJ_SchdfdLock
 #define SchdfdUnlock                             CJ_SchdfdUnlock
@@ -82,6 +80,14 @@
 #define SockRecvfromTimeout                      CJ_MRT_SockRecvfromTimeout
 #define SockRecvfrom                             CJ_SockRecvfrom
 #define SockRecvfromNonBlock                     CJ_MRT_SockRecvfromNonBlock
+#define SockSendvTimeout                         CJ_MRT_SockSendvTimeout
+#define SockSendv                                CJ_MRT_SockSendv
+#define SockRecvvTimeout                         CJ_MRT_SockRecvvTimeout
+#define SockRecvv                                CJ_MRT_SockRecvv
+#define SockRecvfromBatch                        CJ_MRT_SockRecvfromBatch
+#define SockSendtoBatch                          CJ_MRT_SockSendtoBatch
+#define SockSendFileTimeout                      CJ_MRT_SockSendFileTimeout
+#define SockSendFile                             CJ_MRT_SockSendFile
 #define SockOptionSet                            CJ_SockOptionSet
 #define SockOptionGet                            CJ_SockOptionGet
 #define SockAddrGetGeneral                       CJ_SockAddrGetGeneral
@@ -98,6 +104,11 @@
 #define SockRecvNonBlockGeneral                  CJ_MRT_SockRecvNonBlockGeneral
 #define SockSendtoNonBlockGeneral                CJ_MRT_SockSendtoNonBlockGeneral
 #define SockRecvfromNonBlockGeneral              CJ_SockRecvfromNonBlockGeneral
+#define SockSendvGeneral                         CJ_SockSendvGeneral
+#define SockRecvvGeneral                         CJ_SockRecvvGeneral
+#define SockRecvfromBatchGeneral                 CJ_SockRecvfromBatchGeneral
+#define SockSendtoBatchGeneral                   CJ_SockSendtoBatchGeneral
+#define SockSendFileGeneral                      CJ_SockSendFileGeneral
 #define SockWinStartup                           CJ_SockWinStartup
 #define SockLoadMswsockHooks                     CJ_SockLoadMswsockHooks
 #define SockMswsockHooksReg                      CJ_SockMswsockHooksReg
@@ -129,6 +140,8 @@
 #define DomainsockAccept                         CJ_DomainsockAccept
 #define DomainsockConnect                        CJ_DomainsockConnect
 #define DomainsockBindConnect                    CJ_DomainsockBindConnect
+#define DomainsockWaitSend                       CJ_DomainsockWaitSend
+#define DomainsockWaitRecv                       CJ_DomainsockWaitRecv
 #define DomainsockInit                           CJ_MRT_DomainsockInit
 
 /* udpsock */
@@ -138,6 +151,8 @@
 #define UdpsockConnect                           CJ_UdpsockConnect
 #define UdpsockDisconnect                        CJ_UdpsockDisconnect
 #define UdpsockBindConnect                       CJ_UdpsockBindConnect
+#define UdpsockWaitSend                          CJ_UdpsockWaitSend
+#define UdpsockWaitRecv                          CJ_UdpsockWaitRecv
 #define UdpsockRegisterSocketHooks               CJ_UdpsockRegisterSocketHooks
 #define UdpsockInit                              CJ_MRT_UdpsockInit
 
@@ -311,6 +326,7 @@
 #define SchdpollReady                           CJ_SchdpollReady
 #define SchdpollAcquireCallback                 CJ_SchdpollAcquireCallback
 #define SchdpollAcquire                         CJ_SchdpollAcquire
+#define SchdpollAcquireShard                    CJ_SchdpollAcquireShard
 #define SchdpollCallbackCJThread                CJ_SchdpollCallbackCJThread
 #define SchdpollNotifyCallback                  CJ_SchdpollNotifyCallback
 #define SchdpollCallbackAdd                     CJ_SchdpollCallbackAdd
@@ -493,6 +509,12 @@
 #define TimerRelease                             CJ_TimerRelease
 #define TimerGetHeap                             CJ_TimerGetHeap
 #define TimerStoppedDoRemove                     CJ_TimerStoppedDoRemove
+#define TimerWheelEnabled                        CJ_TimerWheelEnabled
+#define TimerWheelAddNew                         CJ_TimerWheelAddNew
+#define TimerWheelStop                           CJ_TimerWheelStop
+#define TimerWheelTryStop                        CJ_TimerWheelTryStop
+#define TimerWheelReset                          CJ_TimerWheelReset
+#define TimerWheelRelease                        CJ_TimerWheelRelease
 
 /* basetime */
 #define CurrentNanotimeGet                       CJ_CurrentNanotimeGet
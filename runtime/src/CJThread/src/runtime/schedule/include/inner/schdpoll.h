@@ -53,7 +53,8 @@ enum SchdpollDescType {
     SCHDPOLL_CJTHREAD,              /* use cjthread */
     SCHDPOLL_CALLBACK,              /* use callback */
     SCHDPOLL_CALLBACK_FD_OUTSIDE,   /* fd is added to epoll externally. Special processing */
-    SCHDPOLL_CALLBACK_EVENT
+    SCHDPOLL_CALLBACK_EVENT,
+    SCHDPOLL_SHARD                  /* epfd of a netpoll shard, callback.arg is the shard */
 };
 
 struct SchdpollNotifyUsrInfo {
@@ -150,6 +151,21 @@ struct CJThread *SchdpollReady(struct SchdpollDesc *pd, enum SchdpollEventType t
 int SchdpollAcquire(struct Schedule *schedule, void *buf[], unsigned int bufLen, int timeout);
 
 #ifdef MRT_LINUX
+/* Maximum number of netpoll shards */
+#define SCHDPOLL_SHARD_MAX 64
+
+/**
+ * @brief Access the netpoll shard owned by a processor to obtain the ready cjthreads.
+ * @par Description: cjthread fds are spread over netpoll shards by fd. A processor polls its
+ * own shard without blocking, so that pollers on different processors do not contend.
+ * @param schedule    [IN] Home scheduler.
+ * @param processorId    [IN] Id of the polling processor.
+ * @param buf    [IN] Cache for storing ready cjthreads.
+ * @param bufLen    [IN] Cache size.
+ * @retval Returns the number of ready cjthreads, 0 if netpoll is not sharded.
+ */
+int SchdpollAcquireShard(struct Schedule *schedule, unsigned int processorId, void *buf[], unsigned int bufLen);
+
 /**
 * @brief Obtain the internal epoll handle.
 * @retval epoll handle
@@ -72,6 +72,19 @@ enum ScheduleFinishPhase {
     FINI_PROCESSOR
 };
 
+/* Upper limit of global runq shards */
+#define SCHEDULE_RUNQ_SHARD_MAX 16
+
+/**
+ * @brief One shard of the global run queue. Each shard has its own lock and sits in its
+ * own cache line, so processors pushing or pulling batches do not contend on one mutex.
+ */
+struct ScheduleRunqShard {
+    pthread_mutex_t mutex;                    /* locks that protect this shard */
+    unsigned long long num;                   /* number of nodes in runq */
+    struct Dulink runq;                       /* cjthread to run */
+} __attribute__((aligned(64)));
+
 /**
  * @brief Structure of the scheduler cjthread attribute
  */
@@ -84,12 +97,22 @@ struct ScheduleCJThread {
     bool stackProtect;                        /* whether to enable cjthread stack protection */
     bool stackGrow;                           /* whether to enable cjthread stack scaling */
 
-    pthread_mutex_t mutex;                    /* locks that protect this variable */
-    unsigned long long num;                   /* total number of nodes in runq */
-    struct Dulink runq;                       /* cjthread to run(global queue) */
+    std::atomic<unsigned long long> num;      /* total number of nodes in all runq shards */
+    unsigned int runqShardNum;                /* number of global runq shards in use */
+    std::atomic<unsigned int> runqShardCursor; /* next shard for writers without a processor */
+    struct ScheduleRunqShard runqShards[SCHEDULE_RUNQ_SHARD_MAX]; /* cjthread to run(global queue) */
     struct ScheduleGfreeList gfreelist;       /* global cjthread free list */
 };
 
+/**
+ * @brief Get the global runq shard with the given index, processors use their processorId.
+ */
+MRT_INLINE static struct ScheduleRunqShard *ScheduleRunqShardGet(struct ScheduleCJThread *schdCJThread,
+                                                                  unsigned int index)
+{
+    return &schdCJThread->runqShards[index % schdCJThread->runqShardNum];
+}
+
 /**
  * @brief Structure of the scheduler thread attribute
  */
@@ -156,12 +179,28 @@ struct Schmon {
     SchmonCheckFunc checkFunc[SCHMON_HOOK_NUM];         /* timer hooks */
 };
 
+#ifdef MRT_LINUX
+/* epoll instance owning a subset of cjthread fds, polled independently of other shards */
+struct NetpollShard {
+    pthread_mutex_t pollMutex;          /* locks that prevent concurrent epoll operations on this shard */
+    NetpollFd npfd;                     /* fd used by cjthread asynchronous I/O */
+    struct CJthreadSpinLock closingLock;     /* lock of closingPd */
+    struct SchdpollDesc *closingPd;     /* pd to be closed is cleared after each acquire of this shard. */
+    struct SchdpollDesc *pd;            /* pd registering this shard to the main netpoll */
+    std::atomic<bool> pending;          /* last acquire was truncated, events may be left in the shard */
+};
+#endif
+
 /* nepoll */
 struct Netpoll {
     pthread_mutex_t pollMutex;          /* locks that prevent concurrent epoll operations */
     NetpollFd npfd;                     /* fd used by cjthread asynchronous I/O */
     struct CJthreadSpinLock closingLock;     /* lock of closingPd */
     struct SchdpollDesc *closingPd;     /* pd to be closed is cleared after each acquire. */
+#ifdef MRT_LINUX
+    unsigned int shardNum;              /* 0 if cjthread fds are registered to npfd directly */
+    struct NetpollShard *shards;        /* shards of cjthread fds, each shard epfd is registered to npfd */
+#endif
 };
 
 /**
@@ -33,6 +33,7 @@ int ProcessorGlobalWrite(struct CJThread *cjthreadList[], unsigned int num)
 {
     struct Dulink tempDulink;
     struct Schedule *sch;
+    struct ScheduleRunqShard *shard;
     unsigned long length;
     unsigned long i;
     void *buf[PROCESSOR_QUEUE_CAPACITY] = {nullptr};
@@ -48,7 +49,7 @@ int ProcessorGlobalWrite(struct CJThread *cjthreadList[], unsigned int num)
         length = QueuePopHeadBatch(&processor->runq, buf, length);
     }
 
-    // To reduce the occupation time of schdCJThread.mutex, use tempDulink to temporarily
+    // To reduce the occupation time of the shard mutex, use tempDulink to temporarily
     // store the file, and then move the file to runq.
     for (i = 0; i < length; i++) {
         DulinkPushtail(&tempDulink, buf[i]);
@@ -58,11 +59,13 @@ int ProcessorGlobalWrite(struct CJThread *cjthreadList[], unsigned int num)
         DulinkPushtail(&tempDulink, cjthreadList[i]);
     }
 
-    // Add to the global queue of the schedule.
-    pthread_mutex_lock(&sch->schdCJThread.mutex);
-    DulinkMove(&sch->schdCJThread.runq, &tempDulink, 0);
+    // Add to the global queue shard of this processor.
+    shard = ScheduleRunqShardGet(&sch->schdCJThread, processor->processorId);
+    pthread_mutex_lock(&shard->mutex);
+    DulinkMove(&shard->runq, &tempDulink, 0);
+    shard->num += (length + num);
     sch->schdCJThread.num += (length + num);
-    pthread_mutex_unlock(&sch->schdCJThread.mutex);
+    pthread_mutex_unlock(&shard->mutex);
 
     return 0;
 }
@@ -92,69 +95,101 @@ int ProcessorLocalWriteBatch(struct CJThread **cjthread, unsigned int num)
     return 0;
 }
 
-/* Bulk fetching schedulable cjthreads from the global queue */
-struct CJThread *ProcessorGlobalRead(void *schedule, bool batch)
+/* Take up to readNum cjthreads from one global runq shard, return the first one. The rest go to
+ * the local queue, so readNum must be 1 if the caller is not on a processor. */
+static struct CJThread *ProcessorRunqShardRead(struct ScheduleCJThread *schdCJThread,
+                                               struct ScheduleRunqShard *shard, unsigned int readNum)
 {
-    struct ScheduleCJThread *schdCJThread;
-    struct Dulink *runDulink;
     struct Dulink tempDulink;
     struct CJThread *cjthreadTemp;
-    struct CJThread *cjthreadNext = nullptr;
+    struct CJThread *cjthreadNext;
     void *buf[PROCESSOR_QUEUE_CAPACITY];
     unsigned int i;
-    unsigned int readNum = 1;
-    struct Processor *processor;
-    unsigned int processorNum = ((struct Schedule *)schedule)->schdProcessor.processorNum;
 
-    schdCJThread = &((struct Schedule *)schedule)->schdCJThread;
-    if (schdCJThread->num == 0) {
+    if (shard->num == 0) {
         return nullptr;
     }
-    runDulink = &schdCJThread->runq;
-    pthread_mutex_lock(&(schdCJThread->mutex));
+    pthread_mutex_lock(&shard->mutex);
 
-    if (schdCJThread->num == 0) {
-        pthread_mutex_unlock(&(schdCJThread->mutex));
+    if (shard->num == 0) {
+        pthread_mutex_unlock(&shard->mutex);
         return nullptr;
     }
-
-    if (batch) {
-        // The quantity is the number of processes in the global queue divided by the number
-        // of processors. The value must be at least 1.
-        readNum = (schdCJThread->num + processorNum - 1) / processorNum;
-        if (readNum > PROCESSOR_QUEUE_CAPACITY) {
-            readNum = PROCESSOR_QUEUE_CAPACITY;
-        }
+    if (readNum > shard->num) {
+        readNum = static_cast<unsigned int>(shard->num);
     }
+    shard->num -= readNum;
     schdCJThread->num -= readNum;
 
     // Get one first
-    cjthreadNext = DULINK_ENTRY(runDulink->next, struct CJThread, schdDulink);
+    cjthreadNext = DULINK_ENTRY(shard->runq.next, struct CJThread, schdDulink);
     DulinkRemove(&(cjthreadNext->schdDulink));
 
     if (readNum == 1) {
-        pthread_mutex_unlock(&(schdCJThread->mutex));
+        pthread_mutex_unlock(&shard->mutex);
         return cjthreadNext;
     }
     --readNum;
     DulinkInit(&tempDulink);
-    DulinkMove(&tempDulink, runDulink, readNum);
-    pthread_mutex_unlock(&(schdCJThread->mutex));
+    DulinkMove(&tempDulink, &shard->runq, readNum);
+    pthread_mutex_unlock(&shard->mutex);
 
-    // The rest of the cjthreads are placed in the local queue. If batch is false or only
-    // one cjthread is obtained, the loop will not be entered.
-    processor = ProcessorGet();
+    // The rest of the cjthreads are placed in the local queue.
     for (i = 0; i < readNum; i++) {
         cjthreadTemp = DULINK_ENTRY(tempDulink.next, struct CJThread, schdDulink);
         DulinkRemove(&(cjthreadTemp->schdDulink));
         buf[i] = (void *)cjthreadTemp;
     }
 
-    QueuePushTailBatch(&processor->runq, buf, readNum);
+    QueuePushTailBatch(&ProcessorGet()->runq, buf, readNum);
 
     return cjthreadNext;
 }
 
+/* Bulk fetching schedulable cjthreads from the global queue. The shard of the current
+ * processor is read first, then the other shards in order, so that no shard starves. */
+struct CJThread *ProcessorGlobalRead(void *schedule, bool batch)
+{
+    struct ScheduleCJThread *schdCJThread;
+    struct CJThread *cjthreadNext;
+    unsigned int i;
+    unsigned int home;
+    bool onProcessor;
+    unsigned long long readNum = 1;
+    unsigned int processorNum = ((struct Schedule *)schedule)->schdProcessor.processorNum;
+
+    schdCJThread = &((struct Schedule *)schedule)->schdCJThread;
+    if (schdCJThread->num == 0) {
+        return nullptr;
+    }
+
+    // The schedule may be released from a thread that is not running on a processor. It has no
+    // local queue for the surplus of a batch, so only one cjthread is read.
+    onProcessor = CJThreadGet() != nullptr && ((struct Thread *)CJThreadGet()->thread)->processor != nullptr;
+    home = onProcessor ? ProcessorGet()->processorId : 0;
+    if (batch && onProcessor) {
+        // The quantity is the number of processes in the global queue divided by the number
+        // of processors. The value must be at least 1.
+        readNum = (schdCJThread->num + processorNum - 1) / processorNum;
+        if (readNum == 0) {
+            readNum = 1;
+        }
+        if (readNum > PROCESSOR_QUEUE_CAPACITY) {
+            readNum = PROCESSOR_QUEUE_CAPACITY;
+        }
+    }
+
+    for (i = 0; i < schdCJThread->runqShardNum; ++i) {
+        cjthreadNext = ProcessorRunqShardRead(schdCJThread, ScheduleRunqShardGet(schdCJThread, home + i),
+                                              static_cast<unsigned int>(readNum));
+        if (cjthreadNext != nullptr) {
+            return cjthreadNext;
+        }
+    }
+
+    return nullptr;
+}
+
 /* Add a single cjthread to the local queue */
 int ProcessorLocalWrite(struct CJThread *cjthread, bool isReschd)
 {
@@ -623,6 +658,21 @@ struct CJThread *ProcessorCJThreadGet(void)
         // Attempt to get ready events from netpoll. This interface may return a failure less
         // than zero. For example, fd is disabled when the scheduling framework exits.
         if (schedule->netpoll.npfd != nullptr) {
+#ifdef MRT_LINUX
+            // Poll the netpoll shard owned by this processor first, its ready cjthreads go to the
+            // local queue directly. Wake an idle processor to steal them if there are several.
+            num = SchdpollAcquireShard(schedule, curProcessor->processorId, buf, SCHDPOLL_ACQUIRE_MAX_NUM);
+            if (num > 0) {
+                int error = ProcessorLocalWriteBatch(reinterpret_cast<struct CJThread **>(buf), num);
+                if (error) {
+                    LOG_ERROR(error, "ProcessorLocalWriteBatch failed");
+                }
+                if (num > 1) {
+                    ProcessorWake(schedule, nullptr);
+                }
+                continue;
+            }
+#endif
             num = SchdpollAcquire(schedule, buf, SCHDPOLL_ACQUIRE_MAX_NUM, 0);
             if (num > 0) {
                 // After successfully fetching the cjthread from netpoll, review the local
@@ -5,6 +5,7 @@
 // See https://cangjie-lang.cn/pages/LICENSE for license information.
 
 
+#include <cstdlib>
 #include "schdpoll.h"
 #include "schedule_impl.h"
 #include "log.h"
@@ -17,12 +18,128 @@
 extern "C" {
 #endif
 
+#ifdef MRT_LINUX
+/* Number of netpoll shards, one per processor by default and configurable by cjNetpollShardNum.
+ * 0 means cjthread fds are registered to the main netpoll directly. A processor polls the shard
+ * processorId % shardNum itself, so more shards than processors would leave some never self-polled. */
+static unsigned int SchdpollShardNumGet(struct Schedule *schedule)
+{
+    unsigned int processorNum = schedule->schdProcessor.processorNum;
+    unsigned int num = processorNum;
+    const char *env = std::getenv("cjNetpollShardNum");
+    if (env != nullptr) {
+        num = static_cast<unsigned int>(strtoul(env, nullptr, 0));
+    }
+    if (num > processorNum) {
+        num = processorNum;
+    }
+    if (num > SCHDPOLL_SHARD_MAX) {
+        num = SCHDPOLL_SHARD_MAX;
+    }
+    return num <= 1 ? 0 : num;
+}
+
+/* Release a shard whose locks are initialized. */
+static void SchdpollShardDestroy(struct NetpollShard *shard)
+{
+    if (shard->npfd != nullptr) {
+        NetpollExit(shard->npfd);
+        shard->npfd = nullptr;
+    }
+    free(shard->pd);
+    shard->pd = nullptr;
+    pthread_mutex_destroy(&shard->pollMutex);
+    PthreadSpinDestroy(&shard->closingLock);
+}
+
+static void SchdpollShardsDestroy(struct NetpollShard *shards, unsigned int num)
+{
+    for (unsigned int i = 0; i < num; ++i) {
+        SchdpollShardDestroy(&shards[i]);
+    }
+    free(shards);
+}
+
+/* Initialize a shard and register its epfd to the main netpoll, a failed shard is cleaned up here. */
+static bool SchdpollShardInit(struct NetpollShard *shard, NetpollFd mainNpfd)
+{
+    if (pthread_mutex_init(&shard->pollMutex, nullptr) != 0) {
+        return false;
+    }
+    if (PthreadSpinInit(&shard->closingLock) != 0) {
+        pthread_mutex_destroy(&shard->pollMutex);
+        return false;
+    }
+    shard->npfd = NetpollCreate();
+    shard->pd = (struct SchdpollDesc *)calloc(1, sizeof(struct SchdpollDesc));
+    if (shard->npfd != nullptr && shard->pd != nullptr) {
+        shard->pd->fd = NetpollInnerFd(shard->npfd);
+        shard->pd->type = SCHDPOLL_SHARD;
+        shard->pd->callback.arg = shard;
+        if (NetpollAdd(mainNpfd, shard->pd->fd, shard->pd, EPOLLIN) == 0) {
+            return true;
+        }
+    }
+    SchdpollShardDestroy(shard);
+    return false;
+}
+
+/* Create the shards and register their epfds to the main netpoll, so that schmon waiting on the
+ * main netpoll is still woken up by events of any shard. Fall back to a single netpoll on failure. */
+static void SchdpollShardsInit(struct Netpoll *netpoll, NetpollFd mainNpfd, unsigned int num)
+{
+    struct NetpollShard *shards;
+    unsigned int i;
+
+    if (num == 0) {
+        return;
+    }
+    shards = (struct NetpollShard *)calloc(num, sizeof(struct NetpollShard));
+    if (shards == nullptr) {
+        LOG_ERROR(ERRNO_SCHD_MALLOC_FAILED, "malloc failed, size: %u", num * sizeof(struct NetpollShard));
+        return;
+    }
+    for (i = 0; i < num; ++i) {
+        if (!SchdpollShardInit(&shards[i], mainNpfd)) {
+            break;
+        }
+    }
+    if (i < num) {
+        LOG_ERROR(ERRNO_SCHD_INIT_FAILED, "netpoll shards init failed, use a single netpoll");
+        // Only the shards before the failed one are fully initialized.
+        SchdpollShardsDestroy(shards, i);
+        return;
+    }
+    netpoll->shards = shards;
+    netpoll->shardNum = num;
+}
+
+/* cjthread fds are spread over the shards by fd, callbacks stay on the main netpoll. */
+static struct NetpollShard *SchdpollShardOf(struct Netpoll *netpoll, FdHandle fd, struct SchdpollDesc *pd)
+{
+    if (netpoll->shardNum == 0 || (pd != nullptr && pd->type != SCHDPOLL_CJTHREAD)) {
+        return nullptr;
+    }
+    return &netpoll->shards[static_cast<unsigned int>(fd) % netpoll->shardNum];
+}
+#endif
+
 void SchdpollInit(void)
 {
-    struct Netpoll *netpoll = &ScheduleGet()->netpoll;
+    struct Schedule *schedule = ScheduleGet();
+    struct Netpoll *netpoll = &schedule->netpoll;
+    NetpollFd npfd;
     pthread_mutex_lock(&netpoll->pollMutex);
     if (netpoll->npfd == nullptr) {
-        netpoll->npfd = NetpollCreate();
+        npfd = NetpollCreate();
+#ifdef MRT_LINUX
+        if (npfd != nullptr) {
+            SchdpollShardsInit(netpoll, npfd, SchdpollShardNumGet(schedule));
+        }
+        // npfd is checked without lock, publish it after the shards.
+        std::atomic_thread_fence(std::memory_order_release);
+#endif
+        netpoll->npfd = npfd;
     }
     pthread_mutex_unlock(&netpoll->pollMutex);
 }
@@ -46,7 +163,9 @@ struct SchdpollDesc *SchdpollAdd(FdHandle fd)
     pd->cjthread.writeWaiter = PD_NOWAIT;
 #ifdef MRT_LINUX
     pd->type = SCHDPOLL_CJTHREAD;
-    if (NetpollAdd(schedule->netpoll.npfd, fd, pd, EPOLLIN | EPOLLOUT | EPOLLRDHUP) != 0) {
+    struct NetpollShard *shard = SchdpollShardOf(&schedule->netpoll, fd, pd);
+    NetpollFd npfd = shard != nullptr ? shard->npfd : schedule->netpoll.npfd;
+    if (NetpollAdd(npfd, fd, pd, EPOLLIN | EPOLLOUT | EPOLLRDHUP) != 0) {
         free(pd);
         return nullptr;
     }
@@ -94,10 +213,11 @@ int SchdpollDel(struct Schedule *schedule, FdHandle fd, struct SchdpollDesc *pd,
 int SchdpollDel(struct Schedule *schedule, FdHandle fd, struct SchdpollDesc *pd, int netpollState)
 {
     int ret;
+    struct NetpollShard *shard = SchdpollShardOf(&schedule->netpoll, fd, pd);
     // The value of netpollState indicates whether netpoll_add has been executed for the fd.
     // If netpoll_ADD has been executed for the fd, netpoll_del must be executed for the fd.
     if (netpollState == NETPOLL_ADDED) {
-        ret = NetpollDel(schedule->netpoll.npfd, fd);
+        ret = NetpollDel(shard != nullptr ? shard->npfd : schedule->netpoll.npfd, fd);
         if (ret != 0) {
             return ret;
         }
@@ -106,12 +226,15 @@ int SchdpollDel(struct Schedule *schedule, FdHandle fd, struct SchdpollDesc *pd,
     // To avoid the pd wild pointer problem caused by concurrency with SchdpollAcquire, the pd
     // is added to the linked list and released at the end of each SchdpollAcquire. At this
     // time, the pd is removed from the netpoll listening queue and will not be accessed after
-    // being released.
+    // being released. A pd of a shard is released by the acquire of that shard.
     if (pd != nullptr) {
-        PthreadSpinLock(&schedule->netpoll.closingLock);
-        pd->next = schedule->netpoll.closingPd;
-        schedule->netpoll.closingPd = pd;
-        PthreadSpinUnlock(&schedule->netpoll.closingLock);
+        struct CJthreadSpinLock *closingLock = shard != nullptr ? &shard->closingLock :
+                                                                  &schedule->netpoll.closingLock;
+        struct SchdpollDesc **closingPd = shard != nullptr ? &shard->closingPd : &schedule->netpoll.closingPd;
+        PthreadSpinLock(closingLock);
+        pd->next = *closingPd;
+        *closingPd = pd;
+        PthreadSpinUnlock(closingLock);
     }
 
     return 0;
@@ -251,21 +374,33 @@ struct CJThread *SchdpollReady(struct SchdpollDesc *pd, SchdpollEventType type,
 
 #if defined (MRT_LINUX) || defined (MRT_MACOS)
 
-void SchdpollFreePd(void)
+static void SchdpollFreeClosingPd(struct CJthreadSpinLock *closingLock, struct SchdpollDesc **closingList)
 {
     struct SchdpollDesc *pd;
     struct SchdpollDesc *closingPd;
-    struct Schedule *schedule = ScheduleGet();
 
-    PthreadSpinLock(&schedule->netpoll.closingLock);
-    closingPd = schedule->netpoll.closingPd;
+    PthreadSpinLock(closingLock);
+    closingPd = *closingList;
     while (closingPd != nullptr) {
         pd = closingPd;
         closingPd = closingPd->next;
         free(pd);
     }
-    schedule->netpoll.closingPd = nullptr;
-    PthreadSpinUnlock(&schedule->netpoll.closingLock);
+    *closingList = nullptr;
+    PthreadSpinUnlock(closingLock);
+}
+
+void SchdpollFreePd(void)
+{
+    struct Schedule *schedule = ScheduleGet();
+
+    SchdpollFreeClosingPd(&schedule->netpoll.closingLock, &schedule->netpoll.closingPd);
+#ifdef MRT_LINUX
+    for (unsigned int i = 0; i < schedule->netpoll.shardNum; ++i) {
+        struct NetpollShard *shard = &schedule->netpoll.shards[i];
+        SchdpollFreeClosingPd(&shard->closingLock, &shard->closingPd);
+    }
+#endif
 }
 
 #endif
@@ -355,39 +490,26 @@ void SchdpollAcquireCallback(struct SchdpollDesc *pd, struct epoll_event *pollEv
     }
 }
 
-/* Call netpoll to obtain the ready cjthread queue. */
-int SchdpollAcquire(struct Schedule *schedule, void *buf[], unsigned int bufLen, int timeout)
+/* Convert epoll events to ready cjthreads. Shards with events are returned in readyShards. */
+static int SchdpollEventsProcess(struct epoll_event *events, int eventsNum, void *buf[],
+                                 struct NetpollShard *readyShards[], unsigned int *readyNum)
 {
-    int eventsNum;
     int eventsIdx;
     int bufIdx = 0;
     struct epoll_event *pollEvent;
     struct SchdpollDesc *pd;
     struct CJThread *wakeCJThread;
-    struct epoll_event events[SCHDPOLL_EVENT_NUM];
-
-    // Only one thread needs to perform netpoll_wait at a time. Because one thread can obtain
-    // all events, multiple threads do not need to be concurrent.
-    if (pthread_mutex_trylock(&schedule->netpoll.pollMutex) != 0) {
-        return 0;
-    }
-    if (schedule->state == SCHEDULE_SUSPENDING) {
-        pthread_mutex_unlock(&schedule->netpoll.pollMutex);
-        return 0;
-    }
-    
-    eventsNum = InitEventsNum(bufLen);
-    // Wait events
-    eventsNum = NetpollWait(schedule->netpoll.npfd, events, eventsNum, timeout);
-    if (eventsNum <= 0) {
-        pthread_mutex_unlock(&schedule->netpoll.pollMutex);
-        return eventsNum;
-    }
 
     // events_num <= buf_len / 2, so buf_idx is not out of bounds.
     for (eventsIdx = 0; eventsIdx < eventsNum; ++eventsIdx) {
         pollEvent = &(events[eventsIdx]);
         pd = static_cast<struct SchdpollDesc *>(pollEvent->data.ptr);
+        if (pd->type == SCHDPOLL_SHARD) {
+            if (readyShards != nullptr) {
+                readyShards[(*readyNum)++] = static_cast<struct NetpollShard *>(pd->callback.arg);
+            }
+            continue;
+        }
         if (pd->callback.func != nullptr) {
             SchdpollAcquireCallback(pd, pollEvent);
             continue;
@@ -408,9 +530,119 @@ int SchdpollAcquire(struct Schedule *schedule, void *buf[], unsigned int bufLen,
             }
         }
     }
+    return bufIdx;
+}
+
+/* Poll a shard without blocking. Return 0 if the shard is being polled by another thread. */
+static int SchdpollShardAcquireImpl(struct Schedule *schedule, struct NetpollShard *shard, void *buf[],
+                                    unsigned int bufLen)
+{
+    int eventsNum;
+    int maxEvents;
+    int bufIdx;
+    struct epoll_event events[SCHDPOLL_EVENT_NUM];
+
+    if (pthread_mutex_trylock(&shard->pollMutex) != 0) {
+        return 0;
+    }
+    if (schedule->state == SCHEDULE_SUSPENDING) {
+        pthread_mutex_unlock(&shard->pollMutex);
+        return 0;
+    }
+
+    maxEvents = InitEventsNum(bufLen);
+    shard->pending.store(false, std::memory_order_relaxed);
+    eventsNum = NetpollWait(shard->npfd, events, maxEvents, 0);
+    if (eventsNum <= 0) {
+        pthread_mutex_unlock(&shard->pollMutex);
+        return eventsNum;
+    }
+    // The shard epfd is edge triggered in the main netpoll, so a truncated acquire would not be
+    // notified again. Remember it and drain the rest in the next acquire of the main netpoll.
+    if (eventsNum == maxEvents) {
+        shard->pending.store(true, std::memory_order_relaxed);
+    }
+    bufIdx = SchdpollEventsProcess(events, eventsNum, buf, nullptr, nullptr);
+
+    if (shard->closingPd != nullptr) {
+        SchdpollFreeClosingPd(&shard->closingLock, &shard->closingPd);
+    }
+    pthread_mutex_unlock(&shard->pollMutex);
+    return bufIdx;
+}
+
+/* Drain the shards that were reported ready by the main netpoll or left pending. */
+static int SchdpollShardsDrain(struct Schedule *schedule, struct NetpollShard *readyShards[], unsigned int readyNum,
+                               void *buf[], unsigned int bufLen)
+{
+    int num;
+    unsigned int bufIdx = 0;
+    struct NetpollShard *shard;
+
+    for (unsigned int i = 0; i < readyNum; ++i) {
+        readyShards[i]->pending.store(true, std::memory_order_relaxed);
+    }
+    for (unsigned int i = 0; i < schedule->netpoll.shardNum; ++i) {
+        shard = &schedule->netpoll.shards[i];
+        if (!shard->pending.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        // At least one event must fit into the rest of buf.
+        if (bufLen - bufIdx < 2) {
+            break;
+        }
+        num = SchdpollShardAcquireImpl(schedule, shard, buf + bufIdx, bufLen - bufIdx);
+        if (num > 0) {
+            bufIdx += static_cast<unsigned int>(num);
+        }
+    }
+    return static_cast<int>(bufIdx);
+}
+
+int SchdpollAcquireShard(struct Schedule *schedule, unsigned int processorId, void *buf[], unsigned int bufLen)
+{
+    if (schedule->netpoll.shardNum == 0) {
+        return 0;
+    }
+    return SchdpollShardAcquireImpl(schedule, &schedule->netpoll.shards[processorId % schedule->netpoll.shardNum],
+                                    buf, bufLen);
+}
+
+/* Call netpoll to obtain the ready cjthread queue. */
+int SchdpollAcquire(struct Schedule *schedule, void *buf[], unsigned int bufLen, int timeout)
+{
+    int eventsNum;
+    int bufIdx;
+    struct epoll_event events[SCHDPOLL_EVENT_NUM];
+    struct NetpollShard *readyShards[SCHDPOLL_EVENT_NUM];
+    unsigned int readyNum = 0;
+
+    // Only one thread needs to perform netpoll_wait at a time. Because one thread can obtain
+    // all events, multiple threads do not need to be concurrent.
+    if (pthread_mutex_trylock(&schedule->netpoll.pollMutex) != 0) {
+        return 0;
+    }
+    if (schedule->state == SCHEDULE_SUSPENDING) {
+        pthread_mutex_unlock(&schedule->netpoll.pollMutex);
+        return 0;
+    }
+    
+    eventsNum = InitEventsNum(bufLen);
+    // Wait events
+    eventsNum = NetpollWait(schedule->netpoll.npfd, events, eventsNum, timeout);
+    if (eventsNum < 0) {
+        pthread_mutex_unlock(&schedule->netpoll.pollMutex);
+        return eventsNum;
+    }
+
+    bufIdx = SchdpollEventsProcess(events, eventsNum, buf, readyShards, &readyNum);
+    if (schedule->netpoll.shardNum != 0) {
+        bufIdx += SchdpollShardsDrain(schedule, readyShards, readyNum, buf + bufIdx,
+                                      bufLen - static_cast<unsigned int>(bufIdx));
+    }
 
     if (schedule->netpoll.closingPd != nullptr) {
-        SchdpollFreePd();
+        SchdpollFreeClosingPd(&schedule->netpoll.closingLock, &schedule->netpoll.closingPd);
     }
 
     pthread_mutex_unlock(&schedule->netpoll.pollMutex);
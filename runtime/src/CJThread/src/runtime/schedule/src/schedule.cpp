@@ -294,6 +294,16 @@ int ScheduleGfreelistInit(struct ScheduleCJThread *schdCJThread)
     return 0;
 }
 
+/* Destroy the locks of the first num global runq shards. */
+static void ScheduleRunqShardsDestroy(struct ScheduleCJThread *schdCJThread, unsigned int num)
+{
+    unsigned int i;
+
+    for (i = 0; i < num; ++i) {
+        pthread_mutex_destroy(&schdCJThread->runqShards[i].mutex);
+    }
+}
+
 /**
  * @ingroup schedule
  * @brief Initialize the cjthread control block.
@@ -305,25 +315,38 @@ int ScheduleGfreelistInit(struct ScheduleCJThread *schdCJThread)
 int ScheduleCJThreadInit(struct ScheduleCJThread *schdCJThread, const struct ScheduleAttrInner *attr)
 {
     int error;
+    unsigned int i;
 
     schdCJThread->cjthreadNum = 0;
     schdCJThread->stackProtect = attr->stackProtect;
     schdCJThread->stackGrow = attr->stackGrow;
     schdCJThread->stackSize = STACK_ADDR_ALIGN_UP(attr->costackSize, SchedulePageSize());
 
-    error = ScheduleRecursiveLockCreate(&schdCJThread->mutex);
-    if (error) {
-        LOG_ERROR(error, "mutex init failed");
-        return error;
+    // One global runq shard per processor, so that processors mostly hit their own shard lock.
+    schdCJThread->runqShardNum = attr->processorNum;
+    if (schdCJThread->runqShardNum > SCHEDULE_RUNQ_SHARD_MAX) {
+        schdCJThread->runqShardNum = SCHEDULE_RUNQ_SHARD_MAX;
+    }
+    if (schdCJThread->runqShardNum == 0) {
+        schdCJThread->runqShardNum = 1;
+    }
+    for (i = 0; i < schdCJThread->runqShardNum; ++i) {
+        error = ScheduleRecursiveLockCreate(&schdCJThread->runqShards[i].mutex);
+        if (error) {
+            LOG_ERROR(error, "mutex init failed");
+            ScheduleRunqShardsDestroy(schdCJThread, i);
+            return error;
+        }
+        schdCJThread->runqShards[i].num = 0;
+        DulinkInit(&schdCJThread->runqShards[i].runq);
     }
-
     schdCJThread->num = 0;
-    DulinkInit(&schdCJThread->runq);
+    schdCJThread->runqShardCursor = 0;
 
     error = ScheduleGfreelistInit(schdCJThread);
     if (error) {
         LOG_ERROR(error, "mutex init failed");
-        pthread_mutex_destroy(&(schdCJThread->mutex));
+        ScheduleRunqShardsDestroy(schdCJThread, schdCJThread->runqShardNum);
         return error;
     }
     return 0;
@@ -437,7 +460,7 @@ void ScheduleThread0Fini(struct Schedule *schedule)
 
 void ScheduleCJThreadFini(struct ScheduleCJThread *schdCJThread)
 {
-    pthread_mutex_destroy(&schdCJThread->mutex);
+    ScheduleRunqShardsDestroy(schdCJThread, schdCJThread->runqShardNum);
     pthread_mutex_destroy(&schdCJThread->gfreelist.gfreeLock);
 }
 
@@ -921,6 +944,11 @@ void ScheduleNetpollExit(struct Schedule *schedule)
     if (schedule->netpoll.npfd != nullptr) {
         NetpollExit(schedule->netpoll.npfd);
     }
+#ifdef MRT_LINUX
+    for (unsigned int i = 0; i < schedule->netpoll.shardNum; ++i) {
+        NetpollExit(schedule->netpoll.shards[i].npfd);
+    }
+#endif
 #if defined (MRT_LINUX) || defined (MRT_MACOS)
     SchdpollFreePd();
 #endif
@@ -1293,7 +1321,7 @@ void ScheduleClean(void)
 
 int ScheduleGlobalWrite(struct CJThread *cjthreadList[], unsigned int num)
 {
-    struct Dulink *globalQueue;
+    struct ScheduleRunqShard *shard;
     struct Schedule *schedule;
     unsigned long i;
 
@@ -1301,15 +1329,18 @@ int ScheduleGlobalWrite(struct CJThread *cjthreadList[], unsigned int num)
         return 0;
     }
 
+    // The caller may not run on a processor of this schedule, spread the writes over shards.
     schedule = cjthreadList[0]->schedule;
-    globalQueue = &schedule->schdCJThread.runq;
+    shard = ScheduleRunqShardGet(&schedule->schdCJThread,
+                                 schedule->schdCJThread.runqShardCursor.fetch_add(1, std::memory_order_relaxed));
 
-    pthread_mutex_lock(&schedule->schdCJThread.mutex);
+    pthread_mutex_lock(&shard->mutex);
     for (i = 0; i < num; i++) {
-        DulinkPushtail(globalQueue, cjthreadList[i]);
+        DulinkPushtail(&shard->runq, cjthreadList[i]);
     }
+    shard->num += num;
     schedule->schdCJThread.num += num;
-    pthread_mutex_unlock(&schedule->schdCJThread.mutex);
+    pthread_mutex_unlock(&shard->mutex);
 
     return 0;
 }
@@ -1758,6 +1789,11 @@ void ScheduleLockAll(void)
         }
         pthread_mutex_lock(&schedule->schdCJThread.gfreelist.gfreeLock);
         pthread_mutex_lock(&schedule->netpoll.pollMutex);
+#ifdef MRT_LINUX
+        for (i = 0; i < schedule->netpoll.shardNum; ++i) {
+            pthread_mutex_lock(&schedule->netpoll.shards[i].pollMutex);
+        }
+#endif
     }
 }
 
@@ -1770,6 +1806,11 @@ void ScheduleUnlockAll(void)
 
     DULINK_FOR_EACH_ITEM(scheduleNode, &g_scheduleManager.allScheduleList) {
         schedule = DULINK_ENTRY(scheduleNode, struct Schedule, allScheduleDulink);
+#ifdef MRT_LINUX
+        for (i = 0; i < schedule->netpoll.shardNum; ++i) {
+            pthread_mutex_unlock(&schedule->netpoll.shards[i].pollMutex);
+        }
+#endif
         pthread_mutex_unlock(&schedule->netpoll.pollMutex);
         pthread_mutex_unlock(&schedule->schdCJThread.gfreelist.gfreeLock);
         for (i = 0; i < schedule->schdProcessor.processorNum; ++i) {
@@ -11,6 +11,7 @@
 #include <atomic>
 #include <pthread.h>
 #include "timer.h"
+#include "list.h"
 
 #ifdef __cplusplus
 #if __cplusplus
@@ -48,6 +49,8 @@ struct TimerNode {
     void *args;                        /* Timer callback function parameter */
     std::atomic<TimerStatus> status;   /* Timer status */
     bool autoReleasing;                /* True indicates that the timer is automatically released after execution */
+    struct Dulink wheelLink;           /* Link in the timing wheel slot, used only by the timing wheel backend */
+    unsigned int wheelSlot;            /* Slot of the timing wheel where the timer is linked */
 };
 
 /**
@@ -66,6 +69,30 @@ struct TimerHeap {
     unsigned long long int capacity;        /* heap capacity */
 };
 
+#define TIMER_WHEEL_LEVELS (4)
+#define TIMER_WHEEL_SLOT_BITS (6)
+#define TIMER_WHEEL_SLOTS (1U << TIMER_WHEEL_SLOT_BITS)
+/* Wheel slot of timers linked in the overflow list or the expired list */
+#define TIMER_WHEEL_SLOT_NONE (TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS)
+
+/**
+ * @brief Hierarchical timing wheel, the alternative backend of TimerHeap enabled by cjTimerWheel=1.
+ * Level l has 64 slots of 64^l ticks each. Timers are linked to their slot, so that adding and
+ * stopping a timer are O(1) and stopped timers are unlinked immediately. Slots of higher levels
+ * are cascaded to lower levels when the wheel turns to them.
+ **/
+struct TimerWheel {
+    pthread_mutex_t mutex;                                      /* Lock for timing wheel */
+    unsigned long long curTick;                                 /* Timers up to this tick have expired */
+    std::atomic<unsigned long long> nextDeadline;               /* Lower bound of the next expiration,
+                                                                 * 0 means there is no timer. */
+    std::atomic<unsigned long long> numTimers;                  /* Timer number */
+    unsigned long long bitmap[TIMER_WHEEL_LEVELS];              /* Non-empty slots of each level */
+    struct Dulink slots[TIMER_WHEEL_LEVELS][TIMER_WHEEL_SLOTS]; /* Timers of each slot */
+    struct Dulink overflow;                                     /* Timers beyond the highest level */
+    struct Dulink expired;                                      /* Expired timers waiting to run */
+};
+
 /**
  * @brief Structure for batch migration
  **/
@@ -135,6 +162,42 @@ bool TimerCheckExistence(void *processor);
  **/
 int TimerTryStop(TimerHandle handle);
 
+/**
+ * @brief Check whether the timing wheel backend is enabled by cjTimerWheel. The value is read once.
+ * @retval If the timing wheel is used, true is returned. Otherwise, false is returned.
+ **/
+bool TimerWheelEnabled(void);
+
+/**
+ * @brief Add a new timer to the timing wheel of the current processor and register the wheel hooks.
+ * @param timer    [IN] Timer initialized by TimerInit
+ * @retval If the operation is successful, 0 is returned. If the operation fails, an error code is returned.
+ **/
+int TimerWheelAddNew(struct TimerNode *timer);
+
+/**
+ * @brief Timing wheel implementation of TimerStop, TimerTryStop, TimerReset and TimerRelease.
+ **/
+int TimerWheelStop(struct TimerNode *timer);
+int TimerWheelTryStop(struct TimerNode *timer);
+int TimerWheelReset(struct TimerNode *timer, unsigned long long ddl, unsigned long long period,
+                    TimerFunc fun, void *args);
+int TimerWheelRelease(struct TimerNode *timer);
+
+/**
+ * @brief Create and initialize a timer node that is not added to any processor.
+ * @retval Pointer to the timer node. If the allocation fails, nullptr is returned.
+ **/
+struct TimerNode *TimerInit(unsigned long long dur, unsigned long long period, TimerFunc func, void *args);
+
+/**
+ * @brief Return now + dur, or the maximum value if the sum overflows.
+ **/
+unsigned long long TimerDeadlineCheck(unsigned long long now, unsigned long long dur);
+
+/* Number of existing timers, shared by the heap and the timing wheel. */
+extern std::atomic<int> g_timerNum;
+
 /**
  * @brief Hook provided for the schedule module to obtain the number of timers.
  * @retval Returns the current number of timers.
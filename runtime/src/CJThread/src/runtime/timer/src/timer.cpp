@@ -36,7 +36,7 @@ MRT_STATIC_INLINE void OsYield(void)
 #endif
 }
 
-static std::atomic<int> g_timerNum(0);
+std::atomic<int> g_timerNum(0);
 
 /* Check whether data overflows based on the input. */
 unsigned long long TimerDeadlineCheck(unsigned long long now, unsigned long long dur)
@@ -350,6 +350,9 @@ int TimerStop(TimerHandle handle)
     int res;
 
     timer = (struct TimerNode *)handle;
+    if (TimerWheelEnabled()) {
+        return TimerWheelStop(timer);
+    }
     res = TimerGetHeap(timer, &heap);
     if (res != 0) {
         return res;
@@ -449,6 +452,9 @@ int TimerReset(TimerHandle handle, unsigned long long ddl,
     bool wasRemoved = false;
 
     timer = (struct TimerNode *)handle;
+    if (TimerWheelEnabled()) {
+        return TimerWheelReset(timer, ddl, period, fun, args);
+    }
     res = TimerGetHeap(timer, &heap);
     if (res != 0) {
         return res;
@@ -932,6 +938,15 @@ TimerHandle TimerNew(unsigned long long dur, unsigned long long period, TimerFun
         return nullptr;
     }
 
+    if (TimerWheelEnabled()) {
+        if (TimerWheelAddNew(timer) != 0) {
+            --g_timerNum;
+            MapleRuntime::NativeAllocator::NativeFree(timer, sizeof(struct TimerNode));
+            return nullptr;
+        }
+        return (TimerHandle)timer;
+    }
+
     // Check whether the check_timer function hook of the scheduling framework is initialized for multiple times.
     error = SchdProcessorHookRegister(TimerTrigger, PROCESSOR_TIMER_HOOK);
     if (error == 0) {
@@ -1001,6 +1016,9 @@ int TimerTryStop(TimerHandle handle)
     int res;
 
     timer = (struct TimerNode *)handle;
+    if (TimerWheelEnabled()) {
+        return TimerWheelTryStop(timer);
+    }
     res = TimerGetHeap(timer, &heap);
     if (res != 0) {
         return res;
@@ -1112,6 +1130,9 @@ int TimerRelease(TimerHandle handle)
     int res;
 
     timer = (struct TimerNode *)handle;
+    if (TimerWheelEnabled()) {
+        return TimerWheelRelease(timer);
+    }
     res = TimerGetHeap(timer, &heap);
     if (res != 0) {
         return res;
@@ -0,0 +1,577 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+
+#include <climits>
+#include <cstdlib>
+#include "schedule_impl.h"
+#include "cjthread.h"
+#include "timer_impl.h"
+#include "basetime.h"
+#include "log.h"
+#include "Common/NativeAllocator.h"
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* A tick is 2^20 ns (about 1ms). A timer expires at the first tick that is not earlier than its deadline. */
+const unsigned int TIMER_WHEEL_TICK_SHIFT = 20;
+const unsigned long long TIMER_WHEEL_SLOT_MASK = TIMER_WHEEL_SLOTS - 1;
+const unsigned long long TIMER_WHEEL_TICK_MAX = 1ULL << (64 - TIMER_WHEEL_TICK_SHIFT);
+
+MRT_STATIC_INLINE void TimerWheelYield(void)
+{
+#ifdef __linux__
+    syscall(SYS_sched_yield);
+#endif
+}
+
+bool TimerWheelEnabled(void)
+{
+    static bool enabled = []() {
+        const char *env = std::getenv("cjTimerWheel");
+        return env != nullptr && strtoul(env, nullptr, 0) != 0;
+    }();
+    return enabled;
+}
+
+MRT_STATIC_INLINE unsigned long long TimerWheelTickOf(unsigned long long deadline)
+{
+    unsigned long long tick = deadline >> TIMER_WHEEL_TICK_SHIFT;
+    if ((deadline & ((1ULL << TIMER_WHEEL_TICK_SHIFT) - 1)) != 0) {
+        ++tick;
+    }
+    return tick;
+}
+
+/*
+ * Link the timer to the slot of its expiration tick, but not before minTick. The caller must lock the wheel.
+ * Timers cascaded during a turn use the current tick, so those due now are collected by the same turn.
+ */
+static void TimerWheelLink(struct TimerWheel *wheel, struct TimerNode *timer, unsigned long long minTick)
+{
+    unsigned long long tick = TimerWheelTickOf(timer->deadline);
+    unsigned int level;
+    unsigned int slot;
+    unsigned int shift;
+
+    if (tick < minTick) {
+        tick = minTick;
+    }
+    // Level l holds the timers that expire in the current round of level l + 1.
+    for (level = 0; level < TIMER_WHEEL_LEVELS; ++level) {
+        shift = TIMER_WHEEL_SLOT_BITS * (level + 1);
+        if ((tick >> shift) == (wheel->curTick >> shift)) {
+            slot = static_cast<unsigned int>((tick >> (TIMER_WHEEL_SLOT_BITS * level)) & TIMER_WHEEL_SLOT_MASK);
+            DulinkPushtail(&wheel->slots[level][slot], &timer->wheelLink);
+            wheel->bitmap[level] |= 1ULL << slot;
+            timer->wheelSlot = level * TIMER_WHEEL_SLOTS + slot;
+            return;
+        }
+    }
+    DulinkPushtail(&wheel->overflow, &timer->wheelLink);
+    timer->wheelSlot = TIMER_WHEEL_SLOT_NONE;
+}
+
+/* Unlink the timer from the wheel. The caller must lock the wheel. */
+static void TimerWheelUnlink(struct TimerWheel *wheel, struct TimerNode *timer)
+{
+    unsigned int level;
+    unsigned int slot;
+
+    DulinkRemove(&timer->wheelLink);
+    if (timer->wheelSlot == TIMER_WHEEL_SLOT_NONE) {
+        return;
+    }
+    level = timer->wheelSlot / TIMER_WHEEL_SLOTS;
+    slot = timer->wheelSlot % TIMER_WHEEL_SLOTS;
+    if (DulinkIsEmpty(&wheel->slots[level][slot])) {
+        wheel->bitmap[level] &= ~(1ULL << slot);
+    }
+}
+
+/*
+ * Get the first tick after curTick at which a timer expires or a non-empty slot is cascaded.
+ * Timers of a lower level always expire before those of a higher level, so the lowest
+ * non-empty level decides. Return false if the wheel is empty.
+ */
+static bool TimerWheelNextTick(struct TimerWheel *wheel, unsigned long long *tick)
+{
+    unsigned int level;
+    unsigned int shift;
+    unsigned long long pos;
+    unsigned long long pending;
+
+    for (level = 0; level < TIMER_WHEEL_LEVELS; ++level) {
+        shift = TIMER_WHEEL_SLOT_BITS * level;
+        pos = (wheel->curTick >> shift) & TIMER_WHEEL_SLOT_MASK;
+        pending = (pos == TIMER_WHEEL_SLOT_MASK) ? 0 : (wheel->bitmap[level] & (~0ULL << (pos + 1)));
+        if (pending != 0) {
+            *tick = ((wheel->curTick >> (shift + TIMER_WHEEL_SLOT_BITS)) << (shift + TIMER_WHEEL_SLOT_BITS)) +
+                (static_cast<unsigned long long>(__builtin_ctzll(pending)) << shift);
+            return true;
+        }
+    }
+    if (!DulinkIsEmpty(&wheel->overflow)) {
+        shift = TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVELS;
+        *tick = ((wheel->curTick >> shift) + 1) << shift;
+        return true;
+    }
+    return false;
+}
+
+/* Update the deadline checked by schmon and the scheduler. The caller must lock the wheel. */
+static void TimerWheelUpdateNextDeadline(struct TimerWheel *wheel)
+{
+    unsigned long long tick;
+
+    if (!DulinkIsEmpty(&wheel->expired)) {
+        tick = wheel->curTick;
+    } else if (!TimerWheelNextTick(wheel, &tick)) {
+        wheel->nextDeadline = 0;
+        return;
+    }
+    wheel->nextDeadline = tick >= TIMER_WHEEL_TICK_MAX ? ULLONG_MAX : (tick << TIMER_WHEEL_TICK_SHIFT);
+}
+
+/* Re-link all timers of the list according to the current tick. */
+static void TimerWheelCascade(struct TimerWheel *wheel, struct Dulink *list)
+{
+    struct Dulink moved;
+    struct Dulink *node;
+
+    if (DulinkIsEmpty(list)) {
+        return;
+    }
+    DulinkInit(&moved);
+    DulinkMove(&moved, list, 0);
+    while (!DulinkIsEmpty(&moved)) {
+        node = moved.next;
+        DulinkRemove(node);
+        TimerWheelLink(wheel, DULINK_ENTRY(node, struct TimerNode, wheelLink), wheel->curTick);
+    }
+}
+
+/* Turn the wheel to tick, cascade the slots that start at tick and collect expired timers. */
+static void TimerWheelTurn(struct TimerWheel *wheel, unsigned long long tick)
+{
+    unsigned int level;
+    unsigned int slot;
+    struct Dulink *head;
+    struct Dulink *node;
+
+    wheel->curTick = tick;
+    // Cascade from the highest level, so that timers moved down are cascaded again by lower levels.
+    for (level = TIMER_WHEEL_LEVELS; level > 0; --level) {
+        if ((tick & ((1ULL << (TIMER_WHEEL_SLOT_BITS * level)) - 1)) != 0) {
+            continue;
+        }
+        if (level == TIMER_WHEEL_LEVELS) {
+            TimerWheelCascade(wheel, &wheel->overflow);
+            continue;
+        }
+        slot = static_cast<unsigned int>((tick >> (TIMER_WHEEL_SLOT_BITS * level)) & TIMER_WHEEL_SLOT_MASK);
+        wheel->bitmap[level] &= ~(1ULL << slot);
+        TimerWheelCascade(wheel, &wheel->slots[level][slot]);
+    }
+
+    slot = static_cast<unsigned int>(tick & TIMER_WHEEL_SLOT_MASK);
+    head = &wheel->slots[0][slot];
+    if (DulinkIsEmpty(head)) {
+        return;
+    }
+    wheel->bitmap[0] &= ~(1ULL << slot);
+    DULINK_FOR_EACH_ITEM(node, head) {
+        DULINK_ENTRY(node, struct TimerNode, wheelLink)->wheelSlot = TIMER_WHEEL_SLOT_NONE;
+    }
+    DulinkMove(&wheel->expired, head, 0);
+}
+
+/* Turn the wheel to nowTick, skipping ticks at which nothing happens. */
+static void TimerWheelAdvance(struct TimerWheel *wheel, unsigned long long nowTick)
+{
+    unsigned long long next;
+
+    while (wheel->curTick < nowTick) {
+        if (!TimerWheelNextTick(wheel, &next) || next > nowTick) {
+            wheel->curTick = nowTick;
+            return;
+        }
+        TimerWheelTurn(wheel, next);
+    }
+}
+
+static struct TimerWheel *TimerWheelInit(void)
+{
+    struct TimerWheel *wheel;
+    unsigned int level;
+    unsigned int slot;
+    int error;
+
+    wheel = static_cast<struct TimerWheel *>(MapleRuntime::NativeAllocator::NativeAlloc(sizeof(struct TimerWheel)));
+    if (wheel == nullptr) {
+        LOG_ERROR(ERROR_TIMER_ALLOC, "timer wheel NativeAlloc failed");
+        return nullptr;
+    }
+    error = pthread_mutex_init(&wheel->mutex, nullptr);
+    if (error) {
+        LOG_ERROR(error, "mutex init failed");
+        MapleRuntime::NativeAllocator::NativeFree(wheel, sizeof(struct TimerWheel));
+        return nullptr;
+    }
+    wheel->curTick = CurrentNanotimeGet() >> TIMER_WHEEL_TICK_SHIFT;
+    wheel->nextDeadline = 0;
+    wheel->numTimers = 0;
+    for (level = 0; level < TIMER_WHEEL_LEVELS; ++level) {
+        wheel->bitmap[level] = 0;
+        for (slot = 0; slot < TIMER_WHEEL_SLOTS; ++slot) {
+            DulinkInit(&wheel->slots[level][slot]);
+        }
+    }
+    DulinkInit(&wheel->overflow);
+    DulinkInit(&wheel->expired);
+    return wheel;
+}
+
+/* Obtain the wheel through the timer. */
+static int TimerWheelGet(struct TimerNode *timer, struct TimerWheel **wheel)
+{
+    if (timer == nullptr) {
+        LOG_ERROR(ERROR_TIMER_HANDLE_INVALID, "illegal timer handle");
+        *wheel = nullptr;
+        return ERROR_TIMER_HANDLE_INVALID;
+    }
+    *wheel = static_cast<struct TimerWheel *>(
+        ProcessorGetspecific(static_cast<const struct Processor *>(timer->pPtr), KEY_TIMER));
+    if (*wheel == nullptr) {
+        LOG_ERROR(ERROR_TIMER_PPTR, "ProcessorGetspecific wheel is null");
+        return ERROR_TIMER_PPTR;
+    }
+    return 0;
+}
+
+/* Remove a waiting timer from the wheel. The caller must lock the wheel. */
+static void TimerWheelRemove(struct TimerWheel *wheel, struct TimerNode *timer)
+{
+    TimerWheelUnlink(wheel, timer);
+    --wheel->numTimers;
+    if (timer->autoReleasing) {
+        MapleRuntime::NativeAllocator::NativeFree(timer, sizeof(struct TimerNode));
+        --g_timerNum;
+    } else {
+        atomic_store(&timer->status, TIMER_REMOVED);
+    }
+    TimerWheelUpdateNextDeadline(wheel);
+}
+
+/* Lock the wheel and wait until the timer is not running. */
+static void TimerWheelLockNotRunning(struct TimerWheel *wheel, struct TimerNode *timer)
+{
+    pthread_mutex_lock(&wheel->mutex);
+    while (atomic_load(&timer->status) == TIMER_RUNNING) {
+        pthread_mutex_unlock(&wheel->mutex);
+        TimerWheelYield();
+        pthread_mutex_lock(&wheel->mutex);
+    }
+}
+
+/* Run an expired timer. The caller must lock the wheel, which is unlocked during the callback. */
+static void TimerWheelRun(struct TimerWheel *wheel, struct TimerNode *timer, unsigned long long now)
+{
+    unsigned long long delta;
+    unsigned long long dur;
+
+    if (timer->period > 0) {
+        delta = now > timer->deadline ? now - timer->deadline : 0;
+        dur = timer->period * (1 + delta / timer->period);
+        timer->deadline = TimerDeadlineCheck(timer->deadline, dur);
+        TimerWheelLink(wheel, timer, wheel->curTick + 1);
+        atomic_store(&timer->status, TIMER_WAITING);
+        pthread_mutex_unlock(&wheel->mutex);
+        timer->func(timer->args);
+        pthread_mutex_lock(&wheel->mutex);
+        return;
+    }
+    atomic_store(&timer->status, TIMER_RUNNING);
+    --wheel->numTimers;
+    pthread_mutex_unlock(&wheel->mutex);
+    timer->func(timer->args);
+    pthread_mutex_lock(&wheel->mutex);
+    if (timer->autoReleasing) {
+        MapleRuntime::NativeAllocator::NativeFree(timer, sizeof(struct TimerNode));
+        --g_timerNum;
+    } else {
+        atomic_store(&timer->status, TIMER_IDLE);
+    }
+}
+
+/* Timing wheel version of TimerTrigger, registered as PROCESSOR_TIMER_HOOK. */
+static int TimerWheelTrigger(struct Processor *processor, unsigned long long *now, bool *run)
+{
+    struct TimerWheel *wheel;
+    struct TimerNode *timer;
+    struct Dulink *node;
+    unsigned long long nextDeadline;
+    unsigned long long rnow;
+
+    if (processor == nullptr) {
+        return ERROR_TIMER_PTR_INVALID;
+    }
+    if (run != nullptr) {
+        *run = false;
+    }
+    wheel = static_cast<struct TimerWheel *>(ProcessorGetspecific(processor, KEY_TIMER));
+    if (wheel == nullptr || wheel->numTimers == 0) {
+        if (now != nullptr) {
+            *now = 0;
+        }
+        return 0;
+    }
+    nextDeadline = wheel->nextDeadline;
+    if (nextDeadline == 0) {
+        return 0;
+    }
+    if (now == nullptr || *now == 0) {
+        rnow = CurrentNanotimeGet();
+        if (now != nullptr) {
+            *now = rnow;
+        }
+    } else {
+        rnow = *now;
+    }
+    if (rnow < nextDeadline) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&wheel->mutex);
+    TimerWheelAdvance(wheel, rnow >> TIMER_WHEEL_TICK_SHIFT);
+    // Stop and reset unlink timers from the expired list as well, so pop one at a time under the lock.
+    while (!DulinkIsEmpty(&wheel->expired)) {
+        node = wheel->expired.next;
+        DulinkRemove(node);
+        timer = DULINK_ENTRY(node, struct TimerNode, wheelLink);
+        TimerWheelRun(wheel, timer, rnow);
+        if (run != nullptr) {
+            *run = true;
+        }
+    }
+    TimerWheelUpdateNextDeadline(wheel);
+    pthread_mutex_unlock(&wheel->mutex);
+    return 0;
+}
+
+/* Timing wheel version of TimerSchmonCheck, wake a processor to run expired timers. */
+static int TimerWheelSchmonCheck(void *pro, unsigned long long now)
+{
+    struct TimerWheel *wheel;
+    struct Processor *processor = static_cast<struct Processor *>(pro);
+    unsigned long long nextDeadline;
+
+    wheel = static_cast<struct TimerWheel *>(ProcessorGetspecific(processor, KEY_TIMER));
+    if (wheel == nullptr) {
+        return 0;
+    }
+    struct Schedule* schedule = reinterpret_cast<struct Schedule*>(processor->schedule);
+    struct Schedule* wakeSchedule = schedule == nullptr ? ScheduleGet() : schedule;
+    nextDeadline = wheel->nextDeadline;
+    if (nextDeadline != 0 && now >= nextDeadline) {
+        if (processor->state == PROCESSOR_RUNNING) {
+            ProcessorWake(wakeSchedule, nullptr);
+        } else if (processor->state == PROCESSOR_IDLE) {
+            ProcessorWake(wakeSchedule, processor);
+        }
+    }
+    return 0;
+}
+
+static bool TimerWheelCheckReady(struct Processor *processor)
+{
+    struct TimerWheel *wheel;
+    unsigned long long nextDeadline;
+
+    wheel = static_cast<struct TimerWheel *>(ProcessorGetspecific(processor, KEY_TIMER));
+    if (wheel == nullptr) {
+        return false;
+    }
+    nextDeadline = wheel->nextDeadline;
+    return nextDeadline != 0 && CurrentNanotimeGet() >= nextDeadline;
+}
+
+static bool TimerWheelCheckExistence(void *processor)
+{
+    struct TimerWheel *wheel;
+
+    wheel = static_cast<struct TimerWheel *>(
+        ProcessorGetspecific(static_cast<const struct Processor *>(processor), KEY_TIMER));
+    return wheel != nullptr && wheel->numTimers != 0;
+}
+
+static void TimerWheelFreeList(struct Dulink *list)
+{
+    struct Dulink *node;
+
+    while (!DulinkIsEmpty(list)) {
+        node = list->next;
+        DulinkRemove(node);
+        MapleRuntime::NativeAllocator::NativeFree(DULINK_ENTRY(node, struct TimerNode, wheelLink),
+                                                  sizeof(struct TimerNode));
+        --g_timerNum;
+    }
+}
+
+static int TimerWheelExit(void *processor)
+{
+    struct TimerWheel *wheel;
+    unsigned int level;
+    unsigned int slot;
+
+    wheel = static_cast<struct TimerWheel *>(
+        ProcessorGetspecific(static_cast<const struct Processor *>(processor), KEY_TIMER));
+    if (wheel == nullptr) {
+        return 0;
+    }
+    pthread_mutex_lock(&wheel->mutex);
+    for (level = 0; level < TIMER_WHEEL_LEVELS; ++level) {
+        for (slot = 0; slot < TIMER_WHEEL_SLOTS; ++slot) {
+            TimerWheelFreeList(&wheel->slots[level][slot]);
+        }
+        wheel->bitmap[level] = 0;
+    }
+    TimerWheelFreeList(&wheel->overflow);
+    TimerWheelFreeList(&wheel->expired);
+    wheel->numTimers = 0;
+    pthread_mutex_unlock(&wheel->mutex);
+    pthread_mutex_destroy(&wheel->mutex);
+    MapleRuntime::NativeAllocator::NativeFree(wheel, sizeof(struct TimerWheel));
+    return 0;
+}
+
+int TimerWheelAddNew(struct TimerNode *timer)
+{
+    struct TimerWheel *wheel;
+    struct Processor *processor = ProcessorGet();
+
+    if (SchdProcessorHookRegister(TimerWheelTrigger, PROCESSOR_TIMER_HOOK) == 0) {
+        SchdSchmonHookRegister(TimerWheelSchmonCheck, SCHMON_TIMER_HOOK);
+        SchdCheckExistenceHookRegister(TimerWheelCheckExistence);
+        SchdCheckReadyHookRegister(TimerWheelCheckReady);
+        SchdExitHookRegister(TimerWheelExit, KEY_TIMER);
+    }
+
+    wheel = static_cast<struct TimerWheel *>(ProcessorGetspecific(processor, KEY_TIMER));
+    if (wheel == nullptr) {
+        wheel = TimerWheelInit();
+        if (wheel == nullptr) {
+            return ERROR_TIMER_ALLOC;
+        }
+        ProcessorSetspecific(processor, KEY_TIMER, wheel);
+    }
+    timer->pPtr = processor;
+    pthread_mutex_lock(&wheel->mutex);
+    TimerWheelLink(wheel, timer, wheel->curTick + 1);
+    ++wheel->numTimers;
+    TimerWheelUpdateNextDeadline(wheel);
+    pthread_mutex_unlock(&wheel->mutex);
+    return 0;
+}
+
+int TimerWheelStop(struct TimerNode *timer)
+{
+    struct TimerWheel *wheel;
+    int res;
+
+    res = TimerWheelGet(timer, &wheel);
+    if (res != 0) {
+        return res;
+    }
+    TimerWheelLockNotRunning(wheel, timer);
+    if (atomic_load(&timer->status) != TIMER_WAITING) {
+        pthread_mutex_unlock(&wheel->mutex);
+        return ERROR_TIMER_STOP_FAILED;
+    }
+    TimerWheelRemove(wheel, timer);
+    pthread_mutex_unlock(&wheel->mutex);
+    return 0;
+}
+
+int TimerWheelTryStop(struct TimerNode *timer)
+{
+    struct TimerWheel *wheel;
+    int res;
+
+    res = TimerWheelGet(timer, &wheel);
+    if (res != 0) {
+        return res;
+    }
+    pthread_mutex_lock(&wheel->mutex);
+    if (atomic_load(&timer->status) != TIMER_WAITING) {
+        pthread_mutex_unlock(&wheel->mutex);
+        return ERROR_TIMER_IS_NOT_WAITING;
+    }
+    TimerWheelRemove(wheel, timer);
+    pthread_mutex_unlock(&wheel->mutex);
+    return 0;
+}
+
+int TimerWheelReset(struct TimerNode *timer, unsigned long long ddl, unsigned long long period,
+                    TimerFunc fun, void *args)
+{
+    struct TimerWheel *wheel;
+    int res;
+
+    res = TimerWheelGet(timer, &wheel);
+    if (res != 0) {
+        return res;
+    }
+    TimerWheelLockNotRunning(wheel, timer);
+    if (atomic_load(&timer->status) != TIMER_WAITING) {
+        pthread_mutex_unlock(&wheel->mutex);
+        return ERROR_TIMER_FREE;
+    }
+    TimerWheelUnlink(wheel, timer);
+    timer->deadline = TimerDeadlineCheck(CurrentNanotimeGet(), ddl);
+    timer->period = period;
+    if (fun != nullptr) {
+        timer->func = fun;
+        timer->args = args;
+    }
+    TimerWheelLink(wheel, timer, wheel->curTick + 1);
+    TimerWheelUpdateNextDeadline(wheel);
+    pthread_mutex_unlock(&wheel->mutex);
+    return 0;
+}
+
+int TimerWheelRelease(struct TimerNode *timer)
+{
+    struct TimerWheel *wheel;
+    TimerStatus curStatus;
+    int res;
+
+    res = TimerWheelGet(timer, &wheel);
+    if (res != 0) {
+        return res;
+    }
+    pthread_mutex_lock(&wheel->mutex);
+    curStatus = atomic_load(&timer->status);
+    if (curStatus == TIMER_REMOVED || curStatus == TIMER_IDLE) {
+        MapleRuntime::NativeAllocator::NativeFree(timer, sizeof(struct TimerNode));
+        --g_timerNum;
+    } else {
+        timer->autoReleasing = true;
+    }
+    pthread_mutex_unlock(&wheel->mutex);
+    return 0;
+}
+
+#ifdef __cplusplus
+}
+#endif
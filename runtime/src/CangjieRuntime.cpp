@@ -67,7 +67,7 @@ void DumpAllStackTrace0()
     LOG(RTLOG_INFO, "---------------------------Dump all cjthread stack trace--------------------------- \n");
     MutatorManager::Instance().VisitAllMutators([&](Mutator& mutator) {
         // don't print finalizerProcessorThread
-        if (mutator.GetTid() != Heap::GetHeap().GetFinalizerProcessor().GetTid()) {
+        if (!Heap::GetHeap().GetFinalizerProcessor().IsFinalizerThread(mutator.GetTid())) {
             LOG(RTLOG_INFO, "cjthread thread:%d mutator:%p :\n", mutator.GetCJThreadId(), &mutator);
             StackManager::PrintStackTrace(&(mutator.GetUnwindContext()));
             LOG(RTLOG_INFO, "\n");
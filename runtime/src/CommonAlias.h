@@ -45,6 +45,13 @@ extern "C" MRT_EXPORT size_t CJ_MCC_GetNativeThreadNumber() __attribute__((alias
 extern "C" MRT_EXPORT size_t CJ_MCC_GetGCCount() __attribute__((alias("MCC_GetGCCount")));
 extern "C" MRT_EXPORT uint64_t CJ_MCC_GetGCTimeUs() __attribute__((alias("MCC_GetGCTimeUs")));
 extern "C" MRT_EXPORT size_t CJ_MCC_GetGCFreedSize() __attribute__((alias("MCC_GetGCFreedSize")));
+extern "C" MRT_EXPORT void CJ_MCC_RegisterNativeAllocation(int32_t subsystem, size_t size)
+    __attribute__((alias("MCC_RegisterNativeAllocation")));
+extern "C" MRT_EXPORT void CJ_MCC_RegisterNativeFree(int32_t subsystem, size_t size)
+    __attribute__((alias("MCC_RegisterNativeFree")));
+extern "C" MRT_EXPORT size_t CJ_MCC_GetNativeAllocatedSize() __attribute__((alias("MCC_GetNativeAllocatedSize")));
+extern "C" MRT_EXPORT size_t CJ_MCC_GetNativeAllocatedSizeOf(int32_t subsystem)
+    __attribute__((alias("MCC_GetNativeAllocatedSizeOf")));
 extern "C" MRT_EXPORT size_t CJ_MCC_StartCpuProfiling() __attribute__((alias("MCC_StartCpuProfiling")));
 extern "C" MRT_EXPORT size_t CJ_MCC_StopCpuProfiling(int fd) __attribute__((alias("MCC_StopCpuProfiling")));
 extern "C" MRT_EXPORT void CJ_MCC_SetGCThreshold(uint64_t GCThreshold) __attribute__((alias("MCC_SetGCThreshold")));
@@ -254,6 +254,28 @@ extern "C" uint64_t MCC_GetGCTimeUs() { return g_gcTotalTimeUs; }
 
 extern "C" size_t MCC_GetGCFreedSize() { return g_gcCollectedTotalBytes; }
 
+extern "C" void MCC_RegisterNativeAllocation(int32_t subsystem, size_t size)
+{
+    Heap::GetHeap().GetCollectorResources().RegisterNativeAllocation(NativeAllocationRegistry::ToSubsystem(subsystem),
+                                                                     size);
+}
+
+extern "C" void MCC_RegisterNativeFree(int32_t subsystem, size_t size)
+{
+    Heap::GetHeap().GetCollectorResources().RegisterNativeFree(NativeAllocationRegistry::ToSubsystem(subsystem), size);
+}
+
+extern "C" size_t MCC_GetNativeAllocatedSize()
+{
+    return Heap::GetHeap().GetCollectorResources().GetNativeAllocationRegistry().GetNativeBytes();
+}
+
+extern "C" size_t MCC_GetNativeAllocatedSizeOf(int32_t subsystem)
+{
+    return Heap::GetHeap().GetCollectorResources().GetNativeAllocationRegistry().GetNativeBytes(
+        NativeAllocationRegistry::ToSubsystem(subsystem));
+}
+
 extern "C" bool MCC_StartCpuProfiling()
 {
     return CpuProfiler::GetInstance().StartCpuProfilerForFile();
@@ -333,7 +355,12 @@ extern "C" ArrayRef MCC_FillInStackTraceImpl(const TypeInfo* arrayInfo, const Ar
     }
     std::vector<uint64_t>& liteFrameInfos = eWrapper.GetLiteFrameInfos();
     liteFrameInfos.clear();
-    StackManager::RecordLiteFrameInfos(liteFrameInfos);
+    // Stack overflow traces need the whole stack to fold it, so they never take the lazy path.
+    if (StackManager::IsLazyStackTraceEnabled() && !eWrapper.IsThrowingSOFE()) {
+        StackManager::RecordLazyFrameInfos(liteFrameInfos);
+    } else {
+        StackManager::RecordLiteFrameInfos(liteFrameInfos);
+    }
     constexpr int frameInfoPairLen = 3; // function PC and startpc form one pair in liteFrameInfos
     if (eWrapper.IsThrowingSOFE()) {
         constexpr int defaultSize = 32;
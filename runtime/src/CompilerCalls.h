@@ -64,6 +64,12 @@ extern "C" size_t MCC_GetGCCount();
 extern "C" uint64_t MCC_GetGCTimeUs();
 extern "C" size_t MCC_GetGCFreedSize();
 
+// native memory held by heap objects, subsystem is a NativeSubsystem value.
+extern "C" void MCC_RegisterNativeAllocation(int32_t subsystem, size_t size);
+extern "C" void MCC_RegisterNativeFree(int32_t subsystem, size_t size);
+extern "C" size_t MCC_GetNativeAllocatedSize();
+extern "C" size_t MCC_GetNativeAllocatedSizeOf(int32_t subsystem);
+
 extern "C" bool MCC_StartCpuProfiling();
 extern "C" bool MCC_StopCpuProfiling(int fd);
 // for general array allocation
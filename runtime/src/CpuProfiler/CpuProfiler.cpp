@@ -7,6 +7,7 @@
 
 #include "CpuProfiler.h"
 #include "Mutator/MutatorManager.h"
+#include "SignalSampler.h"
 
 namespace MapleRuntime {
 CpuProfiler::~CpuProfiler()
@@ -61,6 +62,8 @@ void CpuProfiler::SamplingThread(SamplesRecord& generator)
 {
     generator.InitProfileInfo();
     uint32_t interval = generator.GetSamplingInterval();
+    // in signal mode stacks are taken by SIGPROF handlers, this thread only symbolizes them.
+    bool signalMode = SignalSampler::IsRequested() && SignalSampler::Start(interval);
     uint64_t startTime = SamplesRecord::GetMicrosecondsTimeStamp();
     generator.SetThreadStartTime(startTime);
     uint64_t endTime = startTime;
@@ -73,11 +76,21 @@ void CpuProfiler::SamplingThread(SamplesRecord& generator)
             usleep(ts);
             endTime = SamplesRecord::GetMicrosecondsTimeStamp();
         }
+        if (signalMode) {
+            SignalSampler::Drain(generator);
+            generator.ParseSampleData(endTime);
+            // several threads may be sampled in one interval, save as many as time allows.
+            while (generator.DoSingleTask(endTime)) {}
+            continue;
+        }
         DoSampleStack();
         generator.ParseSampleData(endTime);
         // Save the sampling data to profileInfo.
         generator.DoSingleTask(endTime);
     }
+    if (signalMode) {
+        SignalSampler::Stop(generator);
+    }
     // Traverse the task queue until all sampling data is saved to profileInfo.
     generator.RunTaskLoop();
     generator.SetSampleStopTime(SamplesRecord::GetMicrosecondsTimeStamp());
@@ -358,17 +358,18 @@ void SamplesRecord::RunTaskLoop()
     }
 }
 
-void SamplesRecord::DoSingleTask(uint64_t previousTimeStemp)
+// return true if a task is saved to profileInfo.
+bool SamplesRecord::DoSingleTask(uint64_t previousTimeStemp)
 {
     if (IsTimeout(previousTimeStemp)) {
-        return;
+        return false;
     }
     if (taskQueue.empty()) {
-        return;
+        return false;
     }
     auto task = taskQueue.front();
     if (!task.finishParsed) {
-        return;
+        return false;
     }
     taskQueue.pop_front();
     if (task.frameCnt == 0) {
@@ -376,6 +377,7 @@ void SamplesRecord::DoSingleTask(uint64_t previousTimeStemp)
     } else {
         AddSample(task);
     }
+    return true;
 }
 
 void SamplesRecord::ParseSampleData(uint64_t previousTimeStemp)
@@ -415,6 +417,12 @@ void SamplesRecord::Post(uint64_t mutatorId, std::vector<uint64_t>& FuncDescRefs
                          std::vector<FrameType>& FrameTypes, std::vector<uint32_t>& LineNumbers)
 {
     uint64_t timeStamp = SamplesRecord::GetMicrosecondsTimeStamp();
+    Post(timeStamp, mutatorId, FuncDescRefs, FrameTypes, LineNumbers);
+}
+
+void SamplesRecord::Post(uint64_t timeStamp, uint64_t mutatorId, std::vector<uint64_t>& FuncDescRefs,
+                         std::vector<FrameType>& FrameTypes, std::vector<uint32_t>& LineNumbers)
+{
     SampleTask task(timeStamp, mutatorId, FuncDescRefs, FrameTypes, LineNumbers);
     taskQueue.push_back(task);
 }
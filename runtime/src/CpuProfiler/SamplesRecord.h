@@ -105,10 +105,13 @@ public:
     void StringifySampleData(ProfileInfo* info);
     void DumpProfileInfo();
     void RunTaskLoop();
-    void DoSingleTask(uint64_t previousTimeStemp);
+    bool DoSingleTask(uint64_t previousTimeStemp);
     void ParseSampleData(uint64_t previousTimeStemp);
     void Post(uint64_t mutatorId, std::vector<uint64_t>& FuncDescRefs,
             std::vector<FrameType>& FrameTypes, std::vector<uint32_t>& LineNumbers);
+    // post a sample taken at timeStamp, used by samplers that collect stacks asynchronously.
+    void Post(uint64_t timeStamp, uint64_t mutatorId, std::vector<uint64_t>& FuncDescRefs,
+            std::vector<FrameType>& FrameTypes, std::vector<uint32_t>& LineNumbers);
     std::vector<CodeInfo> BuildCodeInfos(SampleTask* task);
     int GetSamplingInterval() { return interval; }
     bool OpenFile(int fd);
@@ -0,0 +1,362 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+
+#include "SignalSampler.h"
+
+#include <cstdlib>
+#include "Base/CString.h"
+#include "Base/Log.h"
+#if defined(MRT_SIGNAL_CPU_SAMPLER)
+#include <algorithm>
+#include <cerrno>
+#include <ctime>
+#include <link.h>
+#include <sys/syscall.h>
+#include <thread>
+#include <unistd.h>
+#include "LoaderManager.h"
+#include "ObjectModel/MFuncdesc.inline.h"
+#include "Signal/SignalUtils.h"
+#include "StackMap/StackMap.h"
+#include "schedule.h"
+#endif
+
+namespace MapleRuntime {
+#if defined(MRT_SIGNAL_CPU_SAMPLER)
+std::atomic<bool> SignalSampler::enabled = { false };
+std::atomic<int> SignalSampler::inFlight = { 0 };
+SignalSampler::SampleRing* SignalSampler::rings = nullptr;
+timer_t SignalSampler::timerId;
+struct sigaction SignalSampler::oldAction;
+uint64_t SignalSampler::lastTimeStamp = 0;
+std::vector<SignalSampler::CodeRange> SignalSampler::codeRanges;
+
+void SignalSampler::SampleRing::Init()
+{
+    enqueuePos.store(0, std::memory_order_relaxed);
+    dequeuePos = 0;
+    for (uint32_t i = 0; i < RING_CAPACITY; ++i) {
+        sequences[i].store(i, std::memory_order_relaxed);
+    }
+}
+
+// async-signal-safe, return nullptr if the ring is full.
+SignalSampler::RawSample* SignalSampler::SampleRing::Reserve(uint64_t& pos)
+{
+    pos = enqueuePos.load(std::memory_order_relaxed);
+    while (true) {
+        uint64_t seq = sequences[pos & (RING_CAPACITY - 1)].load(std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t>(seq) - static_cast<int64_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                return &samples[pos & (RING_CAPACITY - 1)];
+            }
+        } else if (diff < 0) {
+            return nullptr;
+        } else {
+            pos = enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+// return the oldest committed sample, or nullptr if it is not committed yet.
+SignalSampler::RawSample* SignalSampler::SampleRing::Peek()
+{
+    uint64_t seq = sequences[dequeuePos & (RING_CAPACITY - 1)].load(std::memory_order_acquire);
+    return seq == dequeuePos + 1 ? &samples[dequeuePos & (RING_CAPACITY - 1)] : nullptr;
+}
+
+void SignalSampler::SampleRing::Pop()
+{
+    sequences[dequeuePos & (RING_CAPACITY - 1)].store(dequeuePos + RING_CAPACITY, std::memory_order_release);
+    ++dequeuePos;
+}
+
+bool SignalSampler::IsRequested()
+{
+    auto env = std::getenv("cjCpuProfilerSignalMode");
+    return env != nullptr && CString::ParseFlagFromEnv(env);
+}
+
+bool SignalSampler::Start(uint32_t intervalUs)
+{
+    rings = new (std::nothrow) SampleRing[RING_NUM];
+    if (rings == nullptr) {
+        LOG(RTLOG_ERROR, "Failed to allocate cpu sample rings.");
+        return false;
+    }
+    for (uint32_t i = 0; i < RING_NUM; ++i) {
+        rings[i].Init();
+    }
+    lastTimeStamp = 0;
+
+    struct sigaction action = {};
+    action.sa_sigaction = SignalSampler::Handler;
+    action.sa_flags = SA_SIGINFO | SA_RESTART | SA_ONSTACK;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, &oldAction) != 0) {
+        LOG(RTLOG_ERROR, "Failed to install SIGPROF handler, errno: %d.", errno);
+        delete[] rings;
+        rings = nullptr;
+        return false;
+    }
+    enabled.store(true, std::memory_order_seq_cst);
+
+    // process cpu-time clock only ticks while some thread runs, so an idle process takes no samples.
+    struct sigevent sev = {};
+    sev.sigev_notify = SIGEV_SIGNAL;
+    sev.sigev_signo = SIGPROF;
+    struct itimerspec spec = {};
+    spec.it_interval.tv_sec = intervalUs / (1000 * 1000); // 1000 * 1000: us per second
+    spec.it_interval.tv_nsec = (intervalUs % (1000 * 1000)) * 1000; // 1000: ns per us
+    spec.it_value = spec.it_interval;
+    if (timer_create(CLOCK_PROCESS_CPUTIME_ID, &sev, &timerId) != 0) {
+        LOG(RTLOG_ERROR, "Failed to create cpu profile timer, errno: %d.", errno);
+        enabled.store(false, std::memory_order_seq_cst);
+        sigaction(SIGPROF, &oldAction, nullptr);
+        delete[] rings;
+        rings = nullptr;
+        return false;
+    }
+    if (timer_settime(timerId, 0, &spec, nullptr) != 0) {
+        LOG(RTLOG_ERROR, "Failed to arm cpu profile timer, errno: %d.", errno);
+        timer_delete(timerId);
+        enabled.store(false, std::memory_order_seq_cst);
+        sigaction(SIGPROF, &oldAction, nullptr);
+        delete[] rings;
+        rings = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void SignalSampler::Stop(SamplesRecord& generator)
+{
+    if (rings == nullptr) {
+        return;
+    }
+    timer_delete(timerId);
+    enabled.store(false, std::memory_order_seq_cst);
+    while (inFlight.load(std::memory_order_seq_cst) != 0) {
+        std::this_thread::yield();
+    }
+    // a SIGPROF still pending must not hit the default action, which terminates the process.
+    struct sigaction restore = oldAction;
+    if ((restore.sa_flags & SA_SIGINFO) == 0 && restore.sa_handler == SIG_DFL) {
+        restore.sa_handler = SIG_IGN;
+    }
+    sigaction(SIGPROF, &restore, nullptr);
+
+    Drain(generator);
+    delete[] rings;
+    rings = nullptr;
+    codeRanges.clear();
+}
+
+void SignalSampler::Handler(int sig, siginfo_t* info, void* context)
+{
+    int savedErrno = errno;
+    inFlight.fetch_add(1, std::memory_order_seq_cst);
+    if (enabled.load(std::memory_order_seq_cst) && context != nullptr) {
+        RecordSample(*reinterpret_cast<ucontext_t*>(context));
+    }
+    inFlight.fetch_sub(1, std::memory_order_release);
+    errno = savedErrno;
+}
+
+// only use async-signal-safe operations here: no lock, no allocation, no logging.
+void SignalSampler::RecordSample(const ucontext_t& context)
+{
+    Uptr stackLow = reinterpret_cast<Uptr>(CJThreadStackAddrGet());
+    Uptr stackHigh = reinterpret_cast<Uptr>(CJThreadStackBaseAddrGet());
+    if (stackLow == 0 || stackHigh <= stackLow) {
+        // not running a cjthread, no managed frame to sample.
+        return;
+    }
+    SampleRing& ring = rings[static_cast<uint64_t>(syscall(SYS_gettid)) & (RING_NUM - 1)];
+    uint64_t pos = 0;
+    RawSample* sample = ring.Reserve(pos);
+    if (sample == nullptr) {
+        // drop the sample rather than block, the sampling thread is behind.
+        return;
+    }
+    struct timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    sample->timeStamp = static_cast<uint64_t>(time.tv_sec) * 1000 * 1000 + // 1000 * 1000: us per second
+        static_cast<uint64_t>(time.tv_nsec) / 1000; // 1000: ns per us
+    sample->cjthreadId = CJThreadId();
+
+    // the interrupted thread may be anywhere, e.g. in a prologue or switching cjthreads, so every frame address is
+    // checked against the cjthread stack before it is dereferenced. the start pc slot is validated later.
+    Uptr pc = GetPCFromUContext(context);
+    Uptr fa = GetFAFromUContext(context);
+    uint32_t frameCnt = 0;
+    while (frameCnt < MAX_FRAMES && fa % sizeof(Uptr) == 0 && fa - sizeof(Uptr) >= stackLow &&
+           fa + sizeof(FrameAddress) <= stackHigh) {
+        FrameAddress* frame = reinterpret_cast<FrameAddress*>(fa);
+        sample->pcs[frameCnt] = pc;
+        sample->startPCs[frameCnt] = reinterpret_cast<Uptr>(FrameInfo::GetFuncStartPCFromFrameAddress(frame));
+        ++frameCnt;
+        Uptr callerFa = reinterpret_cast<Uptr>(frame->callerFrameAddress);
+        // stack grows downwards, a caller frame must be above its callee.
+        if (callerFa <= fa) {
+            break;
+        }
+        pc = reinterpret_cast<Uptr>(frame->returnAddress);
+        fa = callerFa;
+    }
+    sample->frameCnt = frameCnt;
+    ring.Commit(pos);
+}
+
+struct SignalSampler::CodeRangeCollector {
+    std::vector<std::pair<Uptr, BaseFile*>> cjFiles; // meta address of every loaded cangjie file
+    std::vector<CodeRange>* ranges;
+};
+
+// the loader only knows where the metadata of a cangjie file lives, the code is located through the program
+// headers of the binary holding that metadata. unlike dladdr, this covers functions that are not exported and
+// executables linked without -rdynamic.
+int SignalSampler::CollectCodeRanges(struct dl_phdr_info* info, size_t, void* data)
+{
+    CodeRangeCollector* collector = static_cast<CodeRangeCollector*>(data);
+    BaseFile* file = nullptr;
+    for (ElfW(Half) i = 0; i < info->dlpi_phnum && file == nullptr; ++i) {
+        const ElfW(Phdr)& phdr = info->dlpi_phdr[i];
+        if (phdr.p_type != PT_LOAD) {
+            continue;
+        }
+        Uptr segStart = static_cast<Uptr>(info->dlpi_addr + phdr.p_vaddr);
+        Uptr segEnd = segStart + static_cast<Uptr>(phdr.p_memsz);
+        for (auto& cjFile : collector->cjFiles) {
+            if (cjFile.first >= segStart && cjFile.first < segEnd) {
+                file = cjFile.second;
+                break;
+            }
+        }
+    }
+    if (file == nullptr) {
+        return 0;
+    }
+    for (ElfW(Half) i = 0; i < info->dlpi_phnum; ++i) {
+        const ElfW(Phdr)& phdr = info->dlpi_phdr[i];
+        if (phdr.p_type == PT_LOAD && (phdr.p_flags & PF_X) != 0) {
+            Uptr segStart = static_cast<Uptr>(info->dlpi_addr + phdr.p_vaddr);
+            collector->ranges->push_back({ segStart, segStart + static_cast<Uptr>(phdr.p_memsz), file });
+        }
+    }
+    return 0;
+}
+
+// binaries may be loaded or unloaded between two rounds, so the ranges are collected again for each round.
+void SignalSampler::RefreshCodeRanges()
+{
+    CodeRangeCollector collector;
+    collector.ranges = &codeRanges;
+    LoaderManager::GetInstance()->GetLoader()->VisitBaseFile([&collector](BaseFile* file) {
+        collector.cjFiles.emplace_back(file->GetFileMetaAddr(), file);
+        return false;
+    });
+    codeRanges.clear();
+    (void)dl_iterate_phdr(CollectCodeRanges, &collector);
+    std::sort(codeRanges.begin(), codeRanges.end(),
+              [](const CodeRange& a, const CodeRange& b) { return a.start < b.start; });
+}
+
+const SignalSampler::CodeRange* SignalSampler::FindCodeRange(Uptr pc)
+{
+    auto it = std::upper_bound(codeRanges.begin(), codeRanges.end(), pc,
+                               [](Uptr addr, const CodeRange& range) { return addr < range.start; });
+    if (it == codeRanges.begin()) {
+        return nullptr;
+    }
+    --it;
+    return pc < it->end ? &(*it) : nullptr;
+}
+
+// a raw frame is symbolized only if it is not a runtime or stub frame, its pc lies in cangjie code, and its start
+// pc slot leads to a func desc of the same cangjie file whose code covers pc. otherwise the slot may hold garbage
+// and reading a func desc through it is unsafe.
+bool SignalSampler::IsManagedFrame(Uptr pc, Uptr startPC)
+{
+    MachineFrame mFrame(nullptr, reinterpret_cast<const uint32_t*>(pc));
+    if (mFrame.IsRuntimeFrame() || mFrame.IsN2CStubFrame() || mFrame.IsC2NStubFrame() ||
+        mFrame.IsC2RStubFrame() || mFrame.IsStackGrowStubFrame() || mFrame.IsSafepointHandlerStubFrame()) {
+        return false;
+    }
+    const CodeRange* range = FindCodeRange(pc);
+    // the func desc offset is stored right before the function start.
+    constexpr Uptr funcDescSlotSize = sizeof(DataRefOffset32<MFuncDesc>);
+    if (range == nullptr || startPC > pc || startPC < range->start + funcDescSlotSize) {
+        return false;
+    }
+    FuncDescRef funcDesc = MFuncDesc::GetFuncDesc(startPC);
+    if (!range->file->IsAddrInCJFile(reinterpret_cast<Uptr>(funcDesc))) {
+        return false;
+    }
+    // pc of a caller frame is a return address, which may be the end of a function ending with a call.
+    return pc - startPC <= funcDesc->GetCodeSize();
+}
+
+void SignalSampler::Drain(SamplesRecord& generator)
+{
+    if (rings == nullptr) {
+        return;
+    }
+    RefreshCodeRanges();
+    // samples committed after now are left for the next round, so each round is bounded.
+    uint64_t now = SamplesRecord::GetMicrosecondsTimeStamp();
+    std::vector<RawSample> drained;
+    for (uint32_t i = 0; i < RING_NUM; ++i) {
+        RawSample* sample = rings[i].Peek();
+        while (sample != nullptr && sample->timeStamp <= now) {
+            drained.push_back(*sample);
+            rings[i].Pop();
+            sample = rings[i].Peek();
+        }
+    }
+    std::sort(drained.begin(), drained.end(),
+              [](const RawSample& a, const RawSample& b) { return a.timeStamp < b.timeStamp; });
+
+    for (auto& sample : drained) {
+        std::vector<uint64_t> funcDescRefs;
+        std::vector<FrameType> frameTypes;
+        std::vector<uint32_t> lineNumbers;
+        for (uint32_t i = 0; i < sample.frameCnt; ++i) {
+            if (!IsManagedFrame(sample.pcs[i], sample.startPCs[i])) {
+                continue;
+            }
+            FuncDescRef funcDesc = MFuncDesc::GetFuncDesc(sample.startPCs[i]);
+            StackMapBuilder stackMapBuild(sample.startPCs[i], sample.pcs[i], 0, reinterpret_cast<uint64_t*>(funcDesc));
+            MethodMap methodMap = stackMapBuild.Build<MethodMap>();
+            uint32_t lineNum = methodMap.IsValid() ? methodMap.GetLineNum() : 0;
+            funcDescRefs.emplace_back(reinterpret_cast<uint64_t>(funcDesc));
+            frameTypes.emplace_back(FrameType::MANAGED);
+            lineNumbers.emplace_back(lineNum);
+        }
+        // a late commit may carry a timestamp older than the previous round, keep time deltas non-negative.
+        lastTimeStamp = std::max(lastTimeStamp, sample.timeStamp);
+        generator.Post(lastTimeStamp, sample.cjthreadId, funcDescRefs, frameTypes, lineNumbers);
+    }
+}
+#else
+bool SignalSampler::IsRequested()
+{
+    auto env = std::getenv("cjCpuProfilerSignalMode");
+    if (env != nullptr && CString::ParseFlagFromEnv(env)) {
+        LOG(RTLOG_INFO, "signal mode of cpu profiler is not supported on this platform.");
+    }
+    return false;
+}
+
+bool SignalSampler::Start(uint32_t) { return false; }
+
+void SignalSampler::Drain(SamplesRecord&) {}
+
+void SignalSampler::Stop(SamplesRecord&) {}
+#endif
+} // namespace MapleRuntime
@@ -0,0 +1,94 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+
+#ifndef MRT_SIGNAL_SAMPLER_H
+#define MRT_SIGNAL_SAMPLER_H
+
+#include <atomic>
+#include <csignal>
+#include <ctime>
+#include <vector>
+#include "SamplesRecord.h"
+
+#if defined(__linux__) && !defined(ENABLE_BACKWARD_PTRAUTH_CFI) && !defined(CANGJIE_HWASAN_SUPPORT)
+#define MRT_SIGNAL_CPU_SAMPLER 1
+#endif
+
+struct dl_phdr_info;
+
+namespace MapleRuntime {
+class BaseFile;
+
+// asynchronous cpu sampler, enabled by cjCpuProfilerSignalMode.
+// a process cpu-time timer delivers SIGPROF to the thread that is burning cpu, the handler walks the frame-pointer
+// chain of the interrupted cjthread and pushes raw pcs into lock-free rings. symbolization is deferred to the
+// sampling thread, so no mutator is suspended for profiling.
+class SignalSampler {
+public:
+    static bool IsRequested();
+    static bool Start(uint32_t intervalUs);
+    // move all samples taken before now into generator. called by the sampling thread only.
+    static void Drain(SamplesRecord& generator);
+    // disarm timer, wait for in-flight handlers, then drain the rest and release the rings.
+    static void Stop(SamplesRecord& generator);
+
+#if defined(MRT_SIGNAL_CPU_SAMPLER)
+private:
+    static constexpr uint32_t MAX_FRAMES = 32;
+    static constexpr uint32_t RING_NUM = 32; // must be power of 2
+    static constexpr uint32_t RING_CAPACITY = 64; // must be power of 2
+
+    struct RawSample {
+        uint64_t timeStamp;
+        uint64_t cjthreadId;
+        uint32_t frameCnt;
+        Uptr pcs[MAX_FRAMES];
+        Uptr startPCs[MAX_FRAMES];
+    };
+
+    // bounded multi-producer single-consumer ring. threads are spread over rings by tid, so a ring usually has a
+    // single producer and the cas on enqueuePos is uncontended.
+    struct SampleRing {
+        std::atomic<uint64_t> enqueuePos;
+        uint64_t dequeuePos;
+        std::atomic<uint64_t> sequences[RING_CAPACITY];
+        RawSample samples[RING_CAPACITY];
+
+        void Init();
+        RawSample* Reserve(uint64_t& pos);
+        void Commit(uint64_t pos) { sequences[pos & (RING_CAPACITY - 1)].store(pos + 1, std::memory_order_release); }
+        RawSample* Peek();
+        void Pop();
+    };
+
+    // executable segment of a binary which holds cangjie code, file is the cangjie file it carries.
+    struct CodeRange {
+        Uptr start;
+        Uptr end;
+        BaseFile* file;
+    };
+
+    static void Handler(int sig, siginfo_t* info, void* context);
+    static void RecordSample(const ucontext_t& context);
+    struct CodeRangeCollector;
+
+    static int CollectCodeRanges(struct dl_phdr_info* info, size_t size, void* data);
+    static void RefreshCodeRanges();
+    static const CodeRange* FindCodeRange(Uptr pc);
+    static bool IsManagedFrame(Uptr pc, Uptr startPC);
+
+    static std::atomic<bool> enabled;
+    static std::atomic<int> inFlight;
+    static SampleRing* rings;
+    static timer_t timerId;
+    static struct sigaction oldAction;
+    static uint64_t lastTimeStamp;
+    static std::vector<CodeRange> codeRanges; // sorted by start
+#endif
+};
+} // namespace MapleRuntime
+#endif // MRT_SIGNAL_SAMPLER_H
@@ -7,7 +7,11 @@
 
 #include "EhTable.h"
 
+#include <algorithm>
+#include <unordered_map>
+
 #include "Base/LogFile.h"
+#include "Base/RwLock.h"
 #include "Exception.h"
 #include "ObjectModel/MObject.inline.h"
 
@@ -110,6 +114,49 @@ void EHTable::BuildEHTable(const uint8_t* lsda)
     actionTableStart = callSiteTableEnd;
 }
 
+void EHTable::DecodeCallSites(std::vector<EHCallSite>& callSites) const
+{
+    const uint8_t* curPtr = callSiteTableStart;
+    while (curPtr < callSiteTableEnd) {
+        EHCallSite callSite;
+        callSite.start = ReadULEB128(&curPtr);
+        callSite.length = ReadULEB128(&curPtr);
+        callSite.landingPad = ReadULEB128(&curPtr);
+        callSite.actionEntry = ReadULEB128(&curPtr);
+        callSites.push_back(callSite);
+    }
+    // The call sites are emitted in increasing value of start, sort defensively so lookups can bisect.
+    auto lessByStart = [](const EHCallSite& a, const EHCallSite& b) { return a.start < b.start; };
+    if (!std::is_sorted(callSites.begin(), callSites.end(), lessByStart)) {
+        std::stable_sort(callSites.begin(), callSites.end(), lessByStart);
+    }
+}
+
+bool EHTable::ScanCallSite(const EHCallSite& callSite, uint64_t ipOffset, const ExceptionRef& exceptionRef,
+                           const uint32_t* startIp, ScanResult& result) const
+{
+    if ((ipOffset < callSite.start) || (ipOffset >= callSite.start + callSite.length) || callSite.landingPad == 0) {
+        return false;
+    }
+    // Found the call site containing ip.
+    uint64_t landingPad = reinterpret_cast<uintptr_t>(startIp) + callSite.landingPad;
+
+    // ActionEntry is 0 means this function cannot catch the exception.
+    // The landingPad is a epilog address.
+    if (callSite.actionEntry == 0) {
+        result.landingPad = landingPad;
+        return true;
+    }
+    uint8_t exceptionTypeIndex = MatchActionTable(callSite.actionEntry, exceptionRef, *ttypeEncoding);
+    if (exceptionTypeIndex > 0) {
+        result.typeIndex = exceptionTypeIndex;
+        result.landingPad = landingPad;
+        result.isCaught = true;
+        return true;
+    }
+    return false;
+}
+
 void EHTable::ScanEHTable(const uint32_t* pc, const ExceptionWrapper& eWrapper, const uint32_t* startIp,
                           ScanResult& result) const
 {
@@ -118,37 +165,75 @@ void EHTable::ScanEHTable(const uint32_t* pc, const ExceptionWrapper& eWrapper,
     // Get beginning current frame's code (as defined by the emitted dwarf code)
     uint64_t funcstart = reinterpret_cast<uint64_t>(startIp);
     uint64_t ipOffset = ip - funcstart;
-    const uint8_t* curPtr = callSiteTableStart;
-    while (curPtr < callSiteTableEnd) {
-        // There is one entry per call site.
-        // The call sites are non-overlapping in [start, start+length)
-        // The call sites are ordered in increasing value of start
-        uint64_t start = ReadULEB128(&curPtr);
-        uint64_t length = ReadULEB128(&curPtr);
-        uint64_t landingPad = ReadULEB128(&curPtr);
-        uint64_t actionEntry = ReadULEB128(&curPtr);
-        if ((start <= ipOffset) && (ipOffset < (start + length))) {
-            // Found the call site containing ip.
-            if (landingPad == 0) {
-                continue;
-            }
-            landingPad = reinterpret_cast<uintptr_t>(startIp) + landingPad;
-
-            // ActionEntry is 0 means this function cannot catch the exception.
-            // The landingPad is a epilog address.
-            if (actionEntry == 0) {
-                result.landingPad = landingPad;
-                return;
-            }
-            uint8_t exceptionTypeIndex = MatchActionTable(actionEntry, exceptionRef, *ttypeEncoding);
-            if (exceptionTypeIndex > 0) {
-                result.typeIndex = exceptionTypeIndex;
-                result.landingPad = landingPad;
-                result.isCaught = true;
+    if (decodedTable == nullptr) {
+        // Not cached, walk the encoded call-site table in place.
+        const uint8_t* curPtr = callSiteTableStart;
+        while (curPtr < callSiteTableEnd) {
+            EHCallSite callSite;
+            callSite.start = ReadULEB128(&curPtr);
+            callSite.length = ReadULEB128(&curPtr);
+            callSite.landingPad = ReadULEB128(&curPtr);
+            callSite.actionEntry = ReadULEB128(&curPtr);
+            if (ScanCallSite(callSite, ipOffset, exceptionRef, startIp, result)) {
                 return;
             }
         }
-    } // there might be some tricky cases which break out of this loop
+        return;
+    }
+    // The call sites are non-overlapping in [start, start+length), so only the last entry
+    // starting at or before ipOffset can contain it.
+    const std::vector<EHCallSite>& callSites = decodedTable->callSites;
+    auto it = std::upper_bound(callSites.begin(), callSites.end(), ipOffset,
+                               [](uint64_t offset, const EHCallSite& callSite) { return offset < callSite.start; });
+    if (it == callSites.begin()) {
+        return;
+    }
+    (void)ScanCallSite(*(--it), ipOffset, exceptionRef, startIp, result);
+}
+
+namespace {
+RwLock lock;
+std::unordered_map<const uint8_t*, std::shared_ptr<const EHDecodedTable>> tables;
+} // namespace
+
+std::shared_ptr<const EHDecodedTable> EHTableCache::Get(const uint8_t* lsda)
+{
+    lock.LockRead();
+    auto it = tables.find(lsda);
+    if (it != tables.end()) {
+        std::shared_ptr<const EHDecodedTable> table = it->second;
+        lock.UnlockRead();
+        return table;
+    }
+    // Past the cap, callers parse the LSDA in place instead of decoding a table nobody keeps.
+    bool full = tables.size() >= MAX_CACHED_TABLES;
+    lock.UnlockRead();
+    if (full) {
+        return nullptr;
+    }
+
+    EHTable ehTable(lsda);
+    auto decoded = std::make_shared<EHDecodedTable>();
+    decoded->actionTableStart = ehTable.actionTableStart;
+    decoded->ttypeEncoding = ehTable.ttypeEncoding;
+    decoded->exceptionTypeStart = ehTable.exceptionTypeStart;
+    ehTable.DecodeCallSites(decoded->callSites);
+
+    lock.LockWrite();
+    std::shared_ptr<const EHDecodedTable> table = nullptr;
+    if (tables.size() < MAX_CACHED_TABLES) {
+        // Another thread may have raced us here, keep whichever entry landed first.
+        table = tables.emplace(lsda, decoded).first->second;
+    }
+    lock.UnlockWrite();
+    return table;
+}
+
+void EHTableCache::Invalidate()
+{
+    lock.LockWrite();
+    tables.clear();
+    lock.UnlockWrite();
 }
 
 // Scan action table to match exception handler
@@ -8,6 +8,9 @@
 #ifndef MRT_EH_TABLE_H
 #define MRT_EH_TABLE_H
 
+#include <memory>
+#include <vector>
+
 #include "Common/TypeDef.h"
 
 namespace MapleRuntime {
@@ -37,6 +40,35 @@ struct ScanResult {
     bool isCaught;
 };
 
+// One pre-decoded entry of the LSDA call-site table.
+struct EHCallSite {
+    uint64_t start;
+    uint64_t length;
+    uint64_t landingPad;
+    uint64_t actionEntry;
+};
+
+// Header pointers and call sites of one LSDA, decoded once and shared by all throws through the function.
+struct EHDecodedTable {
+    const uint8_t* actionTableStart{ nullptr };
+    const uint8_t* ttypeEncoding{ nullptr };
+    const uint8_t* exceptionTypeStart{ nullptr };
+    std::vector<EHCallSite> callSites; // sorted by start, non-overlapping
+};
+
+// Concurrent cache from LSDA address to its decoded table, filled lazily on the throw path.
+// Entries point into the image that owns the LSDA, so the cache is dropped whenever a library is unloaded.
+class EHTableCache {
+public:
+    // Return nullptr if the lsda is not cached and the cache is full.
+    static std::shared_ptr<const EHDecodedTable> Get(const uint8_t* lsda);
+    static void Invalidate();
+
+private:
+    // Bounds the cache for programs that throw through a very large number of distinct functions.
+    static constexpr size_t MAX_CACHED_TABLES = 1 << 16;
+};
+
 // language-specific data area
 struct EHTable {
     EHTable() = delete;
@@ -45,7 +77,16 @@ struct EHTable {
     EHTable(const uint32_t* pc, const ExceptionWrapper& eWrapper, const uint32_t* startIp, const uint8_t* lsda,
             ScanResult& result)
     {
-        BuildEHTable(lsda);
+        decodedTable = EHTableCache::Get(lsda);
+        if (decodedTable == nullptr) {
+            BuildEHTable(lsda);
+        } else {
+            callSiteTableStart = nullptr;
+            callSiteTableEnd = nullptr;
+            actionTableStart = decodedTable->actionTableStart;
+            ttypeEncoding = decodedTable->ttypeEncoding;
+            exceptionTypeStart = decodedTable->exceptionTypeStart;
+        }
         ScanEHTable(pc, eWrapper, startIp, result);
     }
 
@@ -67,6 +108,9 @@ struct EHTable {
     };
 
     void BuildEHTable(const uint8_t* lsda);
+    void DecodeCallSites(std::vector<EHCallSite>& callSites) const;
+    bool ScanCallSite(const EHCallSite& callSite, uint64_t ipOffset, const ExceptionRef& exceptionRef,
+                      const uint32_t* startIp, ScanResult& result) const;
     void ScanEHTable(const uint32_t* pc, const ExceptionWrapper& eWrapper, const uint32_t* startIp,
                      ScanResult& result) const;
     uint8_t MatchActionTable(uint64_t actionEntryIdx, const ExceptionRef& exceptionRef, uint8_t flag) const;
@@ -79,6 +123,8 @@ struct EHTable {
     }
 
 private:
+    friend class EHTableCache;
+
     static int64_t ReadSLEB128(const uint8_t** data);
 
     void* ReadAbsPtr(const uint8_t* p) const;
@@ -96,6 +142,7 @@ private:
     const uint8_t* actionTableStart{ nullptr };
     const uint8_t* ttypeEncoding{ nullptr };
     const uint8_t* exceptionTypeStart{ nullptr };
+    std::shared_ptr<const EHDecodedTable> decodedTable;
 };
 } // namespace MapleRuntime
 #endif // MRT_EH_TABLE_H
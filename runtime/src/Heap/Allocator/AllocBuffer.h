@@ -8,6 +8,7 @@
 #ifndef MRT_ALLOC_BUFFER_H
 #define MRT_ALLOC_BUFFER_H
 
+#include <atomic>
 #include <functional>
 
 #include "Common/MarkWorkStack.h"
@@ -61,6 +62,22 @@ public:
         stackRoots.clear();
     }
 
+    // byte countdown of sampled allocation profiling, return true if this allocation crosses the sample point.
+    // only the owner thread counts down, other threads may arm it when sampling is set up, so a plain load and
+    // store is enough.
+    bool CountDownAllocSample(size_t size)
+    {
+        int64_t countdown = allocSampleCountdown.load(std::memory_order_relaxed) - static_cast<int64_t>(size);
+        allocSampleCountdown.store(countdown, std::memory_order_relaxed);
+        return countdown <= 0;
+    }
+    void SetAllocSampleCountdown(int64_t bytes)
+    {
+        allocSampleCountdown.store(bytes, std::memory_order_relaxed);
+        allocSampleArmed.store(true, std::memory_order_relaxed);
+    }
+    bool IsAllocSampleArmed() const { return allocSampleArmed.load(std::memory_order_relaxed); }
+
 private:
     // slow path
     MAddress TryAllocateOnce(size_t totalSize, AllocType allocType);
@@ -78,6 +95,9 @@ private:
     RegionList tlLargeRawPointerRegions;
     // Record stack roots in concurrent enum phase, waiting for GC to merge these roots
     std::list<BaseObject*> stackRoots;
+
+    std::atomic<int64_t> allocSampleCountdown = { 0 };
+    std::atomic<bool> allocSampleArmed = { false };
 };
 } // namespace MapleRuntime
 #endif // MRT_ALLOC_BUFFER_H
@@ -24,6 +24,7 @@
 #include "Base/MemUtils.h"
 #include "Base/Panic.h"
 #include "Base/RwLock.h"
+#include "Heap/Allocator/RememberedSet.h"
 #include "Heap/Collector/ForwardDataManager.h"
 #include "Heap/Collector/GcInfos.h"
 #include "Heap/Collector/LiveInfo.h"
@@ -479,6 +480,10 @@ public:
     {
         RegionInfo* region = reinterpret_cast<RegionInfo*>(RegionInfo::UnitInfo::GetUnitInfo(unitIdx));
         region->InitRegion(nUnit, uclass);
+        if (RememberedSet::IsEnabled()) {
+            // objects remembered in a reused region are all dead.
+            RememberedSet::ClearRange(region->GetRegionStart(), region->GetRegionEnd());
+        }
         return region;
     }
 
@@ -716,6 +721,10 @@ public:
     {
         metadata.regionStateBitField.SetAtomicValue(RegionStateBitPos::RESURRECTED_REGION_FLAG, 1, flag);
     }
+    void SetYoungRegionFlag(uint8_t flag)
+    {
+        metadata.regionStateBitField.SetAtomicValue(RegionStateBitPos::YOUNG_REGION_FLAG, 1, flag);
+    }
 
     RegionType GetRegionType() const { return static_cast<RegionType>(metadata.regionType); }
     UnitRole GetUnitRole() const { return static_cast<UnitRole>(metadata.unitRole); }
@@ -784,6 +793,9 @@ public:
 
     bool IsTraceRegion() const { return metadata.isTraceRegion == 1; }
 
+    // only used by generational mode, see RememberedSet.
+    bool IsYoungRegion() const { return metadata.isYoungRegion == 1; }
+
     // copyable during concurrent copying gc.
     bool IsSmallRegion() const { return static_cast<UnitRole>(metadata.unitRole) == UnitRole::SMALL_SIZED_UNITS; }
 
@@ -902,7 +914,8 @@ private:
         IN_GHOST_FROM_REGION_FLAG,
         MARKED_REGION_FLAG,
         ENQUEUED_REGION_FLAG,
-        RESURRECTED_REGION_FLAG
+        RESURRECTED_REGION_FLAG,
+        YOUNG_REGION_FLAG
     };
 
     struct UnitMetadata {
@@ -963,6 +976,10 @@ private:
                 uint8_t isMarked : 1;
                 uint8_t isEnqueued : 1;
                 uint8_t isResurrected : 1;
+
+                // true if this region is allocated by mutators for thread-local allocation in generational mode.
+                // objects in young region are collected by young gc, and young region is not remembered.
+                uint8_t isYoungRegion : 1;
             };
             BitField<uint16_t> regionStateBitField;
         };
@@ -1056,6 +1073,11 @@ private:
             metadata.regionStateBitField.SetAtomicValue(RegionStateBitPos::RESURRECTED_REGION_FLAG, 1, flag);
         }
 
+        void SetYoungRegionFlag(uint8_t flag)
+        {
+            metadata.regionStateBitField.SetAtomicValue(RegionStateBitPos::YOUNG_REGION_FLAG, 1, flag);
+        }
+
         void InitSubordinateUnit(RegionInfo* owner)
         {
             SetUnitRole(UnitRole::SUBORDINATE_UNIT);
@@ -1090,6 +1112,7 @@ private:
         SetMarkedRegionFlag(0);
         SetEnqueuedRegionFlag(0);
         SetResurrectedRegionFlag(0);
+        SetYoungRegionFlag(0);
         __atomic_store_n(&metadata.rawPointerObjectCount, 0, __ATOMIC_SEQ_CST);
     }
 
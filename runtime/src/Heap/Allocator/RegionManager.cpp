@@ -71,12 +71,16 @@ public:
 
     void Execute(size_t) override
     {
+        uint64_t startTime = TimeUtil::NanoSeconds();
+        size_t forwardedBytes = 0;
         while (true) {
             RegionInfo* region = fromRegionList.TakeHeadRegion();
             if (region == nullptr) { break; }
             region->SetRegionType(RegionInfo::RegionType::LONE_FROM_REGION);
-            regionManager.ForwardRegion(region);
+            forwardedBytes += regionManager.ForwardRegion(region);
         }
+        Heap::GetHeap().GetCollector().GetGCStats().RecordForwardStats(forwardedBytes,
+                                                                       TimeUtil::NanoSeconds() - startTime);
     }
 
 private:
@@ -368,6 +372,7 @@ void RegionManager::Initialize(size_t nUnit, uintptr_t regionInfoAddr)
     SetGarbageThreshold();
     // propagate region heap layout
     RegionInfo::Initialize(nUnit, regionInfoAddr, regionHeapStart);
+    RememberedSet::Init(regionHeapStart, nUnit * RegionInfo::UNIT_SIZE);
     freeRegionManager.Initialize(nUnit);
     this->exemptedRegionThreshold = CangjieRuntime::GetHeapParam().exemptionThreshold;
 
@@ -594,31 +599,157 @@ void RegionManager::ForwardFromRegions(GCThreadPool* threadPool)
             return;
         }
 
+        ReserveSurvivorRegions(static_cast<size_t>(threadNum));
         // we start threadPool before adding work so that we can concurrently add tasks;
         threadPool->Start();
         for (int32_t i = 0; i < threadNum; ++i) {
             threadPool->AddWork(new (std::nothrow) ForwardTask(*this, fromRegionList));
         }
         threadPool->WaitFinish();
+        ReleaseReservedRegions();
     } else {
         ForwardFromRegions();
     }
 }
 
+void RegionManager::ReserveSurvivorRegions(size_t threadNum)
+{
+    size_t liveBytes = 0;
+    for (RegionInfo* region = fromRegionList.GetHeadRegion(); region != nullptr; region = region->GetNextRegion()) {
+        liveBytes += region->GetLiveByteCount();
+    }
+    // survivors of a from-region are never split, so each forwarding thread may waste the tail of a region.
+    size_t regionSize = maxUnitCountPerRegion * RegionInfo::UNIT_SIZE;
+    size_t count = (liveBytes + regionSize - 1) / regionSize + threadNum;
+    // the pool only takes refills off the free region trees, it must not hold back regions mutators need near the
+    // heap limit. forwarding threads fall back to the regular path once it is used up.
+    count = std::min(count, threadNum * MAX_RESERVED_REGIONS_PER_THREAD);
+    reservedRegions.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        RegionInfo* region = TakeRegion(maxUnitCountPerRegion, RegionInfo::UnitRole::SMALL_SIZED_UNITS, false);
+        if (region == nullptr) {
+            break;
+        }
+        reservedRegions.push_back(region);
+    }
+    reservedRegionIdx.store(0, std::memory_order_relaxed);
+    reservedRegionCount.store(reservedRegions.size(), std::memory_order_release);
+    DLOG(REGION, "reserve %zu survivor regions for %zu live bytes", reservedRegions.size(), liveBytes);
+}
+
+RegionInfo* RegionManager::TakeReservedRegion()
+{
+    size_t count = reservedRegionCount.load(std::memory_order_acquire);
+    if (reservedRegionIdx.load(std::memory_order_relaxed) >= count) {
+        return nullptr;
+    }
+    size_t idx = reservedRegionIdx.fetch_add(1, std::memory_order_relaxed);
+    return idx < count ? reservedRegions[idx] : nullptr;
+}
+
+void RegionManager::ReleaseReservedRegions()
+{
+    size_t count = reservedRegionCount.exchange(0, std::memory_order_acq_rel);
+    size_t used = std::min(reservedRegionIdx.load(std::memory_order_relaxed), count);
+    for (size_t i = used; i < count; ++i) {
+        ReclaimRegion(reservedRegions[i]);
+    }
+    DLOG(REGION, "release %zu unused survivor regions", count - used);
+    reservedRegions.clear();
+}
+
 void RegionManager::ExemptFromRegion(RegionInfo* region)
 {
     unmovableFromRegionList.PrependRegion(region, RegionInfo::RegionType::UNMOVABLE_FROM_REGION);
 }
 
+bool RegionManager::HasRawPointerYoungRegion()
+{
+    bool found = false;
+    auto visitor = [&found](RegionInfo* region) {
+        if (region->IsYoungRegion() && region->GetRawPointerObjectCount() > 0) {
+            found = true;
+        }
+    };
+    tlRegionList.VisitAllRegions(visitor);
+    recentFullRegionList.VisitAllRegions(visitor);
+    return found;
+}
+
+void RegionManager::DemoteYoungRegions()
+{
+    size_t demotedUnits = 0;
+    auto demote = [&demotedUnits](RegionInfo* region) {
+        if (!region->IsYoungRegion()) {
+            return;
+        }
+        // clear young flag at first, so that live objects in this region can be remembered.
+        region->SetYoungRegionFlag(0);
+        region->VisitLiveObjectsUntilFalse([](BaseObject* obj) {
+            RememberedSet::RecordObject(obj);
+            return true;
+        });
+        demotedUnits += region->GetUnitCount();
+    };
+    unmovableFromRegionList.VisitAllRegions(demote);
+    rawPointerPinnedRegionList.VisitAllRegions(demote);
+    DLOG(REGION, "demote %zu young units", demotedUnits);
+}
+
+void RegionManager::AssembleYoungSpace(const std::set<RegionInfo*>& allocatingRegions)
+{
+    auto assemble = [this, &allocatingRegions](RegionList& list) {
+        RegionInfo* region = list.GetHeadRegion();
+        while (region != nullptr) {
+            RegionInfo* next = region->GetNextRegion();
+            if (region->IsYoungRegion() && allocatingRegions.find(region) == allocatingRegions.end()) {
+                list.DeleteRegion(region);
+                youngRegionList.PrependRegion(region, RegionInfo::RegionType::FROM_REGION);
+            }
+            region = next;
+        }
+    };
+    assemble(tlRegionList);
+    assemble(recentFullRegionList);
+    DLOG(REGION, "young space: %zu regions, %zu units", youngRegionList.GetRegionCount(),
+         youngRegionList.GetUnitCount());
+}
+
+size_t RegionManager::CollectYoungSpace()
+{
+    size_t youngBytes = youngRegionList.GetAllocatedSize(true);
+    garbageRegionList.MergeRegionList(youngRegionList, RegionInfo::RegionType::GARBAGE_REGION);
+    return youngBytes;
+}
+
+size_t RegionManager::VisitRememberedObjects(const std::function<void(BaseObject*)>& visitor) const
+{
+    size_t count = 0;
+    for (uintptr_t regionAddr = regionHeapStart; regionAddr < inactiveZone;) {
+        RegionInfo* region = RegionInfo::GetRegionInfoAt(regionAddr);
+        regionAddr = region->GetRegionEnd();
+        if (!region->IsValidRegion() || region->IsFreeRegion() || region->IsGarbageRegion() ||
+            region->IsYoungRegion()) {
+            continue;
+        }
+        count += RememberedSet::VisitRange(region->GetRegionStart(), region->GetRegionAllocPtr(), visitor);
+    }
+    return count;
+}
+
 void RegionManager::ForwardFromRegions()
 {
+    uint64_t startTime = TimeUtil::NanoSeconds();
+    size_t forwardedBytes = 0;
     RegionInfo* fromRegion = fromRegionList.GetHeadRegion();
     while (fromRegion != nullptr) {
         MRT_ASSERT(fromRegion->IsValidRegion(), "the head region of fromRegionList is invalid");
         RegionInfo* region = fromRegion;
         fromRegion = fromRegion->GetNextRegion();
-        ForwardRegion(region);
+        forwardedBytes += ForwardRegion(region);
     }
+    Heap::GetHeap().GetCollector().GetGCStats().RecordForwardStats(forwardedBytes,
+                                                                   TimeUtil::NanoSeconds() - startTime);
 
     VLOG(REPORT, "forward %zu from-region units", fromRegionList.GetUnitCount());
 
@@ -870,6 +1001,11 @@ RegionInfo* RegionManager::AllocateThreadLocalRegion(bool expectPhysicalMem)
             if (phase == GC_PHASE_TRACE || phase == GC_PHASE_CLEAR_SATB_BUFFER) {
                 region->SetTraceRegionFlag(1);
             }
+            // in generational mode, regions of mutators are young, while regions of gc threads are old since they
+            // are filled with survivors.
+            if (RememberedSet::IsEnabled() && !IsGcThread()) {
+                region->SetYoungRegionFlag(1);
+            }
             tlRegionList.PrependRegion(region, RegionInfo::RegionType::THREAD_LOCAL_REGION);
             DLOG(REGION, "alloc tl-region %p @[0x%zx+%zu, 0x%zx) units[%zu+%zu, %zu) type %u",
                 region, region->GetRegionStart(), region->GetRegionSize(), region->GetRegionEnd(),
@@ -889,16 +1025,28 @@ void RegionManager::RequestForRegion(size_t size)
     }
 
     Heap& heap = Heap::GetHeap();
-    GCStats& gcstats = heap.GetCollector().GetGCStats();
-    size_t allocatedBytes = GetAllocatedSize() - gcstats.liveBytesAfterGC;
-    constexpr double pi = 3.14;
-    size_t availableBytesAfterGC = heap.GetMaxCapacity() - gcstats.liveBytesAfterGC;
-    double heuAllocRate = std::cos((pi / 2.0) * allocatedBytes / availableBytesAfterGC) * gcstats.collectionRate;
-    // for maximum performance, choose the larger one.
-    double allocRate = std::max(
-        static_cast<double>(CangjieRuntime::GetHeapParam().allocationRate) * MB / SECOND_TO_NANO_SECOND, heuAllocRate);
-    size_t waitTime = static_cast<size_t>(size / allocRate);
+    GCPacer& pacer = heap.GetCollector().GetGCPacer();
+    double allocRate;
     uint64_t now = TimeUtil::NanoSeconds();
+    if (pacer.IsEnabled()) {
+        // mutators allocate freely until they use up the runway of current gc, then they assist gc by allocating
+        // no faster than gc goes.
+        if (!heap.IsGcStarted() || GetAllocatedSize() < pacer.GetAssistThreshold() || pacer.GetAssistRate() == 0) {
+            prevRegionAllocTime = now;
+            return;
+        }
+        allocRate = pacer.GetAssistRate();
+    } else {
+        GCStats& gcstats = heap.GetCollector().GetGCStats();
+        size_t allocatedBytes = GetAllocatedSize() - gcstats.liveBytesAfterGC;
+        constexpr double pi = 3.14;
+        size_t availableBytesAfterGC = heap.GetMaxCapacity() - gcstats.liveBytesAfterGC;
+        double heuAllocRate = std::cos((pi / 2.0) * allocatedBytes / availableBytesAfterGC) * gcstats.collectionRate;
+        // for maximum performance, choose the larger one.
+        allocRate = std::max(static_cast<double>(CangjieRuntime::GetHeapParam().allocationRate) * MB /
+                             SECOND_TO_NANO_SECOND, heuAllocRate);
+    }
+    size_t waitTime = static_cast<size_t>(size / allocRate);
     if (prevRegionAllocTime + waitTime <= now) {
         prevRegionAllocTime = TimeUtil::NanoSeconds();
         return;
@@ -911,17 +1059,50 @@ void RegionManager::RequestForRegion(size_t size)
     prevRegionAllocTime = TimeUtil::NanoSeconds();
 }
 
+RegionInfo* RegionManager::AllocateSurvivorRegion()
+{
+    // gc threads refill from reserved regions without contending for the free region trees, only the short
+    // tl-region list lock is taken.
+    RegionInfo* region = IsGcThread() ? TakeReservedRegion() : nullptr;
+    if (region != nullptr) {
+        tlRegionList.PrependRegion(region, RegionInfo::RegionType::THREAD_LOCAL_REGION);
+        DLOG(REGION, "alloc reserved tl-region %p @[0x%zx+%zu, 0x%zx) units[%zu+%zu, %zu)",
+            region, region->GetRegionStart(), region->GetRegionSize(), region->GetRegionEnd(),
+            region->GetUnitIdx(), region->GetUnitCount(), region->GetUnitIdx() + region->GetUnitCount());
+    } else {
+        region = AllocateThreadLocalRegion();
+    }
+    if (region != nullptr && RememberedSet::IsEnabled()) {
+        region->SetYoungRegionFlag(0);
+    }
+    return region;
+}
+
 bool RegionManager::RouteOrCompactRegionImpl(RegionInfo* region)
 {
     CHECK(region->IsRoutingState());
     CHECK_DETAIL(region->GetRawPointerObjectCount() <= 0, "pinned region shouldn't be moved");
-    size_t fromBytes = region->GetLiveByteCount();
+    if (UNLIKELY(RememberedSet::IsEnabled()) && !IsGcThread()) {
+        // survivors must not be copied into regions which mutators allocate from, since objects born there are not
+        // remembered. mutators share one survivor region instead.
+        std::lock_guard<std::mutex> lock(survivorRegionMutex);
+        return RouteOrCompactRegionImpl(region, survivorRegion);
+    }
     AllocBuffer* buffer = AllocBuffer::GetOrCreateAllocBuffer();
-    RegionInfo* toRegion1 = buffer->GetRegion();
+    RegionInfo* toRegion = buffer->GetRegion();
+    bool result = RouteOrCompactRegionImpl(region, toRegion);
+    buffer->SetRegion(toRegion);
+    return result;
+}
+
+bool RegionManager::RouteOrCompactRegionImpl(RegionInfo* region, RegionInfo*& toRegion)
+{
+    size_t fromBytes = region->GetLiveByteCount();
+    RegionInfo* toRegion1 = toRegion;
     CHECK(region != toRegion1);
     bool result;
     if (toRegion1 == RegionInfo::NullRegion()) {
-        toRegion1 = AllocateThreadLocalRegion();
+        toRegion1 = AllocateSurvivorRegion();
         if (toRegion1 == nullptr) {
             CompactRegion(region);
             toRegion1 = region;
@@ -930,7 +1111,7 @@ bool RegionManager::RouteOrCompactRegionImpl(RegionInfo* region)
             toRegion1->Alloc(fromBytes);
             result = true;
         }
-        buffer->SetRegion(toRegion1);
+        toRegion = toRegion1;
         region->SetRouteInfo(toRegion1->GetRegionStart(), fromBytes);
         DLOG(FORWARD, "route region %p@[%#zx+%zu, %#zx) => %p@[%#zx~%#zx, %#zx)",
             region, region->GetRegionStart(), fromBytes, region->GetRegionEnd(), toRegion1,
@@ -968,7 +1149,7 @@ bool RegionManager::RouteOrCompactRegionImpl(RegionInfo* region)
         EnlistFullThreadLocalRegion(toRegion1);
     }
 
-    RegionInfo* toRegion2 = AllocateThreadLocalRegion();
+    RegionInfo* toRegion2 = AllocateSurvivorRegion();
     CHECK(region != toRegion2);
     if (toRegion2 != nullptr) {
         toRegion1->Alloc(usedBytes1);
@@ -979,7 +1160,7 @@ bool RegionManager::RouteOrCompactRegionImpl(RegionInfo* region)
         toRegion2 = region; // region is partially compacted into itself.
         result = false;
     }
-    buffer->SetRegion(toRegion2);
+    toRegion = toRegion2;
     uint32_t toRegion2Idx = toRegion2->GetUnitIdx();
     region->SetRouteInfo(toRegion1Addr, usedBytes1, toRegion2Idx);
     DLOG(FORWARD, "route region %p@[%#zx+%zu, %#zx) => %p@[%#zx, %#zx~%#zx, %#zx) & %p@[%#zx~%#zx, %#zx)", region,
@@ -998,6 +1179,12 @@ void RegionManager::CompactRegion(RegionInfo* region)
     MAddress regionLimit = region->GetRegionAllocPtr();
     region->SetRegionAllocPtr(regionStart);
     CopyCollector& collector = reinterpret_cast<CopyCollector&>(Heap::GetHeap().GetCollector());
+    if (RememberedSet::IsEnabled()) {
+        // compacted region is reused as a to-region, thus it becomes old. objects are moved, they will be remembered
+        // again at new addresses.
+        region->SetYoungRegionFlag(0);
+        RememberedSet::ClearRange(regionStart, regionLimit);
+    }
     for (MAddress currentPtr = regionStart; currentPtr < regionLimit;) {
         BaseObject* currentObj = reinterpret_cast<BaseObject*>(currentPtr);
         size_t size = currentObj->GetSize();
@@ -1007,6 +1194,9 @@ void RegionManager::CompactRegion(RegionInfo* region)
             DLOG(FORWARD, "compact obj %p<%p>(%zu) to %p", currentObj, currentObj->GetTypeInfo(), size, toObj);
             collector.CopyObject(*currentObj, *toObj, size);
             toObj->SetStateCode(ObjectState::NORMAL);
+            if (RememberedSet::IsEnabled()) {
+                RememberedSet::RecordObject(toObj);
+            }
         }
         currentPtr += size;
     }
@@ -1033,6 +1223,13 @@ void RegionManager::CompactRegion(RegionInfo* region, RegionInfo* toRegion1)
     MAddress currentPtr = region->GetRegionStart();
     BaseObject* currentObj = reinterpret_cast<BaseObject*>(currentPtr);
     CopyCollector& collector = reinterpret_cast<CopyCollector&>(Heap::GetHeap().GetCollector());
+    if (RememberedSet::IsEnabled()) {
+        // both regions are reused as to-regions, thus they become old. objects are moved, they will be remembered
+        // again at new addresses.
+        region->SetYoungRegionFlag(0);
+        toRegion1->SetYoungRegionFlag(0);
+        RememberedSet::ClearRange(region->GetRegionStart(), region->GetRegionAllocPtr());
+    }
     while (true) {
         size_t size = currentObj->GetSize();
         if (region->IsMarkedObject(currentObj) || region->IsResurrectedObject(currentObj)) {
@@ -1044,6 +1241,9 @@ void RegionManager::CompactRegion(RegionInfo* region, RegionInfo* toRegion1)
             DLOG(FORWARD, "compact obj %p<%p>(%zu) to %p", currentObj, currentObj->GetTypeInfo(), size, toObj);
             collector.CopyObject(*currentObj, *toObj, size);
             toObj->SetStateCode(ObjectState::NORMAL);
+            if (RememberedSet::IsEnabled()) {
+                RememberedSet::RecordObject(toObj);
+            }
             std::atomic_thread_fence(std::memory_order_release);
         }
         currentPtr += size;
@@ -1061,6 +1261,9 @@ void RegionManager::CompactRegion(RegionInfo* region, RegionInfo* toRegion1)
             DLOG(FORWARD, "compact obj %p<%p>(%zu) to %p", currentObj, currentObj->GetTypeInfo(), size, toObj);
             collector.CopyObject(*currentObj, *toObj, size);
             toObj->SetStateCode(ObjectState::NORMAL);
+            if (RememberedSet::IsEnabled()) {
+                RememberedSet::RecordObject(toObj);
+            }
             std::atomic_thread_fence(std::memory_order_release);
         }
         currentPtr += size;
@@ -1079,7 +1282,7 @@ void RegionManager::CompactRegion(RegionInfo* region, RegionInfo* toRegion1)
     tlRegionList.PrependRegion(region, RegionInfo::RegionType::THREAD_LOCAL_REGION);
 }
 
-void RegionManager::ForwardRegion(RegionInfo* region)
+size_t RegionManager::ForwardRegion(RegionInfo* region)
 {
     CHECK_DETAIL(region->IsFromRegion() || region->IsLoneFromRegion(), "region type %u", region->GetRegionType());
 
@@ -1087,13 +1290,14 @@ void RegionManager::ForwardRegion(RegionInfo* region)
         region, region->GetRegionStart(), region->GetRegionAllocatedSize(), region->GetRegionEnd(),
         region->GetRegionType(), region->GetLiveByteCount());
 
-    if (region->GetLiveByteCount() == 0) {
+    size_t liveBytes = region->GetLiveByteCount();
+    if (liveBytes == 0) {
         CollectRegion(region);
-        return;
+        return 0;
     }
 
     if (!RouteRegion(region)) {
-        return;
+        return 0;
     }
 
     int32_t rawPointerCount = region->GetRawPointerObjectCount();
@@ -1107,6 +1311,7 @@ void RegionManager::ForwardRegion(RegionInfo* region)
         region->SetRouteState(RegionInfo::RouteState::FORWARDED);
         CollectRegion(region);
     }
+    return liveBytes;
 }
 
 uintptr_t RegionManager::AllocPinnedFromFreeList(size_t size)
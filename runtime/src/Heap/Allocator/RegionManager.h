@@ -108,7 +108,8 @@ public:
           toRegionList("to regions"), garbageRegionList("garbage regions"), rawPointerRegionList("raw pointer regions"),
           recentPinnedRegionList("recent pinned regions"), oldPinnedRegionList("old pinned regions"),
           rawPointerPinnedRegionList("raw pointer pinned regions"), oldLargeRegionList("old large regions"),
-          recentLargeRegionList("recent large regions"), largeTraceRegions("large trace regions")
+          recentLargeRegionList("recent large regions"), largeTraceRegions("large trace regions"),
+          youngRegionList("young regions")
     {}
 
     RegionManager(const RegionManager&) = delete;
@@ -119,7 +120,8 @@ public:
 
     void ForwardFromRegions(GCThreadPool* threadPool);
     void ForwardFromRegions();
-    void ForwardRegion(RegionInfo* region);
+    // return bytes of survivors copied out of this region.
+    size_t ForwardRegion(RegionInfo* region);
     void CompactRegion(RegionInfo* region);
     void CompactRegion(RegionInfo* region, RegionInfo* toRegion1);
 
@@ -263,6 +265,27 @@ public:
         garbageRegionList.MergeRegionList(fromRegionList, RegionInfo::RegionType::GARBAGE_REGION);
     }
 
+    // the following apis are only used by generational mode, see RememberedSet.
+    // young region pinned by raw-pointer objects can not be evacuated by young gc.
+    bool HasRawPointerYoungRegion();
+
+    // young regions which are not moved by current gc (i.e. exempted from-regions) become old.
+    void DemoteYoungRegions();
+
+    // move young regions into youngRegionList, except those in *allocatingRegions* which are still held by
+    // allocation buffers.
+    void AssembleYoungSpace(const std::set<RegionInfo*>& allocatingRegions);
+
+    // young regions become garbage after survivors are promoted, return the size of young space.
+    size_t CollectYoungSpace();
+
+    size_t GetYoungSpaceSize() const { return youngRegionList.GetAllocatedSize(true); }
+
+    // visit remembered objects in old regions.
+    size_t VisitRememberedObjects(const std::function<void(BaseObject*)>& visitor) const;
+
+    void ResetRememberedSet() { RememberedSet::Reset(inactiveZone.load(std::memory_order_relaxed)); }
+
     size_t GetThreadLocalRegionSize() const
     {
         return maxUnitCountPerRegion * RegionInfo::UNIT_SIZE;
@@ -449,6 +472,14 @@ public:
     }
 
     bool RouteOrCompactRegionImpl(RegionInfo* region);
+    bool RouteOrCompactRegionImpl(RegionInfo* region, RegionInfo*& toRegion);
+    // to-region of routed regions, its young flag is cleared in generational mode.
+    RegionInfo* AllocateSurvivorRegion();
+    // reserve free regions before parallel forwarding, so gc threads refill to-regions without locking the free
+    // region trees.
+    void ReserveSurvivorRegions(size_t threadNum);
+    RegionInfo* TakeReservedRegion();
+    void ReleaseReservedRegions();
 
     BaseObject* RouteObject(BaseObject* fromObj)
     {
@@ -595,6 +626,17 @@ private:
     // it is recorded here when it is full.
     RegionCache largeTraceRegions;
 
+    // regions evacuated by young gc, only used by generational mode.
+    RegionList youngRegionList;
+    // to-region shared by mutators which route regions in generational mode.
+    std::mutex survivorRegionMutex;
+    RegionInfo* survivorRegion = RegionInfo::NullRegion();
+    // free regions reserved for parallel forwarding, handed out by an atomic index.
+    static constexpr size_t MAX_RESERVED_REGIONS_PER_THREAD = 4;
+    std::vector<RegionInfo*> reservedRegions;
+    std::atomic<size_t> reservedRegionIdx = { 0 };
+    std::atomic<size_t> reservedRegionCount = { 0 };
+
     uintptr_t regionInfoStart = 0; // the address of first RegionInfo
 
     uintptr_t regionHeapStart = 0; // the address of first region to allocate object
@@ -83,6 +83,10 @@ MAddress RegionSpace::Allocate(size_t size, AllocType allocType)
 #if defined(CANGJIE_TSAN_SUPPORT)
     Sanitizer::TsanAllocObject(reinterpret_cast<void *>(internalAddr), allocSize);
 #endif
+    if (UNLIKELY(RememberedSet::IsEnabled()) && !IsGcThread()) {
+        // pinned/large/raw-pointer objects are born old, but compiled code may initialize them without barriers.
+        RememberedSet::RecordWrite(reinterpret_cast<BaseObject*>(internalAddr + HEADER_SIZE));
+    }
     return internalAddr + HEADER_SIZE;
 }
 void RegionSpace::Init(const HeapParam& vmHeapParam)
@@ -266,6 +270,24 @@ bool RegionSpace::IsHeapObject(MAddress addr) const
     return IsHeapAddress(addr);
 }
 #endif
+void RegionSpace::AssembleYoungSpace()
+{
+    std::set<RegionInfo*> allocatingRegions;
+    VisitAllocBuffers([&allocatingRegions](AllocBuffer& buffer) {
+        // young regions held by mutators are evacuated, and mutators take new regions after young gc.
+        RegionInfo* region = buffer.GetRegion();
+        if (region != RegionInfo::NullRegion() && region->IsYoungRegion()) {
+            buffer.ClearRegion();
+        }
+        // prepared regions are still empty, keep them for allocation.
+        RegionInfo* preparedRegion = buffer.GetPreparedRegion();
+        if (preparedRegion != nullptr) {
+            (void)allocatingRegions.insert(preparedRegion);
+        }
+    });
+    regionManager.AssembleYoungSpace(allocatingRegions);
+}
+
 void RegionSpace::FeedHungryBuffers()
 {
     ScopedObjectAccess soa;
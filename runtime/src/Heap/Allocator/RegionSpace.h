@@ -204,6 +204,25 @@ public:
         return regionInfo->IsEnqueuedObject(obj);
     }
 
+    // the following apis are only used by generational mode, see RememberedSet.
+    bool HasRawPointerYoungRegion() { return regionManager.HasRawPointerYoungRegion(); }
+
+    void DemoteYoungRegions() { regionManager.DemoteYoungRegions(); }
+
+    // caller should hold mutator management lock to visit allocation buffers.
+    void AssembleYoungSpace();
+
+    size_t YoungSpaceSize() const { return regionManager.GetYoungSpaceSize(); }
+
+    size_t CollectYoungSpace() { return regionManager.CollectYoungSpace(); }
+
+    size_t VisitRememberedObjects(const std::function<void(BaseObject*)>& visitor) const
+    {
+        return regionManager.VisitRememberedObjects(visitor);
+    }
+
+    void ResetRememberedSet() { regionManager.ResetRememberedSet(); }
+
     void AddRawPointerObject(BaseObject* obj) { regionManager.AddRawPointerObject(obj); }
 
     void RemoveRawPointerObject(BaseObject* obj) { regionManager.RemoveRawPointerObject(obj); }
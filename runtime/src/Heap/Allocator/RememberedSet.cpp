@@ -0,0 +1,166 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+
+#include "Allocator/RememberedSet.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#include "Allocator/MemMap.h"
+#include "Allocator/RegionInfo.h"
+#include "Base/Log.h"
+#include "Base/MemUtils.h"
+
+namespace MapleRuntime {
+bool RememberedSet::enabled = false;
+uintptr_t RememberedSet::heapStartAddress = 0;
+uintptr_t RememberedSet::heapEndAddress = 0;
+size_t RememberedSet::wordCount = 0;
+std::atomic<std::atomic<uint64_t>*> RememberedSet::activeBitmap = { nullptr };
+std::atomic<uint64_t>* RememberedSet::standbyBitmap = nullptr;
+MemMap* RememberedSet::bitmapMap = nullptr;
+
+void RememberedSet::Init(uintptr_t heapStart, size_t heapSize)
+{
+    auto env = std::getenv("cjEnableGenerationalGC");
+    if (env == nullptr) {
+        return;
+    }
+    if (strlen(env) != 1 || (env[0] != '0' && env[0] != '1')) {
+        LOG(RTLOG_ERROR, "Unsupported cjEnableGenerationalGC, cjEnableGenerationalGC should be 0 or 1.\n");
+        return;
+    }
+    if (env[0] == '0') {
+        return;
+    }
+
+    heapStartAddress = heapStart;
+    heapEndAddress = heapStart + heapSize;
+    wordCount = (heapSize / GRANULE_SIZE + BITS_PER_WORD - 1) / BITS_PER_WORD;
+    size_t bitmapSize = wordCount * sizeof(uint64_t);
+
+    MemMap::Option opt = MemMap::DEFAULT_OPTIONS;
+    opt.tag = "remembered_set";
+    // two bitmaps are mapped together, pages are committed when they are touched.
+    bitmapMap = MemMap::MapMemory(bitmapSize * 2, bitmapSize * 2, opt);
+    auto* bitmaps = reinterpret_cast<std::atomic<uint64_t>*>(bitmapMap->GetBaseAddr());
+    activeBitmap.store(bitmaps, std::memory_order_release);
+    standbyBitmap = bitmaps + wordCount;
+    enabled = true;
+    VLOG(REPORT, "generational gc is enabled, remembered set @%p+%zu for heap [%#zx, %#zx)", bitmaps, bitmapSize * 2,
+         heapStartAddress, heapEndAddress);
+}
+
+bool RememberedSet::InYoungRegion(const BaseObject* obj)
+{
+    uintptr_t addr = reinterpret_cast<uintptr_t>(obj);
+    if (addr < heapStartAddress || addr >= heapEndAddress) {
+        return false;
+    }
+    return RegionInfo::GetRegionInfoAt(addr)->IsYoungRegion();
+}
+
+void RememberedSet::RecordWrite(const BaseObject* obj)
+{
+    uintptr_t addr = reinterpret_cast<uintptr_t>(obj);
+    if (addr < heapStartAddress || addr >= heapEndAddress || InYoungRegion(obj)) {
+        return;
+    }
+    Remember(obj);
+}
+
+void RememberedSet::RecordWrite(const BaseObject* obj, const BaseObject* ref)
+{
+    if (!InYoungRegion(ref)) {
+        return;
+    }
+    RecordWrite(obj);
+}
+
+void RememberedSet::RecordObject(BaseObject* obj)
+{
+    uintptr_t addr = reinterpret_cast<uintptr_t>(obj);
+    if (addr < heapStartAddress || addr >= heapEndAddress || InYoungRegion(obj) || !obj->HasRefField()) {
+        return;
+    }
+
+    bool found = false;
+    RefFieldVisitor visitor = [&found](RefField<>& field) {
+        if (found) {
+            return;
+        }
+        RefField<> ref(field);
+        // tagged pointers refer to from-objects, which are always forwarded or demoted to old by full gc.
+        found = !ref.IsTagged() && InYoungRegion(ref.GetTargetObject());
+    };
+    obj->ForEachRefField(visitor);
+    if (UNLIKELY(obj->IsWeakRef())) {
+        visitor(*reinterpret_cast<RefField<>*>(addr + sizeof(TypeInfo*)));
+    }
+
+    if (found) {
+        DLOG(REGION, "remember obj %p<%p>(%zu)", obj, obj->GetTypeInfo(), obj->GetSize());
+        Remember(obj);
+    }
+}
+
+void RememberedSet::ClearBitmap(std::atomic<uint64_t>* bitmap, uintptr_t start, uintptr_t end)
+{
+    size_t startIdx = GetBitIndex(start);
+    size_t endIdx = GetBitIndex(end + GRANULE_SIZE - 1);
+    // partial words at both ends are cleared atomically, since other bits in those words may be set concurrently.
+    while (startIdx < endIdx && (startIdx % BITS_PER_WORD) != 0) {
+        (void)bitmap[startIdx / BITS_PER_WORD].fetch_and(~(1ULL << (startIdx % BITS_PER_WORD)),
+                                                         std::memory_order_relaxed);
+        ++startIdx;
+    }
+    while (endIdx > startIdx && (endIdx % BITS_PER_WORD) != 0) {
+        --endIdx;
+        (void)bitmap[endIdx / BITS_PER_WORD].fetch_and(~(1ULL << (endIdx % BITS_PER_WORD)),
+                                                       std::memory_order_relaxed);
+    }
+    if (startIdx < endIdx) {
+        size_t size = (endIdx - startIdx) / BITS_PER_WORD * sizeof(uint64_t);
+        MemorySet(reinterpret_cast<uintptr_t>(bitmap + startIdx / BITS_PER_WORD), size, 0, size);
+    }
+}
+
+void RememberedSet::ClearRange(uintptr_t start, uintptr_t end)
+{
+    ClearBitmap(GetActiveBitmap(), start, end);
+    ClearBitmap(standbyBitmap, start, end);
+}
+
+void RememberedSet::Reset(uintptr_t end)
+{
+    std::atomic<uint64_t>* standby = standbyBitmap;
+    ClearBitmap(standby, heapStartAddress, end);
+    standbyBitmap = activeBitmap.exchange(standby, std::memory_order_acq_rel);
+    DLOG(REGION, "reset remembered set for [%#zx, %#zx)", heapStartAddress, end);
+}
+
+size_t RememberedSet::VisitRange(uintptr_t start, uintptr_t end, const std::function<void(BaseObject*)>& visitor)
+{
+    std::atomic<uint64_t>* bitmap = GetActiveBitmap();
+    size_t startIdx = GetBitIndex(start);
+    size_t endIdx = GetBitIndex(end + GRANULE_SIZE - 1);
+    size_t count = 0;
+    for (size_t wordIdx = startIdx / BITS_PER_WORD; wordIdx * BITS_PER_WORD < endIdx; ++wordIdx) {
+        uint64_t word = bitmap[wordIdx].load(std::memory_order_relaxed);
+        while (word != 0) {
+            size_t bitIdx = wordIdx * BITS_PER_WORD + static_cast<size_t>(__builtin_ctzll(word));
+            word &= word - 1;
+            if (bitIdx < startIdx || bitIdx >= endIdx) {
+                continue;
+            }
+            visitor(reinterpret_cast<BaseObject*>(heapStartAddress + bitIdx * GRANULE_SIZE));
+            ++count;
+        }
+    }
+    return count;
+}
+} // namespace MapleRuntime
@@ -0,0 +1,97 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+
+#ifndef MRT_REMEMBERED_SET_H
+#define MRT_REMEMBERED_SET_H
+
+#include <atomic>
+#include <functional>
+
+#include "Common/BaseObject.h"
+
+namespace MapleRuntime {
+class MemMap;
+
+// RememberedSet is only used by generational mode (enabled by env cjEnableGenerationalGC).
+// it records objects outside young regions whose ref-fields may refer to young objects. young gc takes remembered
+// objects as roots, thus old space is never traced by young gc.
+//
+// remembered set is a side bitmap over region heap, one bit for each allocation granule, so an object is remembered
+// by the bit of its start address. there are two bitmaps, one is active for barriers and gc, the other is a cleared
+// standby. full gc swaps them when it starts and rebuilds the remembered set while tracing, so that objects which
+// die in full gc never leave bits behind.
+class RememberedSet {
+public:
+    static void Init(uintptr_t heapStart, size_t heapSize);
+
+    static bool IsEnabled() { return enabled; }
+
+    static bool InYoungRegion(const BaseObject* obj);
+
+    // barrier entry: remember *obj* if it is an old heap object.
+    static void RecordWrite(const BaseObject* obj);
+
+    // barrier entry: remember *obj* if it is an old heap object and *ref* is a young object.
+    static void RecordWrite(const BaseObject* obj, const BaseObject* ref);
+
+    // remember *obj* if it is an old heap object, and any of its ref-fields refers to some young object.
+    // this is for objects which are traced or copied into old regions by gc.
+    static void RecordObject(BaseObject* obj);
+
+    // remember any heap object regardless of its region.
+    static void Remember(const BaseObject* obj)
+    {
+        uintptr_t addr = reinterpret_cast<uintptr_t>(obj);
+        if (addr < heapStartAddress || addr >= heapEndAddress) {
+            return;
+        }
+        size_t bitIdx = GetBitIndex(addr);
+        std::atomic<uint64_t>& word = GetActiveBitmap()[bitIdx / BITS_PER_WORD];
+        uint64_t mask = 1ULL << (bitIdx % BITS_PER_WORD);
+        // most writes hit objects which are already remembered, so check before atomic rmw.
+        if ((word.load(std::memory_order_relaxed) & mask) == 0) {
+            (void)word.fetch_or(mask, std::memory_order_relaxed);
+        }
+    }
+
+    static bool IsRemembered(const BaseObject* obj)
+    {
+        size_t bitIdx = GetBitIndex(reinterpret_cast<uintptr_t>(obj));
+        uint64_t mask = 1ULL << (bitIdx % BITS_PER_WORD);
+        return (GetActiveBitmap()[bitIdx / BITS_PER_WORD].load(std::memory_order_relaxed) & mask) != 0;
+    }
+
+    // forget all objects in [start, end), in both active bitmap and standby bitmap.
+    static void ClearRange(uintptr_t start, uintptr_t end);
+
+    // switch to standby bitmap for full gc, *end* is the end of active heap.
+    static void Reset(uintptr_t end);
+
+    // visit remembered objects in [start, end) of active bitmap, return the number of visited objects.
+    static size_t VisitRange(uintptr_t start, uintptr_t end, const std::function<void(BaseObject*)>& visitor);
+
+private:
+    static constexpr size_t BITS_PER_WORD = 64;
+    // must be consistent with allocation alignment.
+    static constexpr size_t GRANULE_SIZE = 8;
+
+    static size_t GetBitIndex(uintptr_t addr) { return (addr - heapStartAddress) / GRANULE_SIZE; }
+
+    static std::atomic<uint64_t>* GetActiveBitmap() { return activeBitmap.load(std::memory_order_acquire); }
+
+    static void ClearBitmap(std::atomic<uint64_t>* bitmap, uintptr_t start, uintptr_t end);
+
+    static bool enabled;
+    static uintptr_t heapStartAddress;
+    static uintptr_t heapEndAddress;
+    static size_t wordCount;
+    static std::atomic<std::atomic<uint64_t>*> activeBitmap;
+    static std::atomic<uint64_t>* standbyBitmap;
+    static MemMap* bitmapMap;
+};
+} // namespace MapleRuntime
+#endif // MRT_REMEMBERED_SET_H
@@ -9,6 +9,7 @@
 #define MRT_BARRIER_H
 
 #include "Common/BaseObject.h"
+#include "Heap/Allocator/RememberedSet.h"
 #include "ObjectModel/Field.h"
 #include "ObjectModel/MClass.h"
 
@@ -61,6 +62,31 @@ public:
     virtual void ReadGeneric(const ObjectPtr dstPtr, ObjectPtr obj, void* fieldPtr, size_t size) const;
 
 protected:
+    // the following helpers are only used by generational mode, see RememberedSet.
+    // remember *obj* when a young *ref* is written into it.
+    static void RememberWrite(const BaseObject* obj, const BaseObject* ref)
+    {
+        if (UNLIKELY(RememberedSet::IsEnabled())) {
+            RememberedSet::RecordWrite(obj, ref);
+        }
+    }
+
+    // remember *obj* when some struct is written into it, since written refs are not checked one by one.
+    static void RememberWrite(const BaseObject* obj)
+    {
+        if (UNLIKELY(RememberedSet::IsEnabled())) {
+            RememberedSet::RecordWrite(obj);
+        }
+    }
+
+    // remember *obj* regardless of its region, for the case that its region may be demoted concurrently.
+    static void RememberObject(const BaseObject* obj)
+    {
+        if (UNLIKELY(RememberedSet::IsEnabled())) {
+            RememberedSet::Remember(obj);
+        }
+    }
+
     class LocalRefFieldContainer {
     public:
         // multi-thread unsafe.
@@ -15,6 +15,7 @@
 #include <set>
 #include <vector>
 
+#include "GcPacer.h"
 #include "GcRequest.h"
 #include "GcStats.h"
 
@@ -75,6 +76,7 @@ public:
     virtual void RunGarbageCollection(uint64_t, GCReason) = 0;
 
     virtual GCStats& GetGCStats() { std::abort(); }
+    virtual GCPacer& GetGCPacer() { std::abort(); }
 
     virtual BaseObject* ForwardObject(BaseObject*) { std::abort(); }
 
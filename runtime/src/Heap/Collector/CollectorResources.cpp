@@ -62,6 +62,8 @@ void CollectorResources::Init()
     StartGCThreads();
     finalizerProcessor.Start();
     gcStats.Init();
+    gcPacer.Init();
+    nativeAllocationRegistry.Init();
 }
 
 void CollectorResources::Fini()
@@ -183,6 +185,27 @@ void CollectorResources::RequestGC(GCReason reason, bool async)
     }
 }
 
+void CollectorResources::RegisterNativeAllocation(NativeSubsystem subsystem, size_t bytes)
+{
+    GCReason reason = nativeAllocationRegistry.RecordAllocation(subsystem, bytes);
+    if (reason == GC_REASON_INVALID || IsGcStarted()) {
+        return;
+    }
+    // runtime threads must never block on gc, they only get the async request.
+    if (reason == GC_REASON_NATIVE_SYNC && !IsRuntimeThread()) {
+        DLOG(ALLOC, "request native sync gc: native bytes %zu", nativeAllocationRegistry.GetNativeBytes());
+        RequestGC(GC_REASON_NATIVE_SYNC, false);
+    } else {
+        DLOG(ALLOC, "request native gc: native bytes %zu", nativeAllocationRegistry.GetNativeBytes());
+        RequestGC(GC_REASON_NATIVE, true);
+    }
+}
+
+void CollectorResources::RegisterNativeFree(NativeSubsystem subsystem, size_t bytes)
+{
+    nativeAllocationRegistry.RecordFree(subsystem, bytes);
+}
+
 void CollectorResources::NotifyGCFinished(uint64_t gcIndex)
 {
     std::unique_lock<std::mutex> lock(gcFinishedCondMutex);
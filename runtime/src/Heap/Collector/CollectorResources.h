@@ -10,6 +10,7 @@
 
 #include "Base/Macros.h"
 #include "FinalizerProcessor.h"
+#include "Heap/Collector/NativeAllocationRegistry.h"
 #include "Heap/Collector/TaskQueue.h"
 #include "Heap/GcThreadPool.h"
 #include "Inspector/CjHeapData.h"
@@ -56,6 +57,11 @@ public:
 
     void BroadcastGCCompletion();
     GCStats& GetGCStats() { return gcStats; }
+    GCPacer& GetGCPacer() { return gcPacer; }
+    NativeAllocationRegistry& GetNativeAllocationRegistry() { return nativeAllocationRegistry; }
+    // charge native memory owned by heap objects, and request a native gc if it grows too much.
+    void RegisterNativeAllocation(NativeSubsystem subsystem, size_t bytes);
+    void RegisterNativeFree(NativeSubsystem subsystem, size_t bytes);
     void RequestHeapDump(GCTask::TaskType gcTask);
 
 private:
@@ -116,6 +122,8 @@ private:
     CollectorProxy& collectorProxy;
     FinalizerProcessor finalizerProcessor;
     GCStats gcStats;
+    GCPacer gcPacer;
+    NativeAllocationRegistry nativeAllocationRegistry;
 };
 } // namespace MapleRuntime
 #endif // MRT_COLLECTOR_RESOURCES_H
@@ -49,6 +49,9 @@ void CopyCollector::RunGarbageCollection(uint64_t gcIndex, GCReason reason)
     GCStats& gcStats = GetGCStats();
     gcStats.collectedBytes = 0;
     gcStats.gcStartTime = TimeUtil::NanoSeconds();
+    if (GetGCPacer().IsEnabled()) {
+        GetGCPacer().OnGCStart(theAllocator.AllocatedBytes(), gcStats.gcStartTime);
+    }
 
     DoGarbageCollection();
 
@@ -78,7 +81,9 @@ void CopyCollector::ForwardFromSpace()
     GCStats& stats = GetGCStats();
     stats.liveBytesBeforeGC = space.AllocatedBytes();
     stats.fromSpaceSize = space.FromSpaceSize();
+    stats.forwardThreadNum.store(0, std::memory_order_relaxed);
     space.ForwardFromSpace(GetThreadPool());
+    stats.DumpForwardStats();
 
     // ForwardFromSpace changes from-space size by exempting from regions, so re-read it.
     // todo: to-space is meaningless.
@@ -7,6 +7,9 @@
 
 #include "Collector/FinalizerProcessor.h"
 
+#include <algorithm>
+#include <cstdlib>
+
 #include "Base/Macros.h"
 #include "Common/ScopedObjectAccess.h"
 #include "ExceptionManager.inline.h"
@@ -15,20 +18,34 @@
 
 namespace MapleRuntime {
 constexpr U32 DEFAULT_FINALIZER_TIMEOUT_MS = 2000;
+constexpr size_t FINALIZER_BATCH_SIZE = 64;
 
-// Note: can only be called by FinalizerProcessor thread
-extern "C" MRT_EXPORT void* MRT_ProcessFinalizers(void* arg)
+// total number of threads running finalizers, including the finalizer processor itself.
+static uint32_t GetFinalizerThreadNum()
 {
-#ifdef __APPLE__
-    CHECK_PTHREAD_CALL(pthread_setname_np, ("gc-helper"), "finalizer-processor thread setname");
-#elif defined(__linux__) || defined(hongmeng)
-    CHECK_PTHREAD_CALL(prctl, (PR_SET_NAME, "gc-helper"), "finalizer-processor thread setname");
-#endif
-    reinterpret_cast<FinalizerProcessor*>(arg)->Run();
-    return nullptr;
+    static uint32_t threadNum = []() -> uint32_t {
+        auto env = std::getenv("cjFinalizerThreadNum");
+        if (env == nullptr) {
+            return 1;
+        }
+        size_t num = CString::ParsePosNumFromEnv(env);
+        if (num == 0 || num > FinalizerProcessor::MAX_WORKER_NUM + 1) {
+            LOG(RTLOG_ERROR, "Unsupported cjFinalizerThreadNum parameter. Valid range is [1, %u].\n",
+                FinalizerProcessor::MAX_WORKER_NUM + 1);
+            return 1;
+        }
+        return static_cast<uint32_t>(num);
+    }();
+    return threadNum;
 }
 
-void FinalizerProcessor::Start()
+struct FinalizerWorkerArg {
+    FinalizerProcessor* processor;
+    uint32_t workerId;
+};
+static FinalizerWorkerArg g_workerArgs[FinalizerProcessor::MAX_WORKER_NUM];
+
+static pthread_t CreateFinalizerThread(void* (*entry)(void*), void* arg)
 {
     pthread_t thread;
     pthread_attr_t attr;
@@ -42,15 +59,76 @@ void FinalizerProcessor::Start()
     CHECK_PTHREAD_CALL(pthread_attr_init, (&attr), "init pthread attr");
     CHECK_PTHREAD_CALL(pthread_attr_setdetachstate, (&attr, PTHREAD_CREATE_JOINABLE), "set pthread joinable");
     CHECK_PTHREAD_CALL(pthread_attr_setstacksize, (&attr, stackSize), "set pthread stacksize");
-    CHECK_PTHREAD_CALL(pthread_create, (&thread, &attr, MRT_ProcessFinalizers, this),
-                       "create finalizer-process thread");
+    CHECK_PTHREAD_CALL(pthread_create, (&thread, &attr, entry, arg), "create finalizer-process thread");
 #ifdef __WIN64
     CHECK_PTHREAD_CALL(pthread_setname_np, (thread, "gc-helper"), "finalizer-processor thread setname");
 #endif
     CHECK_PTHREAD_CALL(pthread_attr_destroy, (&attr), "destroy pthread attr");
-    threadHandle = thread;
+    return thread;
+}
+
+// Note: can only be called by FinalizerProcessor thread
+extern "C" MRT_EXPORT void* MRT_ProcessFinalizers(void* arg)
+{
+#ifdef __APPLE__
+    CHECK_PTHREAD_CALL(pthread_setname_np, ("gc-helper"), "finalizer-processor thread setname");
+#elif defined(__linux__) || defined(hongmeng)
+    CHECK_PTHREAD_CALL(prctl, (PR_SET_NAME, "gc-helper"), "finalizer-processor thread setname");
+#endif
+    reinterpret_cast<FinalizerProcessor*>(arg)->Run();
+    return nullptr;
+}
 
+static void* RunFinalizerWorker(void* arg)
+{
+#ifdef __APPLE__
+    CHECK_PTHREAD_CALL(pthread_setname_np, ("gc-helper"), "finalizer-worker thread setname");
+#elif defined(__linux__) || defined(hongmeng)
+    CHECK_PTHREAD_CALL(prctl, (PR_SET_NAME, "gc-helper"), "finalizer-worker thread setname");
+#endif
+    FinalizerWorkerArg* workerArg = reinterpret_cast<FinalizerWorkerArg*>(arg);
+    workerArg->processor->RunWorker(workerArg->workerId);
+    return nullptr;
+}
+
+void FinalizerProcessor::Start()
+{
+    threadHandle = CreateFinalizerThread(MRT_ProcessFinalizers, this);
     WaitStarted();
+    StartWorkers();
+}
+
+void FinalizerProcessor::StartWorkers()
+{
+    workerNum = GetFinalizerThreadNum() - 1;
+    for (uint32_t i = 0; i < workerNum; ++i) {
+        g_workerArgs[i] = { this, i };
+        workers[i].handle = CreateFinalizerThread(RunFinalizerWorker, &g_workerArgs[i]);
+    }
+    if (workerNum > 0) {
+        LOG(RTLOG_INFO, "FinalizerProcessor started %u extra finalizer workers", workerNum);
+    }
+}
+
+void FinalizerProcessor::StopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> l(workerLock);
+        workerCondition.notify_all();
+    }
+    for (uint32_t i = 0; i < workerNum; ++i) {
+        int tmpResult = ::pthread_join(workers[i].handle, nullptr);
+        CHECK_DETAIL(tmpResult == 0, "::pthread_join() of finalizer worker return %d rather than 0. ", tmpResult);
+        workers[i].handle = 0;
+    }
+    // unfinished batches go back to the queue so a restarted processor still runs them.
+    std::lock_guard<std::mutex> l(listLock);
+    for (uint32_t i = 0; i < workerNum; ++i) {
+        ManagedDeque<BaseObject*>& batch = workers[i].batch;
+        workingFinalizables.insert(workingFinalizables.begin(), batch.begin(), batch.end());
+        batch.clear();
+    }
+    workerNum = 0;
 }
 
 // Stop FinalizerProcessor is only invoked at Fork or Runtime finliazaiton
@@ -61,6 +139,7 @@ void FinalizerProcessor::Stop()
     running = false;
     Notify();
     WaitStop();
+    StopWorkers();
 }
 
 FinalizerProcessor::FinalizerProcessor()
@@ -135,6 +214,34 @@ void FinalizerProcessor::Fini()
     LOG(RTLOG_INFO, "FinalizerProcessor thread stopped");
 }
 
+// Extra workers only run finalizers; heap reclamation and buffer feeding stay on the FP thread.
+void FinalizerProcessor::RunWorker(uint32_t workerId)
+{
+    Worker& worker = workers[workerId];
+    // the fp mutator is a single static instance, so workers get their own mutator.
+    Mutator* mutator = MutatorManager::Instance().CreateRuntimeMutator(ThreadType::FP_THREAD, false);
+    (void)mutator->EnterSaferegion(true);
+    ThreadLocal::SetProtectAddr(reinterpret_cast<uint8_t*>(0));
+    MutatorManager::Instance().MutatorManagementRLock();
+    worker.tid = mutator->GetTid();
+    worker.mutator = mutator;
+    MutatorManager::Instance().MutatorManagementRUnlock();
+
+    uint64_t seenRound = 0;
+    while (running) {
+        ProcessFinalizableList(worker.batch);
+        std::unique_lock<std::mutex> lock(workerLock);
+        std::chrono::milliseconds epoch(iterationWaitTime);
+        workerCondition.wait_for(lock, epoch, [this, &seenRound] { return !running || workRound != seenRound; });
+        seenRound = workRound;
+    }
+
+    MutatorManager::Instance().MutatorManagementRLock();
+    worker.mutator = nullptr;
+    MutatorManager::Instance().MutatorManagementRUnlock();
+    MutatorManager::Instance().DestroyRuntimeMutator(ThreadType::FP_THREAD);
+}
+
 void FinalizerProcessor::WaitStop()
 {
     pthread_t thread = threadHandle;
@@ -176,37 +283,71 @@ void FinalizerProcessor::WaitStarted()
 void FinalizerProcessor::EnqueueFinalizables(const std::function<bool(BaseObject*)>& finalizable, U32 countLimit)
 {
     std::lock_guard<std::mutex> l(listLock);
-    auto it = finalizers.begin();
-    while (it != finalizers.end() && countLimit != 0) {
-        RefField<> tmpField(reinterpret_cast<MAddress>(*it));
+    // compact live finalizers in place, entries beyond countLimit were not part of the snapshot.
+    size_t oldSize = finalizers.size();
+    size_t limit = std::min(oldSize, static_cast<size_t>(countLimit));
+    size_t kept = 0;
+    for (size_t i = 0; i < limit; ++i) {
+        RefField<> tmpField(reinterpret_cast<MAddress>(finalizers[i]));
         BaseObject* obj = tmpField.GetTargetObject();
-        --countLimit;
         if (finalizable(obj)) {
             finalizables.push_back(reinterpret_cast<BaseObject*>(tmpField.GetFieldValue()));
-            it = finalizers.erase(it);
         } else {
-            ++it;
+            finalizers[kept++] = finalizers[i];
         }
     }
+    for (size_t i = limit; i < oldSize; ++i) {
+        finalizers[kept++] = finalizers[i];
+    }
+    finalizers.resize(kept);
 
     if (!finalizables.empty()) {
         hasFinalizableJob.store(true, std::memory_order_relaxed);
     }
+    LogBacklog(oldSize - kept);
+}
+
+void FinalizerProcessor::MergeRegisteredFinalizers()
+{
+    for (RegisterBuffer& buffer : registerBuffers) {
+        std::lock_guard<std::mutex> l(buffer.lock);
+        finalizers.insert(finalizers.end(), buffer.objects.begin(), buffer.objects.end());
+        buffer.objects.clear();
+    }
+}
+
+void FinalizerProcessor::LogBacklog(size_t newFinalizables)
+{
+    size_t backlog = finalizables.size() + workingFinalizables.size() + fpBatch.size();
+    for (uint32_t i = 0; i < workerNum; ++i) {
+        backlog += workers[i].batch.size();
+    }
+    VLOG(REPORT, "finalizer: registered %zu, tracked %zu, newly finalizable %zu, backlog %zu, finalized %zu",
+         registeredCount.load(std::memory_order_relaxed), finalizers.size(), newFinalizables, backlog,
+         finalizedCount.load(std::memory_order_relaxed));
 }
 
 // Process finalizable list
-// 1. always process list head
-// 2. Leave safe region (calling in finalizerProcessor thread)
+// 1. take a batch from workingFinalizables head into the caller's batch, which stays a gc root
+// 2. Leave safe region (calling in finalizerProcessor thread or worker)
 // 3. Invoke finalize method
 // 4. remove processed finalizables
-void FinalizerProcessor::ProcessFinalizableList()
+void FinalizerProcessor::ProcessFinalizableList(ManagedDeque<BaseObject*>& batch)
 {
-    auto itor = workingFinalizables.begin();
-    while (itor != workingFinalizables.end() && running) {
+    while (running) {
         // keep GC thread from visiting roots when workingFinalizables list is updating
         ScopedObjectAccess soa;
+        if (batch.empty()) {
+            std::lock_guard<std::mutex> l(listLock);
+            size_t count = std::min(workingFinalizables.size(), FINALIZER_BATCH_SIZE);
+            if (count == 0) {
+                break;
+            }
+            batch.insert(batch.end(), workingFinalizables.begin(), workingFinalizables.begin() + count);
+            workingFinalizables.erase(workingFinalizables.begin(), workingFinalizables.begin() + count);
+        }
         CHECK_DETAIL(ExceptionManager::GetPendingException() == nullptr, "should not exist pending exception");
-        RefField<> tmpField(reinterpret_cast<MAddress>(*itor));
+        RefField<> tmpField(reinterpret_cast<MAddress>(batch.front()));
         BaseObject* finalizeObjAddr = Heap::GetHeap().GetBarrier().ReadStaticRef(tmpField);
 
         TypeInfo* classInfo = reinterpret_cast<MObject*>(finalizeObjAddr)->GetTypeInfo();
@@ -217,7 +358,7 @@ void FinalizerProcessor::ProcessFinalizableList()
         void (*finalizer)(BaseObject*, TypeInfo*) = reinterpret_cast<void (*)(BaseObject*, TypeInfo*)>(finalizerMethod);
         // finalize method return void, (moving) gc may take place here
         mutator->SetManagedContext(true);
-        DLOG(FINALIZE, "tid %u finalize object %p", tid, finalizeObjAddr);
+        DLOG(FINALIZE, "tid %u finalize object %p", mutator->GetTid(), finalizeObjAddr);
         uintptr_t threadData = MapleRuntime::MRT_GetThreadLocalData();
         ExecuteCangjieStub(finalizeObjAddr, finalizeObjAddr->GetTypeInfo(), 0, reinterpret_cast<void*>(finalizer),
                            reinterpret_cast<void*>(threadData), 0);
@@ -232,8 +373,9 @@ void FinalizerProcessor::ProcessFinalizableList()
         ExceptionManager::ClearPendingException();
         {
             std::lock_guard<std::mutex> l(listLock);
-            itor = workingFinalizables.erase(itor);
+            batch.pop_front();
         }
+        finalizedCount.fetch_add(1, std::memory_order_relaxed);
     }
 }
 
@@ -244,12 +386,22 @@ void FinalizerProcessor::ProcessFinalizables()
         // we leave saferegion to avoid GC visit those changing queues.
         ScopedObjectAccess soa;
         std::lock_guard<std::mutex> l(listLock);
-        // FP will not come here before cleaning up workingFinalizables
-        // workingFinalizables is expected empty, thus we could use std::swap here
-        workingFinalizables.swap(finalizables);
+        // workers may still be draining workingFinalizables, so append instead of swapping.
+        if (workingFinalizables.empty()) {
+            workingFinalizables.swap(finalizables);
+        } else {
+            workingFinalizables.insert(workingFinalizables.end(), finalizables.begin(), finalizables.end());
+            finalizables.clear();
+        }
+        DLOG(FINALIZE, "finalizer: working size %zu", workingFinalizables.size());
     }
-    DLOG(FINALIZE, "finalizer: working size %zu", workingFinalizables.size());
-    ProcessFinalizableList();
+    if (workerNum > 0) {
+        std::lock_guard<std::mutex> l(workerLock);
+        ++workRound;
+        workerCondition.notify_all();
+    }
+    ProcessFinalizableList(fpBatch);
+    std::lock_guard<std::mutex> l(listLock);
     if (finalizables.empty()) {
         hasFinalizableJob.store(false, std::memory_order_relaxed);
     }
@@ -275,8 +427,15 @@ void FinalizerProcessor::RegisterFinalizer(BaseObject* obj)
 {
     RefField<> tmpField(nullptr);
     Heap::GetHeap().GetBarrier().WriteStaticRef(tmpField, obj);
-    std::lock_guard<std::mutex> l(listLock);
-    finalizers.push_back(reinterpret_cast<BaseObject*>(tmpField.GetFieldValue()));
+    // spread registering threads by their mutator, cjthreads migrate between processors.
+    constexpr uint32_t hashShift = 6;
+    size_t index = (reinterpret_cast<uintptr_t>(Mutator::GetMutator()) >> hashShift) % REGISTER_BUFFER_NUM;
+    RegisterBuffer& buffer = registerBuffers[index];
+    {
+        std::lock_guard<std::mutex> l(buffer.lock);
+        buffer.objects.push_back(reinterpret_cast<BaseObject*>(tmpField.GetFieldValue()));
+    }
+    registeredCount.fetch_add(1, std::memory_order_relaxed);
 }
 
 void FinalizerProcessor::ReclaimHeapGarbage()
@@ -8,10 +8,12 @@
 #ifndef MRT_FINALIZER_PROCESSOR_H
 #define MRT_FINALIZER_PROCESSOR_H
 
+#include <atomic>
 #include <climits>
 #include <condition_variable>
-#include <list>
+#include <deque>
 #include <mutex>
+#include <vector>
 
 #include "Base/Panic.h"
 #include "Common/PageAllocator.h"
@@ -19,19 +21,25 @@
 #include "Heap/Collector/Collector.h"
 
 namespace MapleRuntime {
+// chunked storage: no per-node allocation and cheap in-place compaction when sweeping finalizers.
 template<typename T>
-using ManagedList = std::list<T, StdContainerAllocator<T, FINALIZER_PROCESSOR>>;
+using ManagedDeque = std::deque<T, StdContainerAllocator<T, FINALIZER_PROCESSOR>>;
+
+template<typename T>
+using ManagedVector = std::vector<T, StdContainerAllocator<T, FINALIZER_PROCESSOR>>;
 
 class FinalizerProcessor {
 public:
     FinalizerProcessor();
     ~FinalizerProcessor() = default;
 
-    // mainly for resurrection.
+    // mainly for resurrection. Finalizers registered since the last gc are merged first, so the returned
+    // count covers every finalizer created before this snapshot.
     U32 VisitFinalizers(const RootVisitor& visitor)
     {
         U32 count = 0;
         std::lock_guard<std::mutex> l(listLock);
+        MergeRegisteredFinalizers();
         for (BaseObject*& obj : finalizers) {
             visitor(reinterpret_cast<ObjectRef&>(obj));
             ++count;
@@ -43,27 +51,47 @@ public:
     void VisitGCRoots(const RootVisitor& visitor)
     {
         std::lock_guard<std::mutex> l(listLock);
-        for (BaseObject*& obj : finalizables) {
-            visitor(reinterpret_cast<ObjectRef&>(obj));
-        }
-        for (BaseObject*& obj : workingFinalizables) {
-            visitor(reinterpret_cast<ObjectRef&>(obj));
-        }
+        VisitFinalizables(visitor);
     }
 
     // mainly for fixing old pointers
     void VisitRawPointers(const RootVisitor& visitor)
     {
         std::lock_guard<std::mutex> l(listLock);
-        for (BaseObject*& obj : finalizables) {
+        VisitFinalizables(visitor);
+        for (BaseObject*& obj : finalizers) {
             visitor(reinterpret_cast<ObjectRef&>(obj));
         }
-        for (BaseObject*& obj : workingFinalizables) {
-            visitor(reinterpret_cast<ObjectRef&>(obj));
+        for (RegisterBuffer& buffer : registerBuffers) {
+            std::lock_guard<std::mutex> bufferLock(buffer.lock);
+            for (BaseObject*& obj : buffer.objects) {
+                visitor(reinterpret_cast<ObjectRef&>(obj));
+            }
         }
-        for (BaseObject*& obj : finalizers) {
-            visitor(reinterpret_cast<ObjectRef&>(obj));
+    }
+
+    // extra finalizer worker threads hold their own mutators, which must be visited like the fp mutator.
+    template<typename Func>
+    void VisitWorkerMutators(Func&& func)
+    {
+        for (uint32_t i = 0; i < workerNum; ++i) {
+            if (workers[i].mutator != nullptr) {
+                func(*workers[i].mutator);
+            }
+        }
+    }
+
+    bool IsFinalizerThread(uint32_t threadId) const
+    {
+        if (threadId == tid) {
+            return true;
+        }
+        for (uint32_t i = 0; i < workerNum; ++i) {
+            if (workers[i].mutator != nullptr && workers[i].tid == threadId) {
+                return true;
+            }
         }
+        return false;
     }
 
     // notify for finalizer processing loop, invoked after GC
@@ -74,6 +102,7 @@ public:
     void Start();
     void Stop();
     void Run();
+    void RunWorker(uint32_t workerId);
     void Init();
     void Fini();
     void WaitStop();
@@ -92,11 +121,50 @@ public:
         Notify();
     }
 
+    static constexpr uint32_t MAX_WORKER_NUM = 16;
+
 private:
+    // registration is spread over several buffers to keep MCC_NewFinalizer off a single global lock.
+    static constexpr size_t REGISTER_BUFFER_NUM = 32;
+    struct RegisterBuffer {
+        std::mutex lock;
+        ManagedVector<BaseObject*> objects;
+    };
+
+    // the fp thread is worker 0 and has no entry here; each extra worker owns its in-flight batch.
+    struct Worker {
+        pthread_t handle = 0;
+        uint32_t tid = 0;
+        Mutator* mutator = nullptr;
+        ManagedDeque<BaseObject*> batch;
+    };
+
+    void VisitFinalizables(const RootVisitor& visitor)
+    {
+        for (BaseObject*& obj : finalizables) {
+            visitor(reinterpret_cast<ObjectRef&>(obj));
+        }
+        for (BaseObject*& obj : workingFinalizables) {
+            visitor(reinterpret_cast<ObjectRef&>(obj));
+        }
+        for (BaseObject*& obj : fpBatch) {
+            visitor(reinterpret_cast<ObjectRef&>(obj));
+        }
+        for (uint32_t i = 0; i < workerNum; ++i) {
+            for (BaseObject*& obj : workers[i].batch) {
+                visitor(reinterpret_cast<ObjectRef&>(obj));
+            }
+        }
+    }
+
+    void MergeRegisteredFinalizers();
+    void StartWorkers();
+    void StopWorkers();
     void NotifyStarted();
     void Wait(U32 timeoutMilliSeconds);
     void ProcessFinalizables();
-    void ProcessFinalizableList();
+    void ProcessFinalizableList(ManagedDeque<BaseObject*>& batch);
+    void LogBacklog(size_t newFinalizables);
     void ReclaimHeapGarbage();
     void FeedHungryBuffers();
 
@@ -112,13 +180,27 @@ private:
     U32 iterationWaitTime;
 
     // finalization
-    std::mutex listLock;                 // lock for finalizers & finalizables & workingFinalizables
-    ManagedList<BaseObject*> finalizers; // created finalizer record, accessed by mutator & GC
+    std::mutex listLock;                   // lock for finalizers & finalizables & workingFinalizables & batches
+    ManagedVector<BaseObject*> finalizers; // created finalizer record, merged from registerBuffers by GC
+
+    RegisterBuffer registerBuffers[REGISTER_BUFFER_NUM]; // finalizers registered since the last gc
 
     // a dead finalizer is moved into finalizable by GC, then run finalize method by FP thread
-    ManagedList<BaseObject*> finalizables;
+    ManagedDeque<BaseObject*> finalizables;
+
+    // FP working queue, refilled from finalizables and drained batch by batch by FP thread and workers
+    ManagedDeque<BaseObject*> workingFinalizables;
+    ManagedDeque<BaseObject*> fpBatch; // batch being finalized by FP thread
+
+    std::mutex workerLock;
+    std::condition_variable workerCondition; // notify workers that workingFinalizables is refilled
+    uint64_t workRound = 0;                  // bumped under workerLock on every refill
+    uint32_t workerNum = 0;
+    Worker workers[MAX_WORKER_NUM];
 
-    ManagedList<BaseObject*> workingFinalizables; // FP working list, swap from finalizables
+    // backlog metrics
+    std::atomic<size_t> registeredCount{ 0 };
+    std::atomic<size_t> finalizedCount{ 0 };
 
     std::atomic<bool> hasFinalizableJob;
     std::atomic<bool> shouldReclaimHeapGarbage;
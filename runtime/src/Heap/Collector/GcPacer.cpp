@@ -0,0 +1,76 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+
+#include "GcPacer.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "Base/CString.h"
+#include "Base/LogFile.h"
+
+namespace MapleRuntime {
+void GCPacer::Init()
+{
+    auto env = std::getenv("cjGCTargetCPU");
+    if (env == nullptr) {
+        return;
+    }
+    double target = CString::ParsePosDecFromEnv(env);
+    if (target <= 0 || target >= 1) {
+        LOG(RTLOG_ERROR, "Unsupported cjGCTargetCPU parameter. Valid cjGCTargetCPU range is (0, 1).\n");
+        return;
+    }
+    targetCPU = target;
+    enabled = true;
+    prevFinishTime = TimeUtil::NanoSeconds();
+    LOG(RTLOG_INFO, "gc pacer is enabled, target gc cpu share %.2f%%", targetCPU * 100); // 100 for percentage.
+}
+
+void GCPacer::OnGCStart(size_t allocatedBytes, uint64_t timestamp)
+{
+    startTime = timestamp;
+    allocatedAtStart = allocatedBytes;
+    uint64_t mutatorTime = timestamp - prevFinishTime;
+    if (mutatorTime > 0 && allocatedBytes > prevLiveBytes) {
+        allocRate = Smooth(allocRate, static_cast<double>(allocatedBytes - prevLiveBytes) / mutatorTime);
+    }
+}
+
+size_t GCPacer::OnGCFinish(size_t liveBytes, size_t maxCapacity, uint64_t timestamp)
+{
+    uint64_t gcTime = timestamp - startTime;
+    if (gcTime > 0) {
+        // the work of gc is roughly proportional to the heap it starts with.
+        gcRate = Smooth(gcRate, static_cast<double>(allocatedAtStart) / gcTime);
+    }
+    prevFinishTime = timestamp;
+    prevLiveBytes = liveBytes;
+
+    // 0.98: make sure new threshold does not exceed reasonable limit.
+    size_t limit = static_cast<size_t>(maxCapacity * 0.98);
+    if (gcRate == 0) {
+        return std::min(liveBytes + MIN_HEADROOM, limit);
+    }
+    double expectedGCTime = static_cast<double>(liveBytes) / gcRate;
+    // gc cpu share is gcTime / (gcTime + mutatorTime).
+    double mutatorTime = expectedGCTime * (1 - targetCPU) / targetCPU;
+    size_t headroom = std::max(static_cast<size_t>(allocRate * mutatorTime), MIN_HEADROOM);
+    size_t runway = static_cast<size_t>(allocRate * expectedGCTime);
+    // trigger early enough that the allocation during gc still fits in heap.
+    size_t latest = limit > runway ? limit - runway : liveBytes;
+    size_t threshold = std::max(std::min(liveBytes + headroom, latest), std::min(liveBytes + MIN_HEADROOM, limit));
+
+    assistThreshold.store(threshold + runway, std::memory_order_relaxed);
+    assistRate.store(gcRate, std::memory_order_relaxed);
+    VLOG(REPORT, "gc pacer: alloc rate %.2f MB/s, gc rate %.2f MB/s, expected gc time %s, headroom %s, runway %s",
+         allocRate * SECOND_TO_NANO_SECOND / MB, gcRate * SECOND_TO_NANO_SECOND / MB,
+         PrettyOrderMathNano(static_cast<uint64_t>(expectedGCTime), "s").Str(), Pretty(headroom).Str(),
+         Pretty(runway).Str());
+    return threshold;
+}
+} // namespace MapleRuntime
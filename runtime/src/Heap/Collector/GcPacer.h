@@ -0,0 +1,74 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+
+#ifndef MRT_GC_PACER_H
+#define MRT_GC_PACER_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "Base/Globals.h"
+
+namespace MapleRuntime {
+// GCPacer computes the trigger threshold of heuristic gc from measured allocation rate, gc rate and live bytes,
+// so that gc takes no more than a target share of cpu time. it is enabled by cjGCTargetCPU, otherwise the fixed
+// heap threshold heuristics are used.
+//
+// a gc cycle is modeled as: mutators allocate for a while after previous gc, then gc runs concurrently while
+// mutators keep allocating. the pacer makes the mutator interval long enough for the cpu target, and keeps a
+// runway for allocation during gc. mutators which exhaust the runway are paced to the gc rate.
+class GCPacer {
+public:
+    GCPacer() = default;
+    ~GCPacer() = default;
+
+    void Init();
+
+    bool IsEnabled() const { return enabled; }
+
+    // called by gc thread when a gc starts.
+    void OnGCStart(size_t allocatedBytes, uint64_t timestamp);
+
+    // called by gc thread when a gc finishes, return the heap threshold to trigger next gc.
+    size_t OnGCFinish(size_t liveBytes, size_t maxCapacity, uint64_t timestamp);
+
+    // mutators should assist gc when allocated bytes exceed this during gc.
+    size_t GetAssistThreshold() const { return assistThreshold.load(std::memory_order_relaxed); }
+
+    // allocation rate permitted to assisting mutators, in bytes per nano-second.
+    double GetAssistRate() const { return assistRate.load(std::memory_order_relaxed); }
+
+private:
+    static double Smooth(double prev, double sample)
+    {
+        return prev == 0 ? sample : prev * (1 - SMOOTH_FACTOR) + sample * SMOOTH_FACTOR;
+    }
+
+    // weight of the latest sample in moving averages.
+    static constexpr double SMOOTH_FACTOR = 0.5;
+    // trigger next gc at least so many bytes later to avoid back-to-back gc.
+    static constexpr size_t MIN_HEADROOM = 4 * MB;
+
+    bool enabled = false;
+    // max share of cpu time spent on gc, in (0, 1).
+    double targetCPU = 0;
+
+    uint64_t prevFinishTime = 0;
+    size_t prevLiveBytes = 0;
+    uint64_t startTime = 0;
+    size_t allocatedAtStart = 0;
+
+    // moving averages in bytes per nano-second.
+    double allocRate = 0;
+    double gcRate = 0;
+
+    std::atomic<size_t> assistThreshold = { SIZE_MAX };
+    std::atomic<double> assistRate = { 0 };
+};
+} // namespace MapleRuntime
+#endif // MRT_GC_PACER_H
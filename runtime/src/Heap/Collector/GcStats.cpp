@@ -22,6 +22,7 @@ void GCStats::Init()
 {
     isConcurrentMark = false;
     async = false;
+    isYoungGC = false;
     gcStartTime = TimeUtil::NanoSeconds();
     gcEndTime = TimeUtil::NanoSeconds();
     collectedObjects = 0;
@@ -41,6 +42,7 @@ void GCStats::Init()
 
     garbageRatio = 0.0;
     collectionRate = 0.0;
+    forwardThreadNum.store(0, std::memory_order_relaxed);
 
     // 20 MB:set 20 MB as intial value
     heapThreshold = std::min(CangjieRuntime::GetGCParam().gcThreshold, 20 * MB);
@@ -70,5 +72,33 @@ void GCStats::Dump() const
 
     VLOG(REPORT, "allocated size: %s, heap size: %s, heap utilization: %.2f%%", Pretty(liveSize).Str(),
          Pretty(heapSize).Str(), utilization * 100); // 100 for percentage.
+    if (isYoungGC) {
+        VLOG(REPORT, "young gc: young space %s, collected %s", Pretty(fromSpaceSize).Str(),
+             Pretty(collectedBytes).Str());
+    }
+}
+
+void GCStats::RecordForwardStats(size_t bytes, uint64_t timeNs)
+{
+    size_t slot = forwardThreadNum.fetch_add(1, std::memory_order_relaxed);
+    if (slot >= MAX_FORWARD_THREAD_NUM) {
+        return;
+    }
+    forwardedBytes[slot] = bytes;
+    forwardTimeNs[slot] = timeNs;
+}
+
+void GCStats::DumpForwardStats() const
+{
+    size_t threadNum = std::min(forwardThreadNum.load(std::memory_order_relaxed), MAX_FORWARD_THREAD_NUM);
+    size_t totalBytes = 0;
+    for (size_t i = 0; i < threadNum; ++i) {
+        double throughput = (forwardTimeNs[i] == 0) ? 0 :
+            static_cast<double>(forwardedBytes[i]) / MB * SECOND_TO_NANO_SECOND / forwardTimeNs[i];
+        VLOG(REPORT, "forward thread %zu: copied %s in %s, %.2f MB/s", i, Pretty(forwardedBytes[i]).Str(),
+             PrettyOrderMathNano(forwardTimeNs[i], "s").Str(), throughput);
+        totalBytes += forwardedBytes[i];
+    }
+    VLOG(REPORT, "forward threads: %zu, copied %s", threadNum, Pretty(totalBytes).Str());
 }
 } // namespace MapleRuntime
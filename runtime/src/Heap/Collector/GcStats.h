@@ -39,12 +39,17 @@ public:
 
     static void SetPrevGCFinishTime(uint64_t timestamp) { prevGcFinishTime = timestamp; }
 
+    // record copy throughput of a thread which forwards from-regions, thread-safe.
+    void RecordForwardStats(size_t bytes, uint64_t timeNs);
+    void DumpForwardStats() const;
+
     static uint64_t prevGcStartTime;
     static uint64_t prevGcFinishTime;
 
     GCReason reason;
     bool isConcurrentMark;
     bool async;
+    bool isYoungGC;
 
     uint64_t gcStartTime;
     uint64_t gcEndTime;
@@ -68,6 +73,12 @@ public:
     double collectionRate; // bytes per nano-second
 
     size_t heapThreshold;
+
+    // per-thread stats of forwarding, slots beyond MAX_FORWARD_THREAD_NUM are dropped.
+    static constexpr size_t MAX_FORWARD_THREAD_NUM = 64;
+    std::atomic<size_t> forwardThreadNum = { 0 };
+    size_t forwardedBytes[MAX_FORWARD_THREAD_NUM] = { 0 };
+    uint64_t forwardTimeNs[MAX_FORWARD_THREAD_NUM] = { 0 };
 };
 extern size_t g_gcCount;
 extern uint64_t g_gcTotalTimeUs;
@@ -0,0 +1,76 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+
+#include "Heap/Collector/NativeAllocationRegistry.h"
+
+#include <cstdlib>
+
+#include "Base/CString.h"
+#include "Base/LogFile.h"
+
+namespace MapleRuntime {
+static const char* NATIVE_SUBSYSTEM_NAMES[NATIVE_SUBSYSTEM_MAX] = { "other", "socket", "regex" };
+
+void NativeAllocationRegistry::Init()
+{
+    auto env = std::getenv("cjNativeGCThreshold");
+    if (env == nullptr) {
+        return;
+    }
+    size_t size = CString::ParseSizeFromEnv(env) * KB;
+    if (size == 0) {
+        LOG(RTLOG_ERROR, "Unsupported cjNativeGCThreshold parameter. The unit must be added when configuring, "
+                         "it supports 'kb', 'mb', 'gb'.\n");
+        return;
+    }
+    threshold = size;
+}
+
+GCReason NativeAllocationRegistry::RecordAllocation(NativeSubsystem subsystem, size_t bytes)
+{
+    subsystemBytes[subsystem].fetch_add(bytes, std::memory_order_relaxed);
+    size_t total = totalBytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    size_t base = bytesAtLastGC.load(std::memory_order_relaxed);
+    if (total <= base) {
+        return GC_REASON_INVALID;
+    }
+    size_t growth = total - base;
+    if (growth >= threshold * NATIVE_SYNC_GC_FACTOR) {
+        return GC_REASON_NATIVE_SYNC;
+    }
+    return growth >= threshold ? GC_REASON_NATIVE : GC_REASON_INVALID;
+}
+
+void NativeAllocationRegistry::RecordFree(NativeSubsystem subsystem, size_t bytes)
+{
+    subsystemBytes[subsystem].fetch_sub(bytes, std::memory_order_relaxed);
+    size_t total = totalBytes.fetch_sub(bytes, std::memory_order_relaxed) - bytes;
+    // Native memory is mostly freed by finalizers after the gc which found its owners dead. Growth is measured
+    // from the lowest total since last gc, otherwise each gc would raise the trigger by another threshold.
+    size_t base = bytesAtLastGC.load(std::memory_order_relaxed);
+    while (total < base &&
+           !bytesAtLastGC.compare_exchange_weak(base, total, std::memory_order_relaxed, std::memory_order_relaxed)) {
+    }
+}
+
+void NativeAllocationRegistry::OnGCFinish()
+{
+    bytesAtLastGC.store(totalBytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+void NativeAllocationRegistry::Dump() const
+{
+    if (!ENABLE_LOG(REPORT)) {
+        return;
+    }
+    VLOG(REPORT, "native bytes %s, threshold %s", Pretty(GetNativeBytes()).Str(), Pretty(threshold).Str());
+    for (int32_t i = 0; i < NATIVE_SUBSYSTEM_MAX; ++i) {
+        VLOG(REPORT, "    %s: %s", NATIVE_SUBSYSTEM_NAMES[i],
+             Pretty(GetNativeBytes(static_cast<NativeSubsystem>(i))).Str());
+    }
+}
+} // namespace MapleRuntime
@@ -0,0 +1,72 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+
+#ifndef MRT_NATIVE_ALLOCATION_REGISTRY_H
+#define MRT_NATIVE_ALLOCATION_REGISTRY_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "Heap/Collector/GcRequest.h"
+
+namespace MapleRuntime {
+// Owners of native memory charged to the registry, the values are shared with native code of std.
+enum NativeSubsystem : int32_t {
+    NATIVE_SUBSYSTEM_OTHER = 0,
+    NATIVE_SUBSYSTEM_SOCKET, // std.net socket buffers
+    NATIVE_SUBSYSTEM_REGEX,  // std.regex compiled patterns and match data
+    NATIVE_SUBSYSTEM_MAX,
+};
+
+// NativeAllocationRegistry accounts native memory kept alive by heap objects, which is invisible to the heap
+// threshold heuristics. Owners charge the registry when they allocate and discharge it when they free, and a
+// native gc is worth doing once native bytes grow by the native threshold (cjNativeGCThreshold) since last gc.
+class NativeAllocationRegistry {
+public:
+    NativeAllocationRegistry() = default;
+    ~NativeAllocationRegistry() = default;
+
+    void Init();
+
+    // return the gc reason which the allocation asks for, or GC_REASON_INVALID.
+    GCReason RecordAllocation(NativeSubsystem subsystem, size_t bytes);
+    void RecordFree(NativeSubsystem subsystem, size_t bytes);
+
+    size_t GetNativeBytes() const { return totalBytes.load(std::memory_order_relaxed); }
+
+    size_t GetNativeBytes(NativeSubsystem subsystem) const
+    {
+        return subsystemBytes[subsystem].load(std::memory_order_relaxed);
+    }
+
+    size_t GetThreshold() const { return threshold; }
+
+    // called by gc thread when a gc finishes, native growth is measured from here or from a lower total
+    // reached by later frees.
+    void OnGCFinish();
+
+    void Dump() const;
+
+    static NativeSubsystem ToSubsystem(int32_t id)
+    {
+        return (id > NATIVE_SUBSYSTEM_OTHER && id < NATIVE_SUBSYSTEM_MAX) ? static_cast<NativeSubsystem>(id)
+                                                                           : NATIVE_SUBSYSTEM_OTHER;
+    }
+
+private:
+    static constexpr size_t DEFAULT_NATIVE_GC_THRESHOLD = 64 * 1024 * 1024;
+    // a blocking gc is requested when native growth reaches this multiple of the threshold.
+    static constexpr size_t NATIVE_SYNC_GC_FACTOR = 4;
+
+    std::atomic<size_t> subsystemBytes[NATIVE_SUBSYSTEM_MAX] = {};
+    std::atomic<size_t> totalBytes{ 0 };
+    std::atomic<size_t> bytesAtLastGC{ 0 };
+    size_t threshold = DEFAULT_NATIVE_GC_THRESHOLD;
+};
+} // namespace MapleRuntime
+#endif // MRT_NATIVE_ALLOCATION_REGISTRY_H
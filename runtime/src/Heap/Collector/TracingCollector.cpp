@@ -10,11 +10,12 @@
 #include "Common/Runtime.h"
 #include "Concurrency/Concurrency.h"
 #include "Heap/Allocator/AllocBuffer.h"
+#include "Heap/Collector/WorkStealingDeque.h"
 #include "ObjectModel/RefField.inline.h"
+#include "StackMap/StackMapCache.h"
 
 namespace MapleRuntime {
 const size_t TracingCollector::MAX_MARKING_WORK_SIZE = 16; // fork task if bigger
-const size_t TracingCollector::MIN_MARKING_WORK_SIZE = 8;  // forbid forking task if smaller
 
 // Fill gc roots entry to buckets
 void StaticRootTable::RegisterRoots(StaticRootArray* addr, U32 size)
@@ -115,42 +116,41 @@ private:
     GCThreadPool* threadPool;
 };
 
+// mark *obj* and push its unmarked children into *workStack*, return true if *obj* is newly marked.
+static bool MarkAndTraceObject(TracingCollector& collector, BaseObject* obj, TracingCollector::WorkStack& workStack)
+{
+    // skip dangling object (such as: object already released).
+    DCHECK(obj->IsValidObject());
+
+    bool wasMarked = collector.MarkObject(obj);
+    if (wasMarked) {
+        return false;
+    }
+    if (!obj->HasRefField()) {
+        return true;
+    }
+    // Skip marking the weakRef itself, but trace its children node
+    if (UNLIKELY(obj->IsWeakRef())) {
+        RefField<>* referentField = reinterpret_cast<RefField<>*>((uintptr_t)obj + sizeof(TypeInfo*));
+        BaseObject* referent = collector.GetAndTryTagObj(obj, *referentField);
+        if (referent != nullptr) {
+            DLOG(TRACE, "trace weakref obj %p ref@%p: 0x%zx", obj, &referent, referent);
+            collector.TraceObjectRefFields(reinterpret_cast<BaseObject*>(referent), workStack);
+            WeakRefBuffer::Instance().Insert(obj); // record live weakref objects
+        } // If referent is set to none, the corresponding weakref does not need to be recorded.
+    } else {
+        collector.TraceObjectRefFields(obj, workStack);
+    }
+    return true;
+}
+
 class ConcurrentMarkingWork : public HeapWork {
 public:
-    ConcurrentMarkingWork(TracingCollector& tc, GCThreadPool* pool, TracingCollector::WorkStack&& stack)
-        : collector(tc), threadPool(pool), workStack(std::move(stack))
-    {}
-
-    // create concurrent mark task without thread pool.
     ConcurrentMarkingWork(TracingCollector& tc, TracingCollector::WorkStack&& stack)
-        : collector(tc), threadPool(nullptr), workStack(std::move(stack))
+        : collector(tc), workStack(std::move(stack))
     {}
 
-    ~ConcurrentMarkingWork() override { threadPool = nullptr; }
-
-    // when parallel is enabled, fork new task if work stack overflow.
-    void TryForkTask()
-    {
-        size_t size = workStack.size();
-        if (size > TracingCollector::MIN_MARKING_WORK_SIZE) {
-            bool doFork = false;
-            size_t newSize = 0;
-            if (size > TracingCollector::MAX_MARKING_WORK_SIZE) {
-                newSize = size >> 1; // give 1/2 the stack to the thread pool as a new work task
-                doFork = true;
-            } else if (size > TracingCollector::MIN_MARKING_WORK_SIZE && threadPool->GetWaitingThreadNumber() > 0) {
-                constexpr uint8_t shiftForEight = 3;
-                newSize = size >> shiftForEight; // give 1/8 the stack to the thread pool as a new work task
-                doFork = true;
-            }
-
-            if (doFork) {
-                TracingCollector::WorkStackBuf* hSplit = workStack.split(newSize);
-                threadPool->AddWork(
-                    new ConcurrentMarkingWork(collector, threadPool, TracingCollector::WorkStack(hSplit)));
-            }
-        }
-    }
+    ~ConcurrentMarkingWork() override = default;
 
     // run concurrent marking task.
     void Execute(size_t) override
@@ -165,40 +165,172 @@ public:
             BaseObject* obj = workStack.back();
             workStack.pop_back();
 
-            // skip dangling object (such as: object already released).
-            DCHECK(obj->IsValidObject());
-
-            bool wasMarked = collector.MarkObject(obj);
-            if (!wasMarked) {
+            if (MarkAndTraceObject(collector, obj, workStack)) {
                 nNewlyMarked++;
-                if (!obj->HasRefField()) {
-                    continue;
+            }
+        } // end of mark loop.
+        // newly marked statistics.
+        (void)collector.markedObjectCount.fetch_add(nNewlyMarked, std::memory_order_relaxed);
+    }
+
+private:
+    TracingCollector& collector;
+    TracingCollector::WorkStack workStack;
+};
+
+// shared state of work-stealing marking. each marking worker owns a deque, it keeps newly found objects in a private
+// work stack and publishes them to its deque when the deque runs low, so that idle workers can steal them.
+class ParallelMarkingContext {
+public:
+    static constexpr size_t DEQUE_CAPACITY = 4096;
+    // publish private work when the deque holds fewer objects than this.
+    static constexpr size_t PUBLISH_THRESHOLD = 32;
+    using MarkingDeque = WorkStealingDeque<BaseObject*, DEQUE_CAPACITY>;
+
+    explicit ParallelMarkingContext(size_t workerNum) : workerCount(workerNum), deques(new MarkingDeque[workerNum]) {}
+    ~ParallelMarkingContext() { delete[] deques; }
+
+    size_t GetWorkerCount() const { return workerCount; }
+
+    MarkingDeque& GetDeque(size_t workerIdx) { return deques[workerIdx]; }
+
+    void RegisterWorker() { (void)activeWorkers.fetch_add(1, std::memory_order_seq_cst); }
+
+    // steal about half of some victim's deque. the first stolen object is returned by *obj*, others are moved into
+    // the deque of thief.
+    bool StealWork(size_t thief, BaseObject*& obj)
+    {
+        for (size_t i = 1; i < workerCount; ++i) {
+            MarkingDeque& victim = deques[(thief + i) % workerCount];
+            size_t stealNum = std::max(victim.Size() / 2, static_cast<size_t>(1));
+            if (!victim.Steal(obj)) {
+                continue;
+            }
+            MarkingDeque& own = deques[thief];
+            BaseObject* stolen = nullptr;
+            for (size_t n = 1; n < stealNum && victim.Steal(stolen); ++n) {
+                // own deque is drained before stealing, and at most half of a deque is stolen.
+                CHECK(own.Push(stolen));
+            }
+            return true;
+        }
+        return false;
+    }
+
+    // called when *worker* runs out of work. return true if marking is terminated, otherwise *obj* is set to a stolen
+    // object and the worker goes on marking.
+    bool TryTerminate(size_t worker, BaseObject*& obj)
+    {
+        (void)activeWorkers.fetch_sub(1, std::memory_order_seq_cst);
+        for (;;) {
+            if (HasWork()) {
+                (void)activeWorkers.fetch_add(1, std::memory_order_seq_cst);
+                if (StealWork(worker, obj)) {
+                    return false;
                 }
-                // Skip marking the weakRef itself, but trace its children node
-                if (UNLIKELY(obj->IsWeakRef())) {
-                    RefField<>* referentField = reinterpret_cast<RefField<>*>((uintptr_t)obj + sizeof(TypeInfo*));
-                    BaseObject* referent = collector.GetAndTryTagObj(obj, *referentField);
-                    if (referent != nullptr) {
-                        DLOG(TRACE, "trace weakref obj %p ref@%p: 0x%zx", obj, &referent, referent);
-                        collector.TraceObjectRefFields(reinterpret_cast<BaseObject*>(referent), workStack);
-                        WeakRefBuffer::Instance().Insert(obj); // record live weakref objects
-                    } // If referent is set to none, the corresponding weakref does not need to be recorded.
-                } else {
-                    collector.TraceObjectRefFields(obj, workStack);
+                (void)activeWorkers.fetch_sub(1, std::memory_order_seq_cst);
+            } else if (activeWorkers.load(std::memory_order_seq_cst) == 0) {
+                // only active workers produce work, no more work will be published.
+                return true;
+            }
+            (void)sched_yield();
+        }
+    }
+
+private:
+    bool HasWork() const
+    {
+        for (size_t i = 0; i < workerCount; ++i) {
+            if (!deques[i].Empty()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    size_t workerCount;
+    MarkingDeque* deques;
+    std::atomic<size_t> activeWorkers = { 0 };
+};
+
+class StealingMarkingWork : public HeapWork {
+public:
+    StealingMarkingWork(TracingCollector& tc, ParallelMarkingContext& ctx, size_t idx)
+        : collector(tc), context(ctx), workerIdx(idx)
+    {}
+
+    StealingMarkingWork(TracingCollector& tc, ParallelMarkingContext& ctx, size_t idx,
+                        TracingCollector::WorkStack&& stack)
+        : collector(tc), context(ctx), workerIdx(idx), workStack(std::move(stack))
+    {}
+
+    ~StealingMarkingWork() override = default;
+
+    void Execute(size_t) override
+    {
+        size_t nNewlyMarked = 0;
+        PrefetchQueue pq(MARK_PREFETCH_DISTANCE);
+        if (workerIdx != 0) {
+            // worker 0 is the main gc thread, which is registered before helpers are started.
+            context.RegisterWorker();
+        }
+        for (;;) {
+            // Prefetch as much as possible.
+            BaseObject* next = nullptr;
+            while (!pq.Full() && PopWork(next)) {
+                pq.Add(next);
+            }
+
+            if (pq.Empty()) {
+                if (context.TryTerminate(workerIdx, next)) {
+                    break;
                 }
+                pq.Add(next);
+                continue;
             }
-            // try to fork new task if needed.
-            if (threadPool != nullptr) {
-                TryForkTask();
+
+            BaseObject* obj = pq.Remove();
+            if (MarkAndTraceObject(collector, obj, workStack)) {
+                ++nNewlyMarked;
             }
-        } // end of mark loop.
+            PublishWork();
+        }
         // newly marked statistics.
         (void)collector.markedObjectCount.fetch_add(nNewlyMarked, std::memory_order_relaxed);
     }
 
 private:
+    // private work stack is preferred since it needs no synchronization.
+    bool PopWork(BaseObject*& obj)
+    {
+        if (!workStack.empty()) {
+            obj = workStack.back();
+            workStack.pop_back();
+            return true;
+        }
+        return context.GetDeque(workerIdx).Pop(obj);
+    }
+
+    void PublishWork()
+    {
+        ParallelMarkingContext::MarkingDeque& deque = context.GetDeque(workerIdx);
+        if (deque.Size() >= ParallelMarkingContext::PUBLISH_THRESHOLD) {
+            return;
+        }
+        for (size_t n = 0; n < ParallelMarkingContext::PUBLISH_THRESHOLD && !workStack.empty(); ++n) {
+            BaseObject* obj = workStack.back();
+            workStack.pop_back();
+            // keep the last object in private stack to go on marking without synchronization.
+            if (workStack.empty() || !deque.Push(obj)) {
+                workStack.push_back(obj);
+                break;
+            }
+        }
+    }
+
     TracingCollector& collector;
-    GCThreadPool* threadPool;
+    ParallelMarkingContext& context;
+    size_t workerIdx;
     TracingCollector::WorkStack workStack;
 };
 
@@ -208,8 +340,7 @@ void TracingCollector::VisitStackRoots(const RootVisitor& visitor, RegSlotsMap&
     uintptr_t startIP = reinterpret_cast<uintptr_t>(frame.GetStartProc());
     uintptr_t frameIP = reinterpret_cast<uintptr_t>(frame.mFrame.GetIP());
     uintptr_t frameAddress = reinterpret_cast<uintptr_t>(frame.mFrame.GetFA());
-    StackMapBuilder builder = StackMapBuilder(startIP, frameIP, frameAddress);
-    RootMap rootMap = builder.Build<RootMap>();
+    const DecodedStackMap* rootMap = StackMapCache::Instance().Get(startIP, frameIP, frameAddress);
 #if defined(GCINFO_DEBUG) && GCINFO_DEBUG
     DLOG(ENUM, "visit frame 0x%zx-@0x%zx, fp 0x%zx", startIP, frameIP, frameAddress);
     auto gcInfo = GCInfoNode::BuildNodeForTrace(startIP, frameIP, frame.mFrame.GetFA());
@@ -231,9 +362,9 @@ void TracingCollector::VisitStackRoots(const RootVisitor& visitor, RegSlotsMap&
     SlotDebugVisitor slotDebugFunc = nullptr;
     RegDebugVisitor regDebugFunc = nullptr;
 #endif
-    if (rootMap.IsValid()) {
-        rootMap.VisitSlotRoots(visitor, slotDebugFunc);
-        if (!rootMap.VisitRegRoots(visitor, regDebugFunc, regSlotsMap)) {
+    if (rootMap->IsValid()) {
+        rootMap->VisitSlotRoots(visitor, slotDebugFunc, frameAddress);
+        if (!rootMap->VisitRegRoots(visitor, regDebugFunc, regSlotsMap)) {
 #if defined(GCINFO_DEBUG) && GCINFO_DEBUG
             mutator.PushFrameInfoForTrace(gcInfo);
 #endif
@@ -244,7 +375,7 @@ void TracingCollector::VisitStackRoots(const RootVisitor& visitor, RegSlotsMap&
 #if defined(GCINFO_DEBUG) && GCINFO_DEBUG
     mutator.PushFrameInfoForTrace(gcInfo);
 #endif
-    rootMap.RecordCalleeSaved(regSlotsMap);
+    rootMap->RecordCalleeSaved(regSlotsMap, frameAddress);
 }
 
 void TracingCollector::VisitHeapReferencesOnStack(const RootVisitor& rootVisitor,
@@ -254,8 +385,7 @@ void TracingCollector::VisitHeapReferencesOnStack(const RootVisitor& rootVisitor
     uintptr_t startIP = reinterpret_cast<uintptr_t>(frame.GetStartProc());
     uintptr_t frameIP = reinterpret_cast<uintptr_t>(frame.mFrame.GetIP());
     uintptr_t frameAddress = reinterpret_cast<uintptr_t>(frame.mFrame.GetFA());
-    StackMapBuilder builder = StackMapBuilder(startIP, frameIP, frameAddress);
-    HeapReferenceMap heapMap = builder.Build<HeapReferenceMap>();
+    const DecodedStackMap* heapMap = StackMapCache::Instance().Get(startIP, frameIP, frameAddress);
 #if defined(GCINFO_DEBUG) && GCINFO_DEBUG
     auto infoNode = GCInfoNodeForFix::BuildNodeForFix(startIP, frameIP, frame.mFrame.GetFA());
     auto slotDebugFunc = [&infoNode](SlotBias off, const BaseObject* root) {
@@ -281,22 +411,23 @@ void TracingCollector::VisitHeapReferencesOnStack(const RootVisitor& rootVisitor
     DerivedPtrDebugVisitor derivedPtrDebugFunc = nullptr;
 #endif
     DLOG(ENUM, "visit heap-ref 0x%zx-@0x%zx, fp 0x%zx", startIP, frameIP, frameAddress);
-    if (heapMap.IsValid()) {
-        if (!heapMap.VisitRegRoots(rootVisitor, regDebugFunc, regSlotsMap)) {
+    if (heapMap->IsValid()) {
+        std::list<Uptr> rootsList;
+        if (!heapMap->VisitRegRoots(rootVisitor, regDebugFunc, regSlotsMap, &rootsList)) {
 #if defined(GCINFO_DEBUG) && GCINFO_DEBUG
             mutator.PushFrameInfoForFix(infoNode);
 #endif
             LOG(RTLOG_FATAL, "wrong reg info, start ip: %p frame pc: %p", reinterpret_cast<void*>(startIP),
                 reinterpret_cast<void*>(frameIP));
         }
-        heapMap.VisitSlotRoots(rootVisitor, slotDebugFunc);
+        heapMap->VisitSlotRoots(rootVisitor, slotDebugFunc, frameAddress, &rootsList);
         // VisitDerivedPtr must be invoked after VisitRegRoots and VisitSlotRoots;
-        heapMap.VisitDerivedPtr(derivedPtrVisitor, derivedPtrDebugFunc, regSlotsMap);
+        heapMap->VisitDerivedPtr(derivedPtrVisitor, derivedPtrDebugFunc, regSlotsMap, rootsList, frameAddress);
     }
 #if defined(GCINFO_DEBUG) && GCINFO_DEBUG
     mutator.PushFrameInfoForFix(infoNode);
 #endif
-    heapMap.RecordCalleeSaved(regSlotsMap);
+    heapMap->RecordCalleeSaved(regSlotsMap, frameAddress);
 }
 
 void TracingCollector::RecordStubCalleeSaved(RegSlotsMap& regSlotsMap, Uptr fp)
@@ -346,12 +477,25 @@ void TracingCollector::TracingImpl(WorkStack& workStack, bool parallel)
     GCThreadPool* threadPool = GetThreadPool();
     MRT_ASSERT(threadPool != nullptr, "thread pool is null");
     if (parallel) { // parallel marking.
-        threadPool->Start();
-        // add work fails, let mainGC run init task & fork tasks to poolThread for workload balance
-        if (!AddConcurrentTracingWork(workStack)) {
-            ConcurrentMarkingWork markTask(*this, threadPool, std::move(workStack));
-            markTask.Execute(0);
+        // main gc thread works as worker 0 together with helpers in thread pool.
+        const size_t workerCount = static_cast<size_t>(threadPool->GetMaxActiveThreadNum()) + 1;
+        ParallelMarkingContext context(workerCount);
+        // spread roots over all deques, so that every worker can start without stealing.
+        for (size_t i = 0; !workStack.empty(); ++i) {
+            BaseObject* root = workStack.back();
+            if (!context.GetDeque(i % workerCount).Push(root)) {
+                // overflowed roots are left to main gc thread.
+                break;
+            }
+            workStack.pop_back();
+        }
+        for (size_t i = 1; i < workerCount; ++i) {
+            threadPool->AddWork(new (std::nothrow) StealingMarkingWork(*this, context, i));
         }
+        context.RegisterWorker();
+        threadPool->Start();
+        StealingMarkingWork markTask(*this, context, 0, std::move(workStack));
+        markTask.Execute(0);
         threadPool->WaitFinish();
     } else {
         // serial marking with a single mark task.
@@ -361,22 +505,6 @@ void TracingCollector::TracingImpl(WorkStack& workStack, bool parallel)
     }
 }
 
-bool TracingCollector::AddConcurrentTracingWork(RootSet& rs)
-{
-    GCThreadPool* threadPool = GetThreadPool();
-    size_t threadCount = threadPool->GetMaxActiveThreadNum() + 1;
-    if (rs.size() <= threadCount * MIN_MARKING_WORK_SIZE) {
-        return false; // too less init tasks, which may lead to workload imbalance, add work rejected
-    }
-    const size_t chunkSize = std::min(rs.size() / threadCount + 1, MIN_MARKING_WORK_SIZE);
-    // Split the current work stack into work tasks.
-    while (!rs.empty()) {
-        TracingCollector::WorkStackBuf* hSplit = rs.split(chunkSize);
-        threadPool->AddWork(new (std::nothrow) ConcurrentMarkingWork(*this, threadPool, WorkStack(hSplit)));
-    }
-    return true;
-}
-
 void TracingCollector::DoTracing(WorkStack& workStack)
 {
     ScopedEntryHiTrace hiTrace("CJRT_GC_TRACE");
@@ -438,13 +566,8 @@ bool TracingCollector::MarkSatbBuffer(WorkStack& workStack)
     constexpr size_t maxIterationLoopNum = 1000;
     auto visitSatbObj = [this, &workStack]() {
         WorkStack remarkStack;
-        auto func = [&remarkStack](Mutator& mutator) {
-            const SatbBuffer::Node* node = mutator.GetSatbBufferNode();
-            if (node != nullptr) {
-                const_cast<SatbBuffer::Node*>(node)->GetObjects(remarkStack);
-            }
-        };
-        MutatorManager::Instance().VisitAllMutators(func);
+        // nodes held by mutators are not scanned here, they are retired at the transition to
+        // GC_PHASE_CLEAR_SATB_BUFFER, so satb push on mutator side is free of synchronization.
         SatbBuffer::Instance().GetRetiredObjects(remarkStack);
 
         while (!remarkStack.empty()) {
@@ -464,6 +587,8 @@ bool TracingCollector::MarkSatbBuffer(WorkStack& workStack)
         if (++iterationCnt > maxIterationLoopNum && (TimeUtil::NanoSeconds() - iterationStartTime) > maxIterationTime) {
             ScopedStopTheWorld stw("MarkSatbBuffer timeout", true, GCPhase::GC_PHASE_CLEAR_SATB_BUFFER);
             VLOG(REPORT, "MarkSatbBuffer is done for timeout");
+            // nodes of mutators are retired when the world is stopped.
+            visitSatbObj();
             GCThreadPool* threadPool = GetThreadPool();
             TracingImpl(workStack, (workStack.size() > MAX_MARKING_WORK_SIZE) || (threadPool->GetWorkCount() > 0));
             return workStack.empty();
@@ -636,6 +761,9 @@ void TracingCollector::PostGarbageCollection(uint64_t gcIndex)
     TransitionToGCPhase(GCPhase::GC_PHASE_RECLAIM_SATB_NODE, true);
     SatbBuffer::Instance().ReclaimALLPages();
     PagePool::Instance().Trim();
+    // Free replaced stack map cache entries, unless a heap dump is still walking stacks.
+    StackMapCache::Instance().DumpAndResetStats();
+    StackMapCache::Instance().Reclaim();
     collectorResources.NotifyGCFinished(gcIndex);
 
 #if defined(MRT_DEBUG) && (MRT_DEBUG == 1)
@@ -689,6 +817,9 @@ void TracingCollector::UpdateGCStats()
     RegionSpace& space = reinterpret_cast<RegionSpace&>(theAllocator);
     GCStats& gcStats = GetGCStats();
     gcStats.Dump();
+    NativeAllocationRegistry& nativeRegistry = collectorResources.GetNativeAllocationRegistry();
+    nativeRegistry.Dump();
+    nativeRegistry.OnGCFinish();
 
     size_t oldThreshold = gcStats.heapThreshold;
     size_t liveBytes = space.AllocatedBytes();
@@ -701,6 +832,17 @@ void TracingCollector::UpdateGCStats()
     } else {
         space.EnableAsyncAllocation(true);
     }
+    GCPacer& pacer = GetGCPacer();
+    if (pacer.IsEnabled()) {
+        // the pacer replaces both the threshold heuristics and the fixed interval of heuristic gc.
+        gcStats.heapThreshold = pacer.OnGCFinish(liveBytes, space.GetMaxCapacity(), gcStats.gcEndTime);
+        g_gcRequests[GC_REASON_HEU].SetMinInterval(0);
+        VLOG(REPORT, "live bytes %zu (survived %zu, recent-allocated %zu), pace gc threshold %zu -> %zu", liveBytes,
+             survivedBytes, recentBytes, oldThreshold, gcStats.heapThreshold);
+        OHOS_HITRACE_COUNT("CJRT_post_GC_HeapSize", Heap::GetHeap().GetAllocatedSize());
+        return;
+    }
+
     // 4 ways to estimate heap next threshold.
     double heapGrowth = 1 + (CangjieRuntime::GetHeapParam().heapGrowth);
     size_t threshold1 = survivedBytes * heapGrowth;
@@ -94,10 +94,12 @@ private:
 
 class MarkingWork;
 class ConcurrentMarkingWork;
+class StealingMarkingWork;
 
 class TracingCollector : public Collector {
     friend MarkingWork;
     friend ConcurrentMarkingWork;
+    friend StealingMarkingWork;
 
 public:
     explicit TracingCollector(Allocator& allocator, CollectorResources& resources)
@@ -210,12 +212,12 @@ public:
     }
 
     GCStats& GetGCStats() override { return collectorResources.GetGCStats(); }
+    GCPacer& GetGCPacer() override { return collectorResources.GetGCPacer(); }
 
     virtual void UpdateGCStats();
     virtual uint16_t GetCurrentTagID() { std::abort(); }
 
     static const size_t MAX_MARKING_WORK_SIZE;
-    static const size_t MIN_MARKING_WORK_SIZE;
 
 protected:
     void RequestGCInternal(GCReason reason, bool async) override { collectorResources.RequestGC(reason, async); }
@@ -274,7 +276,6 @@ protected:
     // concurrent marking.
     void TracingImpl(WorkStack& workStack, bool parallel);
 
-    bool AddConcurrentTracingWork(RootSet& rs);
     virtual void EnumAndTagRawRoot(ObjectRef& root, RootSet& rootSet) const { std::abort(); }
 
 private:
@@ -0,0 +1,96 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+
+#ifndef MRT_WORK_STEALING_DEQUE_H
+#define MRT_WORK_STEALING_DEQUE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace MapleRuntime {
+// bounded chase-lev deque (see "Dynamic Circular Work-Stealing Deque", with fences from "Correct and Efficient
+// Work-Stealing for Weak Memory Models"). only the owner thread pushes and pops at bottom, other threads steal from
+// top. the deque does not grow, the owner should keep overflowed elements in its private storage.
+template<typename T, size_t capacity>
+class WorkStealingDeque {
+    static_assert((capacity & (capacity - 1)) == 0, "capacity of work-stealing deque must be power of 2");
+
+public:
+    WorkStealingDeque() = default;
+    ~WorkStealingDeque() = default;
+
+    // only called by owner, return false if deque is full.
+    bool Push(T elem)
+    {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_acquire);
+        if (b - t >= static_cast<int64_t>(capacity)) {
+            return false;
+        }
+        elems[b & MASK].store(elem, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    // only called by owner, return false if deque is empty or the last element is stolen.
+    bool Pop(T& elem)
+    {
+        int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = top.load(std::memory_order_relaxed);
+        if (t > b) {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+        elem = elems[b & MASK].load(std::memory_order_relaxed);
+        if (t == b) {
+            // race with thieves for the last element.
+            bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // called by any thread, return false if deque is empty or it loses the race.
+    bool Steal(T& elem)
+    {
+        int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b) {
+            return false;
+        }
+        elem = elems[t & MASK].load(std::memory_order_relaxed);
+        return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    // approximate size for stealing decision.
+    size_t Size() const
+    {
+        int64_t b = bottom.load(std::memory_order_relaxed);
+        int64_t t = top.load(std::memory_order_relaxed);
+        return b > t ? static_cast<size_t>(b - t) : 0;
+    }
+
+    bool Empty() const { return Size() == 0; }
+
+private:
+    static constexpr int64_t MASK = static_cast<int64_t>(capacity) - 1;
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+    // top and bottom are written by different threads, keep them in different cache lines.
+    std::atomic<int64_t> top = { 0 };
+    uint8_t topPadding[CACHE_LINE_SIZE - sizeof(std::atomic<int64_t>)] = { 0 };
+    std::atomic<int64_t> bottom = { 0 };
+    uint8_t bottomPadding[CACHE_LINE_SIZE - sizeof(std::atomic<int64_t>)] = { 0 };
+    std::atomic<T> elems[capacity];
+};
+} // namespace MapleRuntime
+#endif // MRT_WORK_STEALING_DEQUE_H
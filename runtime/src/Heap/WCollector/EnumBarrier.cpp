@@ -8,7 +8,7 @@
 #include "EnumBarrier.h"
 #include "Heap/Allocator/RegionSpace.h"
 #include "Mutator/Mutator.h"
-#include "ObjectModel/MArray.h"
+#include "ObjectModel/MArray.inline.h"
 #include "ObjectModel/RefField.inline.h"
 #include "Collector/CopyCollector.h"
 #if defined(CANGJIE_TSAN_SUPPORT)
@@ -128,6 +128,7 @@ void EnumBarrier::WriteReference(BaseObject* obj, RefField<false>& field, BaseOb
     std::atomic_thread_fence(std::memory_order_seq_cst);
     RefField<> newField = theCollector.GetAndTryTagRefField(ref);
     field.SetFieldValue(newField.GetFieldValue());
+    RememberWrite(obj, ref);
 }
 
 void EnumBarrier::WriteStaticRef(RefField<false>& field, BaseObject* ref) const
@@ -153,6 +154,7 @@ void EnumBarrier::WriteStruct(BaseObject* obj, MAddress dst, size_t dstLen, MAdd
     std::atomic_thread_fence(std::memory_order_seq_cst);
     CHECK_DETAIL(memcpy_s(reinterpret_cast<void*>(dst), dstLen, reinterpret_cast<void*>(src), srcLen) == EOK,
                  "memcpy_s failed");
+    RememberWrite(obj);
 
     if (obj != nullptr) {
         obj->ForEachRefInStruct(
@@ -223,6 +225,7 @@ BaseObject* EnumBarrier::AtomicSwapReference(BaseObject* obj, RefField<true>& fi
 {
     RefField<> newField = theCollector.GetAndTryTagRefField(newRef);
     MAddress oldValue = field.Exchange(newField.GetFieldValue(), order);
+    RememberWrite(obj, newRef);
     RefField<> oldField(oldValue);
     BaseObject* oldRef = ReadReference(nullptr, oldField);
     Mutator* mutator = Mutator::GetMutator();
@@ -242,6 +245,7 @@ void EnumBarrier::AtomicWriteReference(BaseObject* obj, RefField<true>& field, B
     BaseObject* oldRef = ReadReference(nullptr, oldField);
     RefField<> newField = theCollector.GetAndTryTagRefField(newRef);
     field.SetFieldValue(newField.GetFieldValue(), order);
+    RememberWrite(obj, newRef);
     Mutator* mutator = Mutator::GetMutator();
     mutator->RememberObjectInSatbBuffer(oldRef);
     mutator->RememberObjectInSatbBuffer(newRef);
@@ -264,6 +268,7 @@ bool EnumBarrier::CompareAndSwapReference(BaseObject* obj, RefField<true>& field
 
     while (oldVersion == oldRef) {
         if (field.CompareExchange(oldFieldValue, newField.GetFieldValue(), sOrder, fOrder)) {
+            RememberWrite(obj, newRef);
             Mutator* mutator = Mutator::GetMutator();
             mutator->RememberObjectInSatbBuffer(oldRef);
             mutator->RememberObjectInSatbBuffer(newRef);
@@ -277,6 +282,54 @@ bool EnumBarrier::CompareAndSwapReference(BaseObject* obj, RefField<true>& field
     return false;
 }
 
+void EnumBarrier::CopyRefArray(BaseObject* dstObj, MAddress dstField, MIndex dstSize, BaseObject* srcObj,
+                               MAddress srcField, MIndex srcSize) const
+{
+#if defined(MRT_DEBUG) && (MRT_DEBUG == 1)
+    TypeInfo* componentTi = static_cast<MArray*>(dstObj)->GetComponentTypeInfo();
+    if (!componentTi->IsObjectType() && !componentTi->IsInterface() && !componentTi->IsArrayType()) {
+        LOG(RTLOG_FATAL, "array %p type is not class", dstObj);
+        return;
+    }
+#endif
+    // arrays out of heap are copied without barriers by the per-element path.
+    if (dstField == srcField || !Heap::IsHeapAddress(dstObj)) {
+        IdleBarrier::CopyRefArray(dstObj, dstField, dstSize, srcObj, srcField, srcSize);
+        return;
+    }
+    Mutator* mutator = Mutator::GetMutator();
+    auto srcVisitor = [this, mutator](RefField<false>& field) {
+        RefField<> oldField(field);
+        RefField<> toBeUpdated(oldField);
+        BaseObject* target = ReadReference(nullptr, toBeUpdated);
+        mutator->RememberObjectInSatbBuffer(target);
+        RefField<> newField = theCollector.GetAndTryTagRefField(target);
+        if (newField.GetFieldValue() != oldField.GetFieldValue()) {
+            field.CompareExchange(oldField.GetFieldValue(), newField.GetFieldValue());
+        }
+    };
+    MArray* srcArray = static_cast<MArray*>(srcObj);
+    srcArray->VisitNonNullRefFieldsInRange(srcVisitor, srcField, srcField + srcSize);
+
+    auto dstVisitor = [this, mutator](RefField<false>& field) {
+        RefField<> oldField(field);
+        BaseObject* target = ReadReference(nullptr, oldField);
+        mutator->RememberObjectInSatbBuffer(target);
+    };
+    MArray* dstArray = static_cast<MArray*>(dstObj);
+    dstArray->VisitNonNullRefFieldsInRange(dstVisitor, dstField, dstField + srcSize);
+
+    CHECK_DETAIL(memmove_s(reinterpret_cast<void*>(dstField), dstSize, reinterpret_cast<void*>(srcField), srcSize) ==
+                     EOK,
+                 "memmove_s failed");
+    RememberWrite(dstObj);
+
+#if defined(CANGJIE_TSAN_SUPPORT)
+    Sanitizer::TsanWriteMemoryRange(reinterpret_cast<void*>(dstField), dstSize);
+    Sanitizer::TsanReadMemoryRange(reinterpret_cast<void*>(srcField), srcSize);
+#endif
+}
+
 void EnumBarrier::CopyStructArray(BaseObject* dstObj, MAddress dstField, MIndex dstSize, BaseObject* srcObj,
                                   MAddress srcField, MIndex srcSize) const
 {
@@ -298,7 +351,7 @@ void EnumBarrier::CopyStructArray(BaseObject* dstObj, MAddress dstField, MIndex
     }
 
     Mutator* mutator = Mutator::GetMutator();
-    RefFieldVisitor srcVisitor = [this, mutator](RefField<false>& field) {
+    auto srcVisitor = [this, mutator](RefField<false>& field) {
         RefField<> oldField(field);
         RefField<> toBeUpdated(oldField);
         BaseObject* target = ReadReference(nullptr, toBeUpdated);
@@ -309,19 +362,20 @@ void EnumBarrier::CopyStructArray(BaseObject* dstObj, MAddress dstField, MIndex
         }
     };
     MArray* srcArray = static_cast<MArray*>(srcObj);
-    srcArray->ForEachRefFieldInRange(srcVisitor, srcField, srcField + srcSize);
+    srcArray->VisitNonNullRefFieldsInRange(srcVisitor, srcField, srcField + srcSize);
 
-    RefFieldVisitor dstVisitor = [this, mutator](RefField<false>& field) {
+    auto dstVisitor = [this, mutator](RefField<false>& field) {
         RefField<> oldField(field);
         BaseObject* target = ReadReference(nullptr, oldField);
         mutator->RememberObjectInSatbBuffer(target);
     };
     MArray* dstArray = static_cast<MArray*>(dstObj);
-    dstArray->ForEachRefFieldInRange(dstVisitor, dstField, dstField + srcSize);
+    dstArray->VisitNonNullRefFieldsInRange(dstVisitor, dstField, dstField + srcSize);
 
     CHECK_DETAIL(memmove_s(reinterpret_cast<void*>(dstField), dstSize, reinterpret_cast<void*>(srcField), srcSize) ==
                      EOK,
                  "memmove_s failed");
+    RememberWrite(dstObj);
 
 #if defined(CANGJIE_TSAN_SUPPORT)
     Sanitizer::TsanWriteMemoryRange(reinterpret_cast<void*>(dstField), dstSize);
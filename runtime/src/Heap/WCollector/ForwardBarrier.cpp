@@ -11,7 +11,7 @@
 #include "Common/ScopedObjectLock.h"
 #include "Mutator/Mutator.h"
 #include "ObjectModel/Field.inline.h"
-#include "ObjectModel/MArray.h"
+#include "ObjectModel/MArray.inline.h"
 #include "ObjectModel/RefField.inline.h"
 #if defined(CANGJIE_TSAN_SUPPORT)
 #include "Sanitizer/SanitizerInterface.h"
@@ -104,6 +104,7 @@ void ForwardBarrier::AtomicWriteReference(BaseObject* obj, RefField<true>& field
 {
     RefField<> newField(newRef);
     field.SetFieldValue(newField.GetFieldValue(), order);
+    RememberWrite(obj, newRef);
     if (obj != nullptr) {
         DLOG(FBARRIER, "atomic write obj %p<%p>(%zu) ref@%p: %#zx", obj, obj->GetTypeInfo(), obj->GetSize(), &field,
              newField.GetFieldValue());
@@ -116,6 +117,7 @@ BaseObject* ForwardBarrier::AtomicSwapReference(BaseObject* obj, RefField<true>&
                                                 MemoryOrder order) const
 {
     MAddress oldValue = field.Exchange(newRef, order);
+    RememberWrite(obj, newRef);
     RefField<> oldField(oldValue);
     BaseObject* oldRef = ReadReference(nullptr, oldField);
     DLOG(BARRIER, "atomic swap obj %p<%p>(%zu) ref-field@%p: old %#zx(%p), new %#zx(%p)", obj, obj->GetTypeInfo(),
@@ -132,6 +134,7 @@ bool ForwardBarrier::CompareAndSwapReference(BaseObject* obj, RefField<true>& fi
     while (oldVersion == oldRef) {
         RefField<> newField(newRef);
         if (field.CompareExchange(oldFieldValue, newField.GetFieldValue(), succOrder, failOrder)) {
+            RememberWrite(obj, newRef);
             return true;
         }
         oldFieldValue = field.GetFieldValue(std::memory_order_seq_cst);
@@ -142,6 +145,34 @@ bool ForwardBarrier::CompareAndSwapReference(BaseObject* obj, RefField<true>& fi
     return false;
 }
 
+void ForwardBarrier::CopyRefArray(BaseObject* dstObj, MAddress dstField, MIndex dstSize, BaseObject* srcObj,
+                                  MAddress srcField, MIndex srcSize) const
+{
+#if defined(MRT_DEBUG) && (MRT_DEBUG == 1)
+    TypeInfo* componentTi = static_cast<MArray*>(dstObj)->GetComponentTypeInfo();
+    if (!componentTi->IsObjectType() && !componentTi->IsInterface() && !componentTi->IsArrayType()) {
+        LOG(RTLOG_FATAL, "array %p type is not class", dstObj);
+        return;
+    }
+#endif
+    // arrays out of heap are copied without barriers by the per-element path.
+    if (dstField == srcField || !Heap::IsHeapAddress(dstObj)) {
+        IdleBarrier::CopyRefArray(dstObj, dstField, dstSize, srcObj, srcField, srcSize);
+        return;
+    }
+    MArray* srcArray = static_cast<MArray*>(srcObj);
+    auto srcVisitor = [this, srcArray](RefField<false>& field) { (void)ReadReference(srcArray, field); };
+    srcArray->VisitNonNullRefFieldsInRange(srcVisitor, srcField, srcField + srcSize);
+
+    CHECK(memmove_s(reinterpret_cast<void*>(dstField), dstSize, reinterpret_cast<void*>(srcField), srcSize) == EOK);
+    RememberWrite(dstObj);
+
+#if defined(CANGJIE_TSAN_SUPPORT)
+    Sanitizer::TsanWriteMemoryRange(reinterpret_cast<void*>(dstField), dstSize);
+    Sanitizer::TsanReadMemoryRange(reinterpret_cast<void*>(srcField), srcSize);
+#endif
+}
+
 void ForwardBarrier::CopyStructArray(BaseObject* dstObj, MAddress dstField, MIndex dstSize, BaseObject* srcObj,
                                      MAddress srcField, MIndex srcSize) const
 {
@@ -162,10 +193,11 @@ void ForwardBarrier::CopyStructArray(BaseObject* dstObj, MAddress dstField, MInd
     }
 
     MArray* srcArray = static_cast<MArray*>(srcObj);
-    RefFieldVisitor srcVisitor = [this, srcArray](RefField<false>& field) { (void)ReadReference(srcArray, field); };
-    srcArray->ForEachRefFieldInRange(srcVisitor, srcField, srcField + srcSize);
+    auto srcVisitor = [this, srcArray](RefField<false>& field) { (void)ReadReference(srcArray, field); };
+    srcArray->VisitNonNullRefFieldsInRange(srcVisitor, srcField, srcField + srcSize);
 
     CHECK(memmove_s(reinterpret_cast<void*>(dstField), dstSize, reinterpret_cast<void*>(srcField), srcSize) == EOK);
+    RememberWrite(dstObj);
 
 #if defined(CANGJIE_TSAN_SUPPORT)
     Sanitizer::TsanWriteMemoryRange(reinterpret_cast<void*>(dstField), dstSize);
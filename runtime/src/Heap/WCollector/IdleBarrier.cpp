@@ -8,7 +8,7 @@
 #include "IdleBarrier.h"
 
 #include "Mutator/Mutator.h"
-#include "ObjectModel/MArray.h"
+#include "ObjectModel/MArray.inline.h"
 #include "ObjectModel/RefField.inline.h"
 #if defined(CANGJIE_TSAN_SUPPORT)
 #include "Sanitizer/SanitizerInterface.h"
@@ -104,6 +104,7 @@ void IdleBarrier::AtomicWriteReference(BaseObject* obj, RefField<true>& field, B
         DLOG(BARRIER, "atomic write static ref@%p: %p", &field, newRef);
     }
     field.SetTargetObject(newRef, order);
+    RememberWrite(obj, newRef);
 }
 
 BaseObject* IdleBarrier::AtomicSwapReference(BaseObject* obj, RefField<true>& field, BaseObject* newRef,
@@ -111,6 +112,7 @@ BaseObject* IdleBarrier::AtomicSwapReference(BaseObject* obj, RefField<true>& fi
 {
     // newRef must be the latest versions.
     MAddress oldValue = field.Exchange(newRef, order);
+    RememberWrite(obj, newRef);
     RefField<> oldField(oldValue);
     BaseObject* oldRef = ReadReference(nullptr, oldField);
     DLOG(BARRIER, "atomic swap obj %p<%p>(%zu) ref@%p: old %#zx(%p), new %#zx(%p)", obj, obj->GetTypeInfo(),
@@ -129,6 +131,7 @@ bool IdleBarrier::CompareAndSwapReference(BaseObject* obj, RefField<true>& field
     while (oldVersion == oldRef) {
         RefField<> newField(newRef);
         if (field.CompareExchange(oldFieldValue, newField.GetFieldValue(), sOrder, fOrder)) {
+            RememberWrite(obj, newRef);
             return true;
         }
         oldFieldValue = field.GetFieldValue(std::memory_order_seq_cst);
@@ -142,11 +145,13 @@ void IdleBarrier::WriteReference(BaseObject* obj, RefField<false>& field, BaseOb
 {
     DLOG(BARRIER, "write obj %p ref@%p: %p => %p", obj, &field, field.GetTargetObject(), ref);
     field.SetTargetObject(ref);
+    RememberWrite(obj, ref);
 }
 
 void IdleBarrier::WriteStruct(BaseObject* obj, MAddress dst, size_t dstLen, MAddress src, size_t srcLen) const
 {
     CHECK(memcpy_s(reinterpret_cast<void*>(dst), dstLen, reinterpret_cast<void*>(src), srcLen) == EOK);
+    RememberWrite(obj);
 #if defined(CANGJIE_TSAN_SUPPORT)
     CHECK(srcLen == dstLen);
     Sanitizer::TsanWriteMemoryRange(reinterpret_cast<void*>(dst), dstLen);
@@ -233,12 +238,13 @@ void IdleBarrier::CopyStructArray(BaseObject* dstObj, MAddress dstField, MIndex
     }
 #endif
     MArray* srcArray = static_cast<MArray*>(srcObj);
-    RefFieldVisitor srcVisitor = [this, srcArray](RefField<false>& field) { (void)ReadReference(srcArray, field); };
-    srcArray->ForEachRefFieldInRange(srcVisitor, srcField, srcField + srcSize);
+    auto srcVisitor = [this, srcArray](RefField<false>& field) { (void)ReadReference(srcArray, field); };
+    srcArray->VisitNonNullRefFieldsInRange(srcVisitor, srcField, srcField + srcSize);
 
     CHECK_DETAIL(memmove_s(reinterpret_cast<void*>(dstField), dstSize, reinterpret_cast<void*>(srcField), srcSize) ==
                      EOK,
                  "memmove_s failed");
+    RememberWrite(dstObj);
 
 #if defined(CANGJIE_TSAN_SUPPORT)
     Sanitizer::TsanWriteMemoryRange(reinterpret_cast<void*>(dstField), dstSize);
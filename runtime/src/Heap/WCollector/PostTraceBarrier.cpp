@@ -8,7 +8,7 @@
 #include "PostTraceBarrier.h"
 
 #include "Mutator/Mutator.h"
-#include "ObjectModel/MArray.h"
+#include "ObjectModel/MArray.inline.h"
 #include "ObjectModel/RefField.inline.h"
 #if defined(CANGJIE_TSAN_SUPPORT)
 #include "Sanitizer/SanitizerInterface.h"
@@ -100,6 +100,7 @@ void PostTraceBarrier::WriteReference(BaseObject* obj, RefField<false>& field, B
     DLOG(BARRIER, "write obj %p ref-field@%p: %#zx -> %p", obj, &field, tmpField.GetFieldValue(), ref);
     RefField<> newField = theCollector.GetAndTryTagRefField(ref);
     field.SetFieldValue(newField.GetFieldValue());
+    RememberWrite(obj, ref);
 }
 
 void PostTraceBarrier::WriteStaticRef(RefField<false>& field, BaseObject* ref) const
@@ -112,6 +113,7 @@ void PostTraceBarrier::WriteStruct(BaseObject* obj, MAddress dst, size_t dstLen,
 {
     CHECK(obj != nullptr);
     CHECK(memcpy_s(reinterpret_cast<void*>(dst), dstLen, reinterpret_cast<void*>(src), srcLen) == EOK);
+    RememberWrite(obj);
 
     if (obj != nullptr) {
         obj->ForEachRefInStruct(
@@ -190,6 +192,7 @@ void PostTraceBarrier::AtomicWriteReference(BaseObject* obj, RefField<true>& fie
     (void)oldValue;
     RefField<> newField = theCollector.GetAndTryTagRefField(newRef);
     field.SetFieldValue(newField.GetFieldValue(), order);
+    RememberWrite(obj, newRef);
     if (obj != nullptr) {
         DLOG(TBARRIER, "atomic write obj %p<%p>(%zu) ref@%p: %#zx -> %#zx", obj, obj->GetTypeInfo(), obj->GetSize(),
              &field, oldValue, newField.GetFieldValue());
@@ -203,6 +206,7 @@ BaseObject* PostTraceBarrier::AtomicSwapReference(BaseObject* obj, RefField<true
 {
     RefField<> newField = theCollector.GetAndTryTagRefField(newRef);
     MAddress oldValue = field.Exchange(newField.GetFieldValue(), order);
+    RememberWrite(obj, newRef);
     RefField<> oldField(oldValue);
     BaseObject* oldRef = ReadReference(nullptr, oldField);
     DLOG(TRACE, "atomic swap obj %p<%p>(%zu) ref-field@%p: old %#zx(%p), new %#zx(%p)", obj, obj->GetTypeInfo(),
@@ -219,6 +223,7 @@ bool PostTraceBarrier::CompareAndSwapReference(BaseObject* obj, RefField<true>&
     RefField<> newField = theCollector.GetAndTryTagRefField(newRef);
     while (oldVersion == oldRef) {
         if (field.CompareExchange(oldFieldValue, newField.GetFieldValue(), succOrder, failOrder)) {
+            RememberWrite(obj, newRef);
             return true;
         }
         oldFieldValue = field.GetFieldValue(std::memory_order_seq_cst);
@@ -228,6 +233,49 @@ bool PostTraceBarrier::CompareAndSwapReference(BaseObject* obj, RefField<true>&
     return false;
 }
 
+void PostTraceBarrier::CopyRefArray(BaseObject* dstObj, MAddress dstField, MIndex dstSize, BaseObject* srcObj,
+                                    MAddress srcField, MIndex srcSize) const
+{
+#if defined(MRT_DEBUG) && (MRT_DEBUG == 1)
+    TypeInfo* componentTi = static_cast<MArray*>(dstObj)->GetComponentTypeInfo();
+    if (!componentTi->IsObjectType() && !componentTi->IsInterface() && !componentTi->IsArrayType()) {
+        LOG(RTLOG_FATAL, "array %p type is not class", dstObj);
+        return;
+    }
+#endif
+    // arrays out of heap are copied without barriers by the per-element path.
+    if (dstField == srcField || !Heap::IsHeapAddress(dstObj)) {
+        IdleBarrier::CopyRefArray(dstObj, dstField, dstSize, srcObj, srcField, srcSize);
+        return;
+    }
+    auto srcVisitor = [this](RefField<false>& field) {
+        RefField<> oldField(field);
+        if (theCollector.IsCurrentPointer(oldField)) {
+            return;
+        }
+        RefField<> toBeUpdated(oldField);
+        BaseObject* target = ReadReference(nullptr, toBeUpdated);
+        RefField<> newField = theCollector.GetAndTryTagRefField(target);
+        if (newField.GetFieldValue() != oldField.GetFieldValue()) {
+            field.CompareExchange(oldField.GetFieldValue(), newField.GetFieldValue());
+        }
+    };
+    if (!Heap::IsHeapAddress(srcObj)) {
+        MArray* srcArray = static_cast<MArray*>(srcObj);
+        srcArray->VisitNonNullRefFieldsInRange(srcVisitor, srcField, srcField + srcSize);
+    }
+
+    CHECK_DETAIL(memmove_s(reinterpret_cast<void*>(dstField), dstSize, reinterpret_cast<void*>(srcField), srcSize) ==
+                     EOK,
+                 "memmove_s failed");
+    RememberWrite(dstObj);
+
+#if defined(CANGJIE_TSAN_SUPPORT)
+    Sanitizer::TsanWriteMemoryRange(reinterpret_cast<void*>(dstField), dstSize);
+    Sanitizer::TsanReadMemoryRange(reinterpret_cast<void*>(srcField), srcSize);
+#endif
+}
+
 void PostTraceBarrier::CopyStructArray(BaseObject* dstObj, MAddress dstField, MIndex dstSize, BaseObject* srcObj,
                                        MAddress srcField, MIndex srcSize) const
 {
@@ -242,8 +290,11 @@ void PostTraceBarrier::CopyStructArray(BaseObject* dstObj, MAddress dstField, MI
     }
 #endif
     bool inHeap = Heap::IsHeapAddress(srcObj);
-    RefFieldVisitor srcVisitor = [this](RefField<false>& field) {
+    auto srcVisitor = [this](RefField<false>& field) {
         RefField<> oldField(field);
+        if (theCollector.IsCurrentPointer(oldField)) {
+            return;
+        }
         RefField<> toBeUpdated(oldField);
         BaseObject* target = ReadReference(nullptr, toBeUpdated);
         RefField<> newField = theCollector.GetAndTryTagRefField(target);
@@ -253,11 +304,12 @@ void PostTraceBarrier::CopyStructArray(BaseObject* dstObj, MAddress dstField, MI
     };
     MArray* srcArray = static_cast<MArray*>(srcObj);
     if (!inHeap) {
-        srcArray->ForEachRefFieldInRange(srcVisitor, srcField, srcField + srcSize);
+        srcArray->VisitNonNullRefFieldsInRange(srcVisitor, srcField, srcField + srcSize);
     }
     CHECK_DETAIL(memmove_s(reinterpret_cast<void*>(dstField), dstSize, reinterpret_cast<void*>(srcField), srcSize) ==
                      EOK,
                  "memmove_s failed");
+    RememberWrite(dstObj);
 
 #if defined(CANGJIE_TSAN_SUPPORT)
     Sanitizer::TsanWriteMemoryRange(reinterpret_cast<void*>(dstField), dstSize);
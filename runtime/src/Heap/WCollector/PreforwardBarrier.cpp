@@ -11,7 +11,7 @@
 #include "Common/ScopedObjectLock.h"
 #include "Mutator/Mutator.h"
 #include "ObjectModel/Field.inline.h"
-#include "ObjectModel/MArray.h"
+#include "ObjectModel/MArray.inline.h"
 #include "ObjectModel/RefField.inline.h"
 #if defined(CANGJIE_TSAN_SUPPORT)
 #include "Sanitizer/SanitizerInterface.h"
@@ -112,11 +112,25 @@ BaseObject* PreforwardBarrier::AtomicReadReference(BaseObject* obj, RefField<tru
     return target;
 }
 
+// young regions are demoted concurrently in preforward phase, so written objects are always remembered.
+void PreforwardBarrier::WriteReference(BaseObject* obj, RefField<false>& field, BaseObject* ref) const
+{
+    IdleBarrier::WriteReference(obj, field, ref);
+    RememberObject(obj);
+}
+
+void PreforwardBarrier::WriteStruct(BaseObject* obj, MAddress dst, size_t dstLen, MAddress src, size_t srcLen) const
+{
+    IdleBarrier::WriteStruct(obj, dst, dstLen, src, srcLen);
+    RememberObject(obj);
+}
+
 void PreforwardBarrier::AtomicWriteReference(BaseObject* obj, RefField<true>& field, BaseObject* newRef,
                                              MemoryOrder order) const
 {
     RefField<> newField(newRef);
     field.SetFieldValue(newField.GetFieldValue(), order);
+    RememberObject(obj);
     if (obj != nullptr) {
         DLOG(PBARRIER, "atomic write obj %p<%p>(%zu) ref@%p: %#zx", obj, obj->GetTypeInfo(), obj->GetSize(), &field,
              newField.GetFieldValue());
@@ -129,6 +143,7 @@ BaseObject* PreforwardBarrier::AtomicSwapReference(BaseObject* obj, RefField<tru
                                                    MemoryOrder order) const
 {
     MAddress oldValue = field.Exchange(newRef, order);
+    RememberObject(obj);
     RefField<> oldField(oldValue);
     BaseObject* oldRef = ReadReference(nullptr, oldField);
     DLOG(BARRIER, "atomic swap obj %p<%p>(%zu) ref@%p: old %#zx(%p), new %#zx(%p)", obj, obj->GetTypeInfo(),
@@ -145,6 +160,7 @@ bool PreforwardBarrier::CompareAndSwapReference(BaseObject* obj, RefField<true>&
     while (oldVersion == oldRef) {
         RefField<> newField(newRef);
         if (field.CompareExchange(oldFieldValue, newField.GetFieldValue(), succOrder, failOrder)) {
+            RememberObject(obj);
             return true;
         }
         oldFieldValue = field.GetFieldValue(std::memory_order_seq_cst);
@@ -155,6 +171,34 @@ bool PreforwardBarrier::CompareAndSwapReference(BaseObject* obj, RefField<true>&
     return false;
 }
 
+void PreforwardBarrier::CopyRefArray(BaseObject* dstObj, MAddress dstField, MIndex dstSize, BaseObject* srcObj,
+                                     MAddress srcField, MIndex srcSize) const
+{
+#if defined(MRT_DEBUG) && (MRT_DEBUG == 1)
+    TypeInfo* componentTi = static_cast<MArray*>(dstObj)->GetComponentTypeInfo();
+    if (!componentTi->IsObjectType() && !componentTi->IsInterface() && !componentTi->IsArrayType()) {
+        LOG(RTLOG_FATAL, "array %p type is not class", dstObj);
+        return;
+    }
+#endif
+    // arrays out of heap are copied without barriers by the per-element path.
+    if (dstField == srcField || !Heap::IsHeapAddress(dstObj)) {
+        IdleBarrier::CopyRefArray(dstObj, dstField, dstSize, srcObj, srcField, srcSize);
+        return;
+    }
+    MArray* srcArray = static_cast<MArray*>(srcObj);
+    auto srcVisitor = [this, srcArray](RefField<false>& field) { (void)ReadReference(srcArray, field); };
+    srcArray->VisitNonNullRefFieldsInRange(srcVisitor, srcField, srcField + srcSize);
+
+    CHECK(memmove_s(reinterpret_cast<void*>(dstField), dstSize, reinterpret_cast<void*>(srcField), srcSize) == EOK);
+    RememberObject(dstObj);
+
+#if defined(CANGJIE_TSAN_SUPPORT)
+    Sanitizer::TsanWriteMemoryRange(reinterpret_cast<void*>(dstField), dstSize);
+    Sanitizer::TsanReadMemoryRange(reinterpret_cast<void*>(srcField), srcSize);
+#endif
+}
+
 void PreforwardBarrier::CopyStructArray(BaseObject* dstObj, MAddress dstField, MIndex dstSize, BaseObject* srcObj,
                                         MAddress srcField, MIndex srcSize) const
 {
@@ -175,10 +219,11 @@ void PreforwardBarrier::CopyStructArray(BaseObject* dstObj, MAddress dstField, M
     }
 
     MArray* srcArray = static_cast<MArray*>(srcObj);
-    RefFieldVisitor srcVisitor = [this, srcArray](RefField<false>& field) { (void)ReadReference(srcArray, field); };
-    srcArray->ForEachRefFieldInRange(srcVisitor, srcField, srcField + srcSize);
+    auto srcVisitor = [this, srcArray](RefField<false>& field) { (void)ReadReference(srcArray, field); };
+    srcArray->VisitNonNullRefFieldsInRange(srcVisitor, srcField, srcField + srcSize);
 
     CHECK(memmove_s(reinterpret_cast<void*>(dstField), dstSize, reinterpret_cast<void*>(srcField), srcSize) == EOK);
+    RememberObject(dstObj);
 
 #if defined(CANGJIE_TSAN_SUPPORT)
     Sanitizer::TsanWriteMemoryRange(reinterpret_cast<void*>(dstField), dstSize);
@@ -8,7 +8,7 @@
 #include "TraceBarrier.h"
 #include "Heap/Allocator/RegionSpace.h"
 #include "Mutator/Mutator.h"
-#include "ObjectModel/MArray.h"
+#include "ObjectModel/MArray.inline.h"
 #include "ObjectModel/RefField.inline.h"
 #include "Collector/CopyCollector.h"
 #if defined(CANGJIE_TSAN_SUPPORT)
@@ -121,6 +121,7 @@ void TraceBarrier::WriteReference(BaseObject* obj, RefField<false>& field, BaseO
     std::atomic_thread_fence(std::memory_order_seq_cst);
     RefField<> newField = theCollector.GetAndTryTagRefField(ref);
     field.SetFieldValue(newField.GetFieldValue());
+    RememberWrite(obj, ref);
 }
 
 void TraceBarrier::WriteStaticRef(RefField<false>& field, BaseObject* ref) const
@@ -146,6 +147,7 @@ void TraceBarrier::WriteStruct(BaseObject* obj, MAddress dst, size_t dstLen, MAd
     }
     std::atomic_thread_fence(std::memory_order_seq_cst);
     CHECK(memcpy_s(reinterpret_cast<void*>(dst), dstLen, reinterpret_cast<void*>(src), srcLen) == EOK);
+    RememberWrite(obj);
 
     if (obj != nullptr) {
         obj->ForEachRefInStruct(
@@ -213,6 +215,7 @@ void TraceBarrier::AtomicWriteReference(BaseObject* obj, RefField<true>& field,
     BaseObject* oldRef = ReadReference(nullptr, oldField);
     RefField<> newField = theCollector.GetAndTryTagRefField(newRef);
     field.SetFieldValue(newField.GetFieldValue(), order);
+    RememberWrite(obj, newRef);
     Mutator* mutator = Mutator::GetMutator();
     mutator->RememberObjectInSatbBuffer(oldRef);
     if (obj != nullptr) {
@@ -228,6 +231,7 @@ BaseObject* TraceBarrier::AtomicSwapReference(BaseObject* obj, RefField<true>& f
 {
     RefField<> newField = theCollector.GetAndTryTagRefField(newRef);
     MAddress oldValue = field.Exchange(newField.GetFieldValue(), order);
+    RememberWrite(obj, newRef);
     RefField<> oldField(oldValue);
     BaseObject* oldRef = ReadReference(nullptr, oldField);
     Mutator* mutator = Mutator::GetMutator();
@@ -247,6 +251,7 @@ bool TraceBarrier::CompareAndSwapReference(BaseObject* obj, RefField<true>& fiel
 
     while (oldVersion == oldRef) {
         if (field.CompareExchange(oldFieldValue, newField.GetFieldValue(), succOrder, failOrder)) {
+            RememberWrite(obj, newRef);
             Mutator* mutator = Mutator::GetMutator();
             mutator->RememberObjectInSatbBuffer(oldRef);
             return true;
@@ -259,6 +264,57 @@ bool TraceBarrier::CompareAndSwapReference(BaseObject* obj, RefField<true>& fiel
     return false;
 }
 
+void TraceBarrier::CopyRefArray(BaseObject* dstObj, MAddress dstField, MIndex dstSize, BaseObject* srcObj,
+                                MAddress srcField, MIndex srcSize) const
+{
+#if defined(MRT_DEBUG) && (MRT_DEBUG == 1)
+    TypeInfo* componentTi = static_cast<MArray*>(dstObj)->GetComponentTypeInfo();
+    if (!componentTi->IsObjectType() && !componentTi->IsInterface() && !componentTi->IsArrayType()) {
+        LOG(RTLOG_FATAL, "array %p type is not class", dstObj);
+        return;
+    }
+#endif
+    // arrays out of heap are copied without barriers by the per-element path.
+    if (dstField == srcField || !Heap::IsHeapAddress(dstObj)) {
+        IdleBarrier::CopyRefArray(dstObj, dstField, dstSize, srcObj, srcField, srcSize);
+        return;
+    }
+    Mutator* mutator = Mutator::GetMutator();
+    auto srcVisitor = [this](RefField<false>& field) {
+        RefField<> oldField(field);
+        // already tagged for this gc, tagging again would yield the same value.
+        if (theCollector.IsCurrentPointer(oldField)) {
+            return;
+        }
+        RefField<> toBeUpdated(oldField);
+        BaseObject* target = ReadReference(nullptr, toBeUpdated);
+        RefField<> newField = theCollector.GetAndTryTagRefField(target);
+        if (newField.GetFieldValue() != oldField.GetFieldValue()) {
+            field.CompareExchange(oldField.GetFieldValue(), newField.GetFieldValue());
+        }
+    };
+    MArray* srcArray = static_cast<MArray*>(srcObj);
+    srcArray->VisitNonNullRefFieldsInRange(srcVisitor, srcField, srcField + srcSize);
+
+    auto dstVisitor = [this, mutator](RefField<false>& field) {
+        RefField<> oldField(field);
+        BaseObject* target = ReadReference(nullptr, oldField);
+        mutator->RememberObjectInSatbBuffer(target);
+    };
+    MArray* dstArray = static_cast<MArray*>(dstObj);
+    dstArray->VisitNonNullRefFieldsInRange(dstVisitor, dstField, dstField + srcSize);
+
+    CHECK_DETAIL(memmove_s(reinterpret_cast<void*>(dstField), dstSize, reinterpret_cast<void*>(srcField), srcSize) ==
+                     EOK,
+                 "memmove_s failed");
+    RememberWrite(dstObj);
+
+#if defined(CANGJIE_TSAN_SUPPORT)
+    Sanitizer::TsanWriteMemoryRange(reinterpret_cast<void*>(dstField), dstSize);
+    Sanitizer::TsanReadMemoryRange(reinterpret_cast<void*>(srcField), srcSize);
+#endif
+}
+
 void TraceBarrier::CopyStructArray(BaseObject* dstObj, MAddress dstField, MIndex dstSize, BaseObject* srcObj,
                                    MAddress srcField, MIndex srcSize) const
 {
@@ -273,8 +329,12 @@ void TraceBarrier::CopyStructArray(BaseObject* dstObj, MAddress dstField, MIndex
     }
 #endif
     Mutator* mutator = Mutator::GetMutator();
-    RefFieldVisitor srcVisitor = [this](RefField<false>& field) {
+    auto srcVisitor = [this](RefField<false>& field) {
         RefField<> oldField(field);
+        // already tagged for this gc, tagging again would yield the same value.
+        if (theCollector.IsCurrentPointer(oldField)) {
+            return;
+        }
         RefField<> toBeUpdated(oldField);
         BaseObject* target = ReadReference(nullptr, toBeUpdated);
         RefField<> newField = theCollector.GetAndTryTagRefField(target);
@@ -283,19 +343,20 @@ void TraceBarrier::CopyStructArray(BaseObject* dstObj, MAddress dstField, MIndex
         }
     };
     MArray* srcArray = static_cast<MArray*>(srcObj);
-    srcArray->ForEachRefFieldInRange(srcVisitor, srcField, srcField + srcSize);
+    srcArray->VisitNonNullRefFieldsInRange(srcVisitor, srcField, srcField + srcSize);
 
-    RefFieldVisitor dstVisitor = [this, mutator](RefField<false>& field) {
+    auto dstVisitor = [this, mutator](RefField<false>& field) {
         RefField<> oldField(field);
         BaseObject* target = ReadReference(nullptr, oldField);
         mutator->RememberObjectInSatbBuffer(target);
     };
     MArray* dstArray = static_cast<MArray*>(dstObj);
-    dstArray->ForEachRefFieldInRange(dstVisitor, dstField, dstField + srcSize);
+    dstArray->VisitNonNullRefFieldsInRange(dstVisitor, dstField, dstField + srcSize);
 
     CHECK_DETAIL(memmove_s(reinterpret_cast<void*>(dstField), dstSize, reinterpret_cast<void*>(srcField), srcSize) ==
                      EOK,
                  "memmove_s failed");
+    RememberWrite(dstObj);
 
 #if defined(CANGJIE_TSAN_SUPPORT)
     Sanitizer::TsanWriteMemoryRange(reinterpret_cast<void*>(dstField), dstSize);
@@ -7,6 +7,9 @@
 
 #include "WCollector.h"
 
+#include <set>
+#include <stack>
+
 #include "Concurrency/Concurrency.h"
 #include "Mutator/MutatorManager.h"
 
@@ -238,6 +241,10 @@ void WCollector::TraceObjectRefFields(BaseObject* obj, WorkStack& workStack)
     auto refFunc = [this, obj, &workStack](RefField<>& field) { TraceRefField(obj, field, workStack); };
 
     obj->ForEachRefField(refFunc);
+    if (UNLIKELY(RememberedSet::IsEnabled())) {
+        // traced objects are rebuilt into remembered set, since full gc starts with a clean one.
+        RememberedSet::RecordObject(obj);
+    }
 }
 
 BaseObject* WCollector::GetAndTryTagObj(BaseObject* obj, RefField<>& field)
@@ -266,6 +273,10 @@ BaseObject* WCollector::GetAndTryTagObj(BaseObject* obj, RefField<>& field)
         DLOG(TRACE, "trace obj %p ref@%p: %#zx => %#zx->%p<%p>(%zu)", obj, &field, oldField.GetFieldValue(),
             newField.GetFieldValue(), latest, latest->GetTypeInfo(), latest->GetSize());
     }
+    if (UNLIKELY(RememberedSet::IsEnabled())) {
+        // the holder is a weakref whose ref-fields are not traced, remember it by its referent.
+        RememberedSet::RecordObject(obj);
+    }
     return latest;
 }
 
@@ -317,6 +328,9 @@ void WCollector::TraceHeap()
     WorkStack workStack = NewWorkStack();
     // assemble garbage candidates for tracing.
     reinterpret_cast<RegionSpace&>(theAllocator).AssembleGarbageCandidates();
+    if (RememberedSet::IsEnabled()) {
+        reinterpret_cast<RegionSpace&>(theAllocator).ResetRememberedSet();
+    }
 
     {
         MRT_PHASE_TIMER("enum roots & update old pointers within");
@@ -359,6 +373,10 @@ void WCollector::Preforward()
     {
         ScopedLightSync scopedLightSync("Preforward", true, GCPhase::GC_PHASE_PREFORWARD);
     }
+    if (RememberedSet::IsEnabled()) {
+        // exempted and raw-pointer pinned regions survive full gc in place, they are old from now on.
+        reinterpret_cast<RegionSpace&>(theAllocator).DemoteYoungRegions();
+    }
 
     GCThreadPool* threadPool = GetThreadPool();
     MRT_ASSERT(threadPool != nullptr, "thread pool is null");
@@ -372,8 +390,200 @@ void WCollector::Preforward()
     threadPool->WaitFinish();
 }
 
+BaseObject* WCollector::PromoteYoungObject(BaseObject* obj, WorkStack& workStack)
+{
+    // young gc runs in stw, so forwarding state is simply kept in header of from-object.
+    if (obj->IsForwarded()) {
+        return reinterpret_cast<BaseObject*>(obj->GetTypeInfo());
+    }
+
+    RegionSpace& space = reinterpret_cast<RegionSpace&>(theAllocator);
+    size_t size = RegionSpace::GetAllocSize(*obj);
+    // regions allocated by gc thread are old.
+    BaseObject* toObj = reinterpret_cast<BaseObject*>(space.Allocate(obj->GetSize(), AllocType::MOVEABLE_OBJECT));
+    CHECK_DETAIL(toObj != nullptr, "promote obj %p<%p>(%zu) failed", obj, obj->GetTypeInfo(), size);
+    CopyObject(*obj, *toObj, size);
+    obj->SetClassInfo(reinterpret_cast<TypeInfo*>(toObj));
+    obj->SetStateCode(ObjectState::FORWARDED);
+    DLOG(FORWARD, "promote obj %p<%p>(%zu) to %p", obj, toObj->GetTypeInfo(), size, toObj);
+    if (toObj->HasRefField()) {
+        workStack.push_back(toObj);
+    }
+    return toObj;
+}
+
+void WCollector::PromoteRefField(RefField<>& field, WorkStack& workStack)
+{
+    RefField<> oldField(field);
+    // tagged pointers never refer to young objects, leave them for full gc.
+    if (oldField.IsTagged()) {
+        return;
+    }
+    BaseObject* target = oldField.GetTargetObject();
+    if (!RememberedSet::InYoungRegion(target)) {
+        return;
+    }
+    BaseObject* toObj = PromoteYoungObject(target, workStack);
+    field.SetTargetObject(toObj);
+}
+
+void WCollector::PromoteObjectRefFields(BaseObject* obj, WorkStack& workStack)
+{
+    if (!obj->HasRefField()) {
+        return;
+    }
+    RefFieldVisitor visitor = [this, &workStack](RefField<>& field) { PromoteRefField(field, workStack); };
+    obj->ForEachRefField(visitor);
+    // referents are kept alive by young gc.
+    if (UNLIKELY(obj->IsWeakRef())) {
+        visitor(*reinterpret_cast<RefField<>*>(reinterpret_cast<uintptr_t>(obj) + sizeof(TypeInfo*)));
+    }
+}
+
+void WCollector::PromoteMutatorRoots(WorkStack& workStack)
+{
+    std::set<BaseObject*> stackObjects;
+    std::stack<BaseObject*> stackObjectStack;
+    RefFieldVisitor refVisitor = [this, &workStack](RefField<>& field) { PromoteRefField(field, workStack); };
+    // objects allocated on stack are not in heap, but their ref-fields are roots.
+    auto promoteStackObjects = [&stackObjects, &stackObjectStack, &refVisitor](Mutator& mutator, BaseObject* obj) {
+        if (!mutator.IsStackAddr(reinterpret_cast<uintptr_t>(obj)) ||
+            stackObjects.find(obj) != stackObjects.end()) {
+            return;
+        }
+        stackObjectStack.push(obj);
+        while (!stackObjectStack.empty()) {
+            BaseObject* stackObj = stackObjectStack.top();
+            stackObjectStack.pop();
+            if (!stackObjects.insert(stackObj).second || !stackObj->IsValidObject() || !stackObj->HasRefField()) {
+                continue;
+            }
+            stackObj->ForEachRefField([&mutator, &stackObjectStack, &refVisitor](RefField<>& field) {
+                BaseObject* target = field.GetTargetObject();
+                if (mutator.IsStackAddr(reinterpret_cast<uintptr_t>(target))) {
+                    stackObjectStack.push(target);
+                } else {
+                    refVisitor(field);
+                }
+            });
+        }
+    };
+
+    MutatorManager::Instance().VisitAllMutators([&](Mutator& mutator) {
+        RootVisitor rootVisitor = [&](ObjectRef& root) {
+            BaseObject* obj = root.object;
+            if (RememberedSet::InYoungRegion(obj)) {
+                root.object = PromoteYoungObject(obj, workStack);
+            } else {
+                promoteStackObjects(mutator, obj);
+            }
+        };
+        DerivedPtrVisitor derivedPtrVisitor = [this, &workStack](BasePtrType basePtr, DerivedPtrType& derivedPtr) {
+            BaseObject* fromVersion = reinterpret_cast<BaseObject*>(basePtr);
+            if (!RememberedSet::InYoungRegion(fromVersion)) {
+                return;
+            }
+            BaseObject* toVersion = PromoteYoungObject(fromVersion, workStack);
+            derivedPtr = reinterpret_cast<BasePtrType>(toVersion) + (derivedPtr - basePtr);
+        };
+        mutator.VisitHeapReferences(rootVisitor, derivedPtrVisitor);
+    });
+}
+
+bool WCollector::CollectYoungSpace()
+{
+    ScopedEntryHiTrace hiTrace("CJRT_GC_YOUNG");
+    MRT_PHASE_TIMER("Collect young space");
+    RegionSpace& space = reinterpret_cast<RegionSpace&>(theAllocator);
+    GCStats& stats = GetGCStats();
+    ScopedStopTheWorld stw("young-gc");
+
+    // young objects pinned by raw pointers can not be moved.
+    if (space.HasRawPointerYoungRegion()) {
+        VLOG(REPORT, "young gc falls back to full gc: young objects are pinned by raw pointers");
+        return false;
+    }
+    // in the worst case all young objects survive, make sure they can be promoted.
+    size_t allocatedBytes = space.AllocatedBytes();
+    size_t freeBytes = space.GetMaxCapacity() > allocatedBytes ? space.GetMaxCapacity() - allocatedBytes : 0;
+    if (freeBytes < space.GetRecentAllocatedSize() * 2) { // 2: survivors and regions lost to fragmentation.
+        VLOG(REPORT, "young gc falls back to full gc: free space %zu B is not enough", freeBytes);
+        return false;
+    }
+
+    space.AssembleYoungSpace();
+    size_t youngBytes = space.YoungSpaceSize();
+    WorkStack workStack = NewWorkStack();
+    {
+        MRT_PHASE_TIMER("Promote roots");
+        RefFieldVisitor staticVisitor = [this, &workStack](RefField<>& field) { PromoteRefField(field, workStack); };
+        Heap::GetHeap().VisitStaticRoots(staticVisitor);
+
+        RootVisitor rawRootVisitor = [this, &workStack](ObjectRef& root) {
+            PromoteRefField(reinterpret_cast<RefField<>&>(root), workStack);
+        };
+        Runtime::Current().GetConcurrencyModel().VisitGCRoots(&rawRootVisitor);
+        // finalizers are kept alive by young gc.
+        collectorResources.GetFinalizerProcessor().VisitRawPointers(rawRootVisitor);
+
+        PromoteMutatorRoots(workStack);
+
+        size_t rememberedCount = space.VisitRememberedObjects([this, &workStack](BaseObject* obj) {
+            // remembered object could be dead and overwritten since it is remembered.
+            if (obj->IsValidObject()) {
+                PromoteObjectRefFields(obj, workStack);
+            }
+        });
+        VLOG(REPORT, "young gc visits %zu remembered objects", rememberedCount);
+    }
+
+    {
+        MRT_PHASE_TIMER("Promote young objects");
+        while (!workStack.empty()) {
+            BaseObject* obj = workStack.back();
+            workStack.pop_back();
+            PromoteObjectRefFields(obj, workStack);
+        }
+    }
+
+    // retire the region of gc thread, survivors in it are old.
+    AllocBuffer* allocBuffer = AllocBuffer::GetAllocBuffer();
+    if (allocBuffer != nullptr && allocBuffer->GetRegion() != RegionInfo::NullRegion()) {
+        RegionManager& manager = space.GetRegionManager();
+        manager.RemoveThreadLocalRegion(allocBuffer->GetRegion());
+        manager.EnlistFullThreadLocalRegion(allocBuffer->GetRegion());
+        allocBuffer->ClearRegion();
+    }
+
+    (void)space.CollectYoungSpace();
+    // no old object refers to young objects now.
+    space.ResetRememberedSet();
+
+    stats.isYoungGC = true;
+    stats.fromSpaceSize = youngBytes;
+    stats.liveBytesAfterGC = space.AllocatedBytes();
+    stats.collectedBytes = allocatedBytes > stats.liveBytesAfterGC ? allocatedBytes - stats.liveBytesAfterGC : 0;
+    stats.garbageRatio = (youngBytes > 0) ? static_cast<float>(stats.collectedBytes) / youngBytes : 0;
+    VLOG(REPORT, "young gc collects %zu B from young space %zu B. garbage ratio %.2f%%", stats.collectedBytes,
+         youngBytes, stats.garbageRatio * 100); // The base of the percentage is 100
+
+    collectorResources.GetFinalizerProcessor().NotifyToReclaimGarbage();
+    return true;
+}
+
 void WCollector::DoGarbageCollection()
 {
+    GetGCStats().isYoungGC = false;
+    // heuristic gc prefers young gc, while full gc is still needed periodically to collect old space.
+    if (RememberedSet::IsEnabled() && gcReason == GC_REASON_HEU &&
+        consecutiveYoungGCCount < MAX_CONSECUTIVE_YOUNG_GC) {
+        if (CollectYoungSpace()) {
+            ++consecutiveYoungGCCount;
+            return;
+        }
+    }
+    consecutiveYoungGCCount = 0;
+
     TraceHeap();
     PostTrace();
 
@@ -473,6 +683,9 @@ BaseObject* WCollector::ForwardObjectExclusive(BaseObject* obj)
     DLOG(FORWARD, "forward obj %p<%p>(%zu) to %p", obj, obj->GetTypeInfo(), size, toObj);
     CopyObject(*obj, *toObj, size);
     toObj->SetStateCode(ObjectState::NORMAL);
+    if (UNLIKELY(RememberedSet::IsEnabled())) {
+        RememberedSet::RecordObject(toObj);
+    }
     std::atomic_thread_fence(std::memory_order_release);
     obj->UnlockObject(ObjectState::FORWARDED);
     return toObj;
@@ -172,9 +172,20 @@ private:
     void Preforward();
     void PreforwardFinalizerProcessorRoots();
 
+    // young gc of generational mode, return false if it has to fall back to full gc.
+    bool CollectYoungSpace();
+    BaseObject* PromoteYoungObject(BaseObject* obj, WorkStack& workStack);
+    void PromoteRefField(RefField<>& field, WorkStack& workStack);
+    void PromoteObjectRefFields(BaseObject* obj, WorkStack& workStack);
+    void PromoteMutatorRoots(WorkStack& workStack);
+
+    // old space is only collected by full gc, which is forced after this number of young gcs.
+    static constexpr size_t MAX_CONSECUTIVE_YOUNG_GC = 8;
+
     ForwardTable fwdTable;
     // gc index 0 or 1 is used to distinguish previous gc and current gc.
     uint16_t currentTagID = 0;
+    size_t consecutiveYoungGCCount = 0;
 };
 } // namespace MapleRuntime
 #endif // ~MRT_WCOLLECTOR_H
\ No newline at end of file
@@ -10,6 +10,10 @@
 #include <chrono>
 #include <Common/ScopedObjectAccess.h>
 #include <chrono>
+#include <cmath>
+#include <random>
+#include <unistd.h>
+#include "Heap/Allocator/AllocBuffer.h"
 #include "Common/StackType.h"
 #include "UnwindStack/PrintStackInfo.h"
 #include "UnwindStack/StackInfo.h"
@@ -71,6 +75,10 @@ void CjAllocData::DeleteCjAllocData()
     }
     traceFunctionInfo.clear();
     traceNodeMap.clear();
+    if (IsSampling()) {
+        DumpPprofProfile();
+        sampledStacks.clear();
+    }
     g_allocInfo->DeleteAllNode(g_allocInfo->traceNodeHead);
     delete g_allocInfo->writer;
 }
@@ -178,6 +186,15 @@ void CjAllocData::InitRoot() {
 
 void CjAllocData::InitAllocParam() {
     sampSize = 1 * 1024 ; // default 1 * 1024 b
+    auto interval = std::getenv("cjAllocSampleInterval");
+    sampleInterval = interval == nullptr ? 0 : CString::ParseSizeFromEnv(interval) * KB;
+    if (IsSampling()) {
+        // arm existing mutators now, so that their first allocation already counts towards a sample.
+        Heap::GetHeap().GetAllocator().VisitAllocBuffers(
+            [this](AllocBuffer& buffer) { buffer.SetAllocSampleCountdown(NextSampleInterval()); });
+    }
+    auto file = std::getenv("cjAllocSampleProfile");
+    pprofFile = file == nullptr ? CString("cjalloc.") + CString(static_cast<int32_t>(getpid())) + ".heap" : file;
     InitRoot();
     HeapProfilerStream* stream = &MapleRuntime::HeapProfilerStream::GetInstance();
     writer = new StreamWriter(stream);
@@ -200,6 +217,10 @@ void CjAllocData::SerializeStats()
 
 void CjAllocData::RecordAllocNodes(const TypeInfo* klass, MSize size)
 {
+    if (IsSampling()) {
+        SampleAllocation(size);
+        return;
+    }
     std::unique_lock<std::mutex> lock(sharedMtx);
     if (!IsRecording()) { // avoid delete func was called at this time
         return;
@@ -216,6 +237,84 @@ void CjAllocData::RecordAllocNodes(const TypeInfo* klass, MSize size)
     }
 }
 
+int64_t CjAllocData::NextSampleInterval() const
+{
+    thread_local std::minstd_rand engine(static_cast<uint32_t>(std::random_device()()));
+    std::exponential_distribution<double> distribution(1.0 / static_cast<double>(sampleInterval));
+    return static_cast<int64_t>(distribution(engine)) + 1;
+}
+
+void CjAllocData::SampleAllocation(MSize size)
+{
+    AllocBuffer* buffer = AllocBuffer::GetAllocBuffer();
+    if (buffer == nullptr) {
+        return;
+    }
+    // buffers created after sampling was set up are armed by their first allocation, which is counted as well.
+    if (UNLIKELY(!buffer->IsAllocSampleArmed())) {
+        buffer->SetAllocSampleCountdown(NextSampleInterval());
+    }
+    if (LIKELY(!buffer->CountDownAllocSample(size))) {
+        return;
+    }
+    buffer->SetAllocSampleCountdown(NextSampleInterval());
+
+    std::unique_lock<std::mutex> lock(sharedMtx);
+    if (!IsRecording()) { // avoid delete func was called at this time
+        return;
+    }
+    // an allocation of size s is sampled with probability 1 - exp(-s / interval), scale it back for the trace tree.
+    double weight = 1.0 / (1.0 - std::exp(-static_cast<double>(size) / static_cast<double>(sampleInterval)));
+    // one walk feeds both the trace tree and the pprof buckets.
+    std::vector<Uptr> pcs;
+    AllocStackInfo allocStackInfo;
+    allocStackInfo.ProcessStackTrace(static_cast<MSize>(static_cast<double>(size) * weight), &pcs);
+    AllocSampleBucket& bucket = sampledStacks[pcs];
+    bucket.count++;
+    bucket.bytes += size;
+    SerializeStats();
+}
+
+// write sampled stacks in the legacy heap_v2 format of pprof, which unbiases the samples with the sampling
+// interval in the header. only allocated space is known here, so in-use fields are left zero.
+void CjAllocData::DumpPprofProfile()
+{
+    FILE* fp = fopen(pprofFile.Str(), "w");
+    if (fp == nullptr) {
+        LOG(RTLOG_ERROR, "open alloc profile %s failed, errno: %d", pprofFile.Str(), errno);
+        return;
+    }
+    uint64_t totalCount = 0;
+    uint64_t totalBytes = 0;
+    for (auto& entry : sampledStacks) {
+        totalCount += entry.second.count;
+        totalBytes += entry.second.bytes;
+    }
+    fprintf(fp, "heap profile: 0: 0 [%llu: %llu] @ heap_v2/%zu\n", static_cast<unsigned long long>(totalCount),
+            static_cast<unsigned long long>(totalBytes), sampleInterval);
+    for (auto& entry : sampledStacks) {
+        fprintf(fp, "0: 0 [%llu: %llu] @", static_cast<unsigned long long>(entry.second.count),
+                static_cast<unsigned long long>(entry.second.bytes));
+        for (Uptr pc : entry.first) {
+            fprintf(fp, " 0x%zx", pc);
+        }
+        fprintf(fp, "\n");
+    }
+    // pprof symbolizes addresses with the mappings of this process.
+    fprintf(fp, "\nMAPPED_LIBRARIES:\n");
+    FILE* maps = fopen("/proc/self/maps", "r");
+    if (maps != nullptr) {
+        char buf[4096]; // 4096: copy maps in pages
+        size_t n = 0;
+        while ((n = fread(buf, 1, sizeof(buf), maps)) > 0) {
+            fwrite(buf, 1, n, fp);
+        }
+        fclose(maps);
+    }
+    fclose(fp);
+    LOG(RTLOG_INFO, "alloc profile is dumped to %s", pprofFile.Str());
+}
+
 int32_t AllocStackInfo::ProcessTraceInfo(FrameInfo &frame)
 {
     if (frame.GetFrameType() == FrameType::NATIVE) {
@@ -270,23 +369,32 @@ void AllocStackInfo::ProcessTraceNode(TraceNodeField* head, MSize allocSize)
     }
     head->selfSize += allocSize;
 }
-void AllocStackInfo::ProcessStackTrace(MSize size)
+void AllocStackInfo::ProcessStackTrace(MSize size, std::vector<Uptr>* pcs)
 {
     UnwindContext uwContext;
     // Top unwind context can only be runtime or Cangjie context.
     CheckTopUnwindContextAndInit(uwContext);
+    // without pcs the walk stops at the first recorded frame, otherwise it goes on to collect the whole chain.
+    TraceNodeField* recordedNode = nullptr;
     while (!uwContext.frameInfo.mFrame.IsAnchorFrame(anchorFA)) {
         AnalyseAndSetFrameType(uwContext);
-        FrameInfo* f = new FrameInfo(uwContext.frameInfo);
-        // 1. If the node has been recorded, add the content in the stack to the end of the node.
-        FrameAddress* FA = f->mFrame.GetFA();
-        TraceNodeField* node = CjAllocData::GetCjAllocData()->FindNode(FA, f->GetFuncName().Str());
-        if (node != nullptr) {
-            delete f;
-            ProcessTraceNode(node, size);
-            return;
+        if (pcs != nullptr && uwContext.frameInfo.GetFrameType() == FrameType::MANAGED) {
+            pcs->push_back(reinterpret_cast<Uptr>(uwContext.frameInfo.mFrame.GetIP()));
+        }
+        if (recordedNode == nullptr) {
+            FrameInfo* f = new FrameInfo(uwContext.frameInfo);
+            // 1. If the node has been recorded, add the content in the stack to the end of the node.
+            FrameAddress* FA = f->mFrame.GetFA();
+            recordedNode = CjAllocData::GetCjAllocData()->FindNode(FA, f->GetFuncName().Str());
+            if (recordedNode == nullptr) {
+                frames.push(f);
+            } else {
+                delete f;
+                if (pcs == nullptr) {
+                    break;
+                }
+            }
         }
-        frames.push(f);
         UnwindContext caller;
         lastFrameType = uwContext.frameInfo.GetFrameType();
 #ifndef _WIN64
@@ -294,10 +402,17 @@ void AllocStackInfo::ProcessStackTrace(MSize size)
 #else
         if (uwContext.UnwindToCallerContext(caller, uwCtxStatus) == false) {
 #endif
-            return;
+            break;
         }
         uwContext = caller;
     }
+    if (recordedNode != nullptr) {
+        ProcessTraceNode(recordedNode, size);
+        return;
+    }
+    if (!uwContext.frameInfo.mFrame.IsAnchorFrame(anchorFA)) {
+        return; // unwinding failed
+    }
     // 2. If the stack back is not recorded, the call chain is a new call chain and the root node is the root node.
     ProcessTraceNode(CjAllocData::GetCjAllocData()->traceNodeHead, size);
 
@@ -310,4 +425,4 @@ void AllocStackInfo::ProcessStackTrace(MSize size)
     sample->orinal = static_cast<int32_t>(timestamp);
     CjAllocData::GetCjAllocData()->samples.push_back(sample);
 }
-}
\ No newline at end of file
+}
@@ -32,6 +32,12 @@ struct Sample {
     int32_t orinal;
 };
 
+// raw (not unbiased) statistics of the sampled allocations sharing one call stack.
+struct AllocSampleBucket {
+    uint64_t count = 0;
+    uint64_t bytes = 0;
+};
+
 class CjAllocData {
 public:
     static CjAllocData* GetCjAllocData();
@@ -52,8 +58,15 @@ public:
     void InitRoot();
     void RecordAllocNodes(const TypeInfo* klass, MSize size);
     int32_t SetNodeID() { return ++traceNodeID;};
+    // byte-interval sampling is enabled by cjAllocSampleInterval. each mutator counts down its allocated bytes in
+    // AllocBuffer, only the allocation crossing zero walks the stack, and the next interval is drawn from an
+    // exponential distribution so that sampling is not aliased with allocation patterns.
+    bool IsSampling() const { return sampleInterval > 0; }
+    void SampleAllocation(MSize size);
+    void DumpPprofProfile();
     friend class AllocStackInfo;
 private:
+    int64_t NextSampleInterval() const;
     std::unordered_map<int32_t, TraceNodeField*> traceNodeMap;
     TraceNodeField* traceNodeHead; // ROOT node
     std::vector<Sample*> samples;
@@ -64,13 +77,17 @@ private:
     StreamWriter* writer = nullptr;
     std::atomic<bool> recording{false};
     std::mutex sharedMtx;
+    size_t sampleInterval = 0;
+    CString pprofFile;
+    std::map<std::vector<Uptr>, AllocSampleBucket> sampledStacks;
 };
 
 class AllocStackInfo : public GCStackInfo {
 public:
     int32_t ProcessTraceInfo(FrameInfo &frame);
     void ProcessTraceNode(TraceNodeField* head, MSize allocSize);
-    void ProcessStackTrace(MSize size);
+    // also collect pcs of the managed frames up to the anchor if pcs is not null.
+    void ProcessStackTrace(MSize size, std::vector<Uptr>* pcs = nullptr);
 private:
     std::stack<FrameInfo* > frames;
 };
@@ -6,12 +6,14 @@
 
 
 #include "CjHeapData.h"
+#include <algorithm>
 #include <cerrno>
 #include <Common/BaseObject.h>
 #include <Common/Runtime.h>
 #include <Common/ScopedObjectAccess.h>
 #include <Heap/Collector/TaskQueue.h>
 #include <Heap/Collector/TracingCollector.h>
+#include <Heap/HeapWork.h>
 #include <sys/time.h>
 
 #include "ObjectModel/MArray.inline.h"
@@ -87,9 +89,15 @@ void CjHeapData::DumpHeap()
     }
 
     // step2 - write file
-    ScopedStopTheWorld scopedStopTheWorld("dump heap to file");
-    ProcessHeap();
-    WriteHeap();
+    // An OOM dump must not hold the whole dump in memory.
+    parallelSerialize = IsParallelDumpEnabled();
+    deferWrite = parallelSerialize && !dumpAfterOOM;
+    {
+        ScopedStopTheWorld scopedStopTheWorld("dump heap to file");
+        ProcessHeap();
+        WriteHeap();
+    }
+    FlushPendingRecords();
 
     // step3 - close file
     int ret = fclose(fp);
@@ -117,9 +125,14 @@ bool CjHeapData::DumpHeap(int fd)
         return false;
     }
 
-    ScopedStopTheWorld scopedStopTheWorld("dump heap to fd");
-    ProcessHeap();
-    WriteHeap();
+    // The caller is a mutator rather than the GC task thread, so the GC thread pool is not used here.
+    deferWrite = IsParallelDumpEnabled() && !dumpAfterOOM;
+    {
+        ScopedStopTheWorld scopedStopTheWorld("dump heap to fd");
+        ProcessHeap();
+        WriteHeap();
+    }
+    FlushPendingRecords();
 
     // fclose will close fd
     // if fclose success, no need to close fd.
@@ -294,9 +307,131 @@ void CjHeapData::WriteHeapDump()
     WriteRecordHeader(TAG_HEAP_DUMP, kCjHeapDataTime);
     WriteAllClass();
     WriteAllStructClass();
-    WriteAllObjects();
+    if (!parallelSerialize) {
+        WriteAllObjects();
+        ModifyLength();
+        EndRecord();
+        return;
+    }
+    if (deferWrite) {
+        // Only encode while the world is stopped: the chunks are queued behind this record, which is
+        // completed once all of them are encoded, and FlushPendingRecords() writes them afterwards.
+        std::list<std::vector<uint8_t>> chunks;
+        length += WriteAllObjectsParallel([&chunks](std::vector<uint8_t>& part) {
+            chunks.push_back(std::move(part));
+        });
+        ModifyLength();
+        EndRecord();
+        pendingRecords.splice(pendingRecords.end(), chunks);
+        return;
+    }
+    // The OOM dump is the exception: it cannot hold the whole dump in memory, so it writes each chunk
+    // from inside the stop-the-world phase as soon as it is encoded. The record length covers all
+    // chunks and is patched into the header once they are written.
+    fpos_t headerPos;
+    if (fgetpos(fp, &headerPos) != 0) {
+        WriteAllObjects();
+        ModifyLength();
+        EndRecord();
+        return;
+    }
+    fwrite(buffer.data(), length, 1, fp);
+    length += WriteAllObjectsParallel([this](std::vector<uint8_t>& part) {
+        fwrite(part.data(), part.size(), 1, fp);
+    });
     ModifyLength();
-    EndRecord();
+    constexpr size_t recordHeaderLength = 9;
+    if (fsetpos(fp, &headerPos) != 0 || fwrite(buffer.data(), recordHeaderLength, 1, fp) != 1 ||
+        fseek(fp, 0, SEEK_END) != 0) {
+        LOG(RTLOG_ERROR, "Failed to update heap dump record length, %s", strerror(errno));
+    }
+    buffer.clear();
+    length = 0;
+}
+
+bool CjHeapData::IsParallelDumpEnabled()
+{
+    auto env = std::getenv("cjHeapDumpParallel");
+    return env != nullptr && CString::ParseFlagFromEnv(env);
+}
+
+uint64_t CjHeapData::WriteAllObjectsParallel(const std::function<void(std::vector<uint8_t>&)>& emit)
+{
+    GCThreadPool* threadPool = Heap::GetHeap().GetCollectorResources().GetThreadPool();
+    const size_t threadCount = static_cast<size_t>(threadPool->GetMaxThreadNum()) + 1;
+    // Several chunks per thread so that a few huge arrays do not leave the other threads idle. At most
+    // two windows of encoded chunks are held here: one being emitted and one being encoded.
+    constexpr size_t chunksPerThread = 4;
+    constexpr size_t objectsPerChunk = 4096;
+    const size_t window = threadCount * chunksPerThread;
+    std::vector<std::list<DumpObject>::iterator> chunkBegins;
+    size_t count = 0;
+    for (auto it = dumpObjects.begin(); it != dumpObjects.end(); ++it, ++count) {
+        if (count % objectsPerChunk == 0) {
+            chunkBegins.push_back(it);
+        }
+    }
+    chunkBegins.push_back(dumpObjects.end());
+    const size_t chunkNum = chunkBegins.size() - 1;
+    // A scratch instance gives each chunk its own buffer while reusing the record encoders.
+    auto encodeChunk = [&chunkBegins](size_t i, std::vector<uint8_t>& part) {
+        CjHeapData chunkData;
+        for (auto it = chunkBegins[i]; it != chunkBegins[i + 1]; ++it) {
+            chunkData.WriteObject(*it);
+        }
+        part = std::move(chunkData.buffer);
+    };
+
+    const int32_t activeThreadNum = threadPool->GetMaxActiveThreadNum();
+    threadPool->SetMaxActiveThreadNum(threadPool->GetMaxThreadNum());
+    uint64_t written = 0;
+    std::vector<std::vector<uint8_t>> encoding;
+    std::vector<std::vector<uint8_t>> encoded;
+    for (size_t first = 0; first < chunkNum || !encoded.empty(); first += window) {
+        size_t last = std::min(first + window, chunkNum);
+        encoding.clear();
+        encoding.resize(last > first ? last - first : 0);
+        bool queued = false;
+        for (size_t i = first; i < last; ++i) {
+            std::vector<uint8_t>& part = encoding[i - first];
+            LambdaWork* work = new (std::nothrow) LambdaWork([&encodeChunk, &part, i](size_t) {
+                encodeChunk(i, part);
+            });
+            if (work == nullptr) {
+                encodeChunk(i, part);
+                continue;
+            }
+            threadPool->AddWork(work);
+            queued = true;
+        }
+        if (queued) {
+            threadPool->Start();
+        }
+        // Emit the previous window while this one is being encoded.
+        for (auto& part : encoded) {
+            if (!part.empty()) {
+                written += part.size();
+                emit(part);
+            }
+        }
+        if (queued) {
+            threadPool->WaitFinish();
+        }
+        encoded.swap(encoding);
+    }
+    threadPool->SetMaxActiveThreadNum(activeThreadNum);
+    return written;
+}
+
+void CjHeapData::FlushPendingRecords()
+{
+    while (!pendingRecords.empty()) {
+        std::vector<uint8_t>& record = pendingRecords.front();
+        if (!record.empty()) {
+            fwrite(record.data(), record.size(), 1, fp);
+        }
+        pendingRecords.pop_front();
+    }
 }
 /*
  * Record thread info:
@@ -336,35 +471,40 @@ void CjHeapData::WriteAllStructClass()
 
 void CjHeapData::WriteAllObjects()
 {
-    for (auto objectInfo : dumpObjects) {
-        switch (objectInfo.tag) {
-            case TAG_ROOT_THREAD_OBJECT:
-                WriteThreadObjectRoot(objectInfo.obj, objectInfo.tag, objectInfo.threadId, 0);
-                break;
-            case TAG_ROOT_LOCAL:
-                WriteLocalRoot(objectInfo.obj, objectInfo.tag, objectInfo.threadId, objectInfo.frameNum);
-                break;
-            case TAG_ROOT_GLOBAL:
-                WriteGlobalRoot(objectInfo.obj, objectInfo.tag);
-                break;
-            case TAG_ROOT_UNKNOWN:
-                WriteUnknownRoot(objectInfo.obj, objectInfo.tag);
-                break;
-            case TAG_OBJECT_ARRAY_DUMP:
-                WriteObjectArray(objectInfo.obj, objectInfo.tag);
-                break;
-            case TAG_STRUCT_ARRAY_DUMP:
-                WriteStructArray(objectInfo.obj, objectInfo.tag);
-                break;
-            case TAG_PRIMITIVE_ARRAY_DUMP:
-                WritePrimitiveArray(objectInfo.obj, objectInfo.tag);
-                break;
-            case TAG_INSTANCE_DUMP:
-                WriteInstance(objectInfo.obj, objectInfo.tag);
-                break;
-            default:
-                break;
-        }
+    for (auto& objectInfo : dumpObjects) {
+        WriteObject(objectInfo);
+    }
+}
+
+void CjHeapData::WriteObject(DumpObject& objectInfo)
+{
+    switch (objectInfo.tag) {
+        case TAG_ROOT_THREAD_OBJECT:
+            WriteThreadObjectRoot(objectInfo.obj, objectInfo.tag, objectInfo.threadId, 0);
+            break;
+        case TAG_ROOT_LOCAL:
+            WriteLocalRoot(objectInfo.obj, objectInfo.tag, objectInfo.threadId, objectInfo.frameNum);
+            break;
+        case TAG_ROOT_GLOBAL:
+            WriteGlobalRoot(objectInfo.obj, objectInfo.tag);
+            break;
+        case TAG_ROOT_UNKNOWN:
+            WriteUnknownRoot(objectInfo.obj, objectInfo.tag);
+            break;
+        case TAG_OBJECT_ARRAY_DUMP:
+            WriteObjectArray(objectInfo.obj, objectInfo.tag);
+            break;
+        case TAG_STRUCT_ARRAY_DUMP:
+            WriteStructArray(objectInfo.obj, objectInfo.tag);
+            break;
+        case TAG_PRIMITIVE_ARRAY_DUMP:
+            WritePrimitiveArray(objectInfo.obj, objectInfo.tag);
+            break;
+        case TAG_INSTANCE_DUMP:
+            WriteInstance(objectInfo.obj, objectInfo.tag);
+            break;
+        default:
+            break;
     }
 }
 /*
@@ -811,6 +951,12 @@ void CjHeapData::AddStringId(CjHeapData::CjHeapDataStringId value) { AddID(stati
 
 void CjHeapData::EndRecord()
 {
+    if (deferWrite) {
+        pendingRecords.push_back(std::move(buffer));
+        buffer.clear();
+        length = 0;
+        return;
+    }
     const char* ptr = reinterpret_cast<const char*>(buffer.data());
     fwrite(ptr, length, 1, fp);
     length = 0;
@@ -10,6 +10,7 @@
 
 #include <Common/BaseObject.h>
 #include <Common/StackType.h>
+#include <functional>
 #include <map>
 #include <set>
 #include <stack>
@@ -114,6 +115,10 @@ public:
     void WriteStackTrace();
     void WriteRecordHeader(const u1 tag, const u4 time);
     void WriteAllObjects();
+    void WriteObject(DumpObject& objectInfo);
+    uint64_t WriteAllObjectsParallel(const std::function<void(std::vector<uint8_t>&)>& emit);
+    void FlushPendingRecords();
+    static bool IsParallelDumpEnabled();
     void WriteAllClass();
     void WriteAllStructClass();
     void WriteHeapDump();
@@ -168,6 +173,13 @@ public:
     std::vector<uint8_t> buffer; // buffer 8byte vector
     uint64_t length = 0;
 
+    // Parallel dump mode (cjHeapDumpParallel=1): the objects are serialized by the GC thread pool. All
+    // records, object chunks included, are kept in memory and only written to fp by FlushPendingRecords()
+    // after the world restarts. OOM dumps write every record at once, inside the stop-the-world phase.
+    bool deferWrite = false;
+    bool parallelSerialize = false;
+    std::list<std::vector<uint8_t>> pendingRecords;
+
     CjHeapDataStringId LookupStringId(const CString& string);
     CjHeapData::CjHeapDataStringId stringId = 0x40000000;
     CjHeapData::CjHeapDataStringId threadObjectId = 0x80000000;
@@ -7,8 +7,10 @@
 
 #include "CjFileLoader.h"
 
+#include "Exception/EhTable.h"
 #include "ExceptionManager.inline.h"
 #include "ObjectManager.inline.h"
+#include "StackMap/StackMapCache.h"
 #include "TypeInfoManager.h"
 namespace MapleRuntime {
 
@@ -184,6 +186,12 @@ void CJFileLoader::RegisterTypeInfoCreatedByFE(BaseFile* baseFile)
         }
     }
     TypeInfoManager::GetInstance()->InitAnyAndObjectType();
+    // superclasses may be registered after their subclasses, so displays are computed in another pass.
+    for (typeInfoBase = baseFile->GetTypeInfoBase(); typeInfoBase < typeInfoEnd;) {
+        TypeInfo* ti = reinterpret_cast<TypeInfo*>(typeInfoBase);
+        typeInfoBase += MRT_ALIGN(sizeof(TypeInfo), 16u); // 16: alignment of typeinfo
+        ti->InitSuperDisplay();
+    }
 
     Uptr staticGIBase = baseFile->GetStaticGIBase();
     Uptr staticGIEnd = staticGIBase + baseFile->GetStaticGISize();
@@ -419,6 +427,9 @@ int CJFileLoader::UnloadLibrary(const char* libName)
     int ret = binLoadApi.binUnload(handlerIt->handler);
     if (ret == 0) {
         cjLibHandlers.erase(handlerIt);
+        // Decoded LSDAs and stack maps point into the unloaded image.
+        EHTableCache::Invalidate();
+        StackMapCache::Instance().Invalidate();
     }
     return ret;
 }
@@ -62,6 +62,18 @@ extern "C" MRT_EXPORT uint64_t CJ_MCC_GetGCTimeUs();
 __asm__(".global _CJ_MCC_GetGCTimeUs\n\t.set _CJ_MCC_GetGCTimeUs, _MCC_GetGCTimeUs");
 extern "C" MRT_EXPORT size_t CJ_MCC_GetGCFreedSize();
 __asm__(".global _CJ_MCC_GetGCFreedSize\n\t.set _CJ_MCC_GetGCFreedSize, _MCC_GetGCFreedSize");
+extern "C" MRT_EXPORT void CJ_MCC_RegisterNativeAllocation(int32_t subsystem, size_t size);
+__asm__(
+    ".global _CJ_MCC_RegisterNativeAllocation\n\t.set _CJ_MCC_RegisterNativeAllocation, "
+    "_MCC_RegisterNativeAllocation");
+extern "C" MRT_EXPORT void CJ_MCC_RegisterNativeFree(int32_t subsystem, size_t size);
+__asm__(".global _CJ_MCC_RegisterNativeFree\n\t.set _CJ_MCC_RegisterNativeFree, _MCC_RegisterNativeFree");
+extern "C" MRT_EXPORT size_t CJ_MCC_GetNativeAllocatedSize();
+__asm__(".global _CJ_MCC_GetNativeAllocatedSize\n\t.set _CJ_MCC_GetNativeAllocatedSize, _MCC_GetNativeAllocatedSize");
+extern "C" MRT_EXPORT size_t CJ_MCC_GetNativeAllocatedSizeOf(int32_t subsystem);
+__asm__(
+    ".global _CJ_MCC_GetNativeAllocatedSizeOf\n\t.set _CJ_MCC_GetNativeAllocatedSizeOf, "
+    "_MCC_GetNativeAllocatedSizeOf");
 extern "C" MRT_EXPORT size_t CJ_MCC_StartCpuProfiling();
 __asm__(".global _CJ_MCC_StartCpuProfiling\n\t.set _CJ_MCC_StartCpuProfiling, _MCC_StartCpuProfiling");
 extern "C" MRT_EXPORT size_t CJ_MCC_StopCpuProfiling(int fd);
@@ -129,15 +129,20 @@ void MutatorManager::DestroyMutator(Mutator* mutator)
     }
 }
 
-Mutator* MutatorManager::CreateRuntimeMutator(ThreadType threadType)
+// Because TSAN tool can't identify the RwLock implemented by ourselves,
+// we use a global instance fpMutatorInstance instead of an instance created on
+// heap in order to prevent false positives.
+static Mutator& GetFpMutatorInstance()
 {
-    // Because TSAN tool can't identify the RwLock implemented by ourselves,
-    // we use a global instance fpMutatorInstance instead of an instance created on
-    // heap in order to prevent false positives.
     static Mutator fpMutatorInstance;
+    return fpMutatorInstance;
+}
+
+Mutator* MutatorManager::CreateRuntimeMutator(ThreadType threadType, bool sharedFpMutator)
+{
     Mutator* mutator = nullptr;
-    if (threadType == ThreadType::FP_THREAD) {
-        mutator = &fpMutatorInstance;
+    if (threadType == ThreadType::FP_THREAD && sharedFpMutator) {
+        mutator = &GetFpMutatorInstance();
     } else {
         mutator = new (std::nothrow) Mutator();
     }
@@ -168,7 +173,7 @@ void MutatorManager::DestroyRuntimeMutator(ThreadType threadType)
     (void)mutator->LeaveSaferegion();
     // fp mutator is a static instance, we can't delete it, we reset the mutator to avoid invalid memory
     // access when static instance destruction.
-    if (threadType != ThreadType::FP_THREAD) {
+    if (threadType != ThreadType::FP_THREAD || mutator != &GetFpMutatorInstance()) {
         delete mutator;
     } else {
         mutator->ResetMutator();
@@ -226,10 +231,12 @@ bool MutatorManager::AcquireMutatorManagementWLockForCpuProfile()
 void MutatorManager::VisitAllMutators(MutatorVisitor func)
 {
     ScheduleAllCJThreadVisitMutator(VisitMuatorHelper, &func);
-    Mutator* mutator = Heap::GetHeap().GetFinalizerProcessor().GetMutator();
+    FinalizerProcessor& finalizerProcessor = Heap::GetHeap().GetFinalizerProcessor();
+    Mutator* mutator = finalizerProcessor.GetMutator();
     if (mutator != nullptr) {
         func(*mutator);
     }
+    finalizerProcessor.VisitWorkerMutators(func);
 }
 
 void MutatorManager::StopTheWorld(bool syncGCPhase, GCPhase phase)
@@ -522,7 +529,7 @@ void MutatorManager::TransitionAllMutatorsToCpuProfile()
     }
     std::list<Mutator*> undoneMutators;
     VisitAllMutators([&undoneMutators](Mutator& mutator) {
-        if (mutator.GetTid() != Heap::GetHeap().GetFinalizerProcessor().GetTid() &&
+        if (!Heap::GetHeap().GetFinalizerProcessor().IsFinalizerThread(mutator.GetTid()) &&
             mutator.GetCjthreadPtr() == MutatorManager::Instance().GetMainThreadHandle()) {
             mutator.SetSuspensionFlag(Mutator::SuspensionType::SUSPENSION_FOR_CPU_PROFILE);
             mutator.SetSafepointActive(true);
@@ -149,7 +149,8 @@ public:
 
     void DestroyMutator(Mutator* mutator);
 
-    Mutator* CreateRuntimeMutator(ThreadType threadType) __attribute__((noinline));
+    // sharedFpMutator: finalizer processor uses the static fp mutator, extra finalizer workers pass false.
+    Mutator* CreateRuntimeMutator(ThreadType threadType, bool sharedFpMutator = true) __attribute__((noinline));
     void DestroyRuntimeMutator(ThreadType threadType);
 
     bool WorldStopped() const { return worldStopped.load(std::memory_order_acquire); }
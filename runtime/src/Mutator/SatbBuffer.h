@@ -38,17 +38,17 @@ public:
             CHECK_DETAIL((memset_s(objectContainer, sizeof(objectContainer), 0, size) == EOK), "memset fail\n");
             top = objectContainer;
         }
+        // node is owned by one mutator until it is retired, so push needs no synchronization.
         void Push(const BaseObject* obj)
         {
-            std::lock_guard<std::mutex> lg(syncLock);
             *top = const_cast<BaseObject*>(obj);
             top++;
         }
+        // only for retired nodes, which are published to gc by the lock of retired list.
         template<typename T>
         void GetObjects(T& stack)
         {
             MRT_ASSERT(top <= &objectContainer[CONTAINER_CAPACITY], "invalid node");
-            std::lock_guard<std::mutex> lg(syncLock);
             BaseObject** head = objectContainer;
             while (head != top) {
                 stack.push_back(*head);
@@ -58,14 +58,8 @@ public:
         }
 
     private:
-#if defined(_WIN64)
-        static constexpr size_t CONTAINER_CAPACITY = 69;
-#elif defined(__aarch64__)
-        static constexpr size_t CONTAINER_CAPACITY = 64;
-#else
-        static constexpr size_t CONTAINER_CAPACITY = 65;
-#endif
-        std::mutex syncLock;
+        // 70 slots make a node of 9 cache lines.
+        static constexpr size_t CONTAINER_CAPACITY = 70;
         BaseObject** top;
         Node* next;
         BaseObject* objectContainer[CONTAINER_CAPACITY] = { nullptr };
@@ -47,6 +47,9 @@ public:
     inline U8* ConvertToCArray() const;
     // this interface can only be called by array with reference fields.
     void ForEachRefFieldInRange(const RefFieldVisitor& visitor, MAddress fieldStart, MIndex fieldEnd) const;
+    // Bulk variant for array copy barriers: the visitor is inlined and null ref fields are skipped.
+    template<typename Visitor>
+    inline void VisitNonNullRefFieldsInRange(Visitor&& visitor, MAddress fieldStart, MAddress fieldEnd) const;
 
 private:
     // use MIndex because length is the upper boundary of all indices
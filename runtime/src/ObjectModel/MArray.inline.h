@@ -81,6 +81,52 @@ inline void MArray::SetPrimitiveElement(MIndex index, T value)
     Heap::GetBarrier().WriteField(this, field, value);
 }
 
+template<typename Visitor>
+inline void MArray::VisitNonNullRefFieldsInRange(Visitor&& visitor, MAddress fieldStart, MAddress fieldEnd) const
+{
+    auto nonNullVisitor = [&visitor](RefField<>& field) {
+        if (field.GetFieldValue() != 0) {
+            visitor(field);
+        }
+    };
+    TypeInfo* componentTi = GetComponentTypeInfo();
+    MIndex size = fieldEnd - fieldStart;
+    if (componentTi->IsStructType()) {
+        GCTib gcTib = componentTi->GetGCTib();
+        size_t elementSize = GetElementSize();
+        CHECK(elementSize != 0);
+        MIndex limit = size / elementSize;
+        for (MIndex i = 0; i < limit; ++i) {
+            gcTib.VisitRefFields(fieldStart, nonNullVisitor);
+            fieldStart += elementSize;
+        }
+    } else if (componentTi->IsObjectType() || componentTi->IsArrayType() || componentTi->IsInterface()) {
+        // Sparse and freshly allocated arrays are mostly null, so test a block of refs at once before
+        // visiting them one by one. The or-reduction is a plain loop the compiler can vectorize.
+        constexpr MIndex blockSize = 8;
+        RefField<>* arrayContent = reinterpret_cast<RefField<>*>(fieldStart);
+        MIndex upLimit = size / sizeof(RefField<>);
+        MIndex i = 0;
+        for (; i + blockSize <= upLimit; i += blockSize) {
+            MAddress blockBits = 0;
+            for (MIndex j = 0; j < blockSize; ++j) {
+                blockBits |= arrayContent[i + j].GetFieldValue();
+            }
+            if (blockBits == 0) {
+                continue;
+            }
+            for (MIndex j = 0; j < blockSize; ++j) {
+                nonNullVisitor(arrayContent[i + j]);
+            }
+        }
+        for (; i < upLimit; ++i) {
+            nonNullVisitor(arrayContent[i]);
+        }
+    } else {
+        LOG(RTLOG_FATAL, "array object %p has wrong component type", this);
+    }
+}
+
 static inline MIndex CalculateArraySize(MIndex nElems, const U32 elemBytes)
 {
     if (elemBytes == 0) {
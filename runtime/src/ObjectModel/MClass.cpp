@@ -102,6 +102,34 @@ void TypeInfo::SetGCTib(GCTib gctib)
     }
 }
 
+MTableCache* MTableCache::Create(const std::unordered_map<U32, FuncPtr*>& mTable)
+{
+    // 2: keep load factor under 1/2 so that probe sequences stay short.
+    U32 capacity = 4;
+    while (capacity < mTable.size() * 2) {
+        capacity <<= 1;
+    }
+    void* mem = calloc(1, sizeof(MTableCache) + capacity * sizeof(Entry));
+    if (mem == nullptr) {
+        return nullptr;
+    }
+    MTableCache* cache = reinterpret_cast<MTableCache*>(mem);
+    cache->mask = capacity - 1;
+    cache->count = static_cast<U32>(mTable.size());
+    cache->retired = nullptr;
+    for (auto& pair : mTable) {
+        U32 idx = pair.first & cache->mask;
+        while (cache->entries[idx].itfUUID != 0) {
+            idx = (idx + 1) & cache->mask;
+        }
+        cache->entries[idx].itfUUID = pair.first;
+        cache->entries[idx].funcTable = pair.second;
+    }
+    return cache;
+}
+
+void MTableCache::Destroy(MTableCache* cache) { free(cache); }
+
 void TypeInfo::SetMTableDesc(MTableDesc* desc)
 {
     this->mTableDesc = desc;
@@ -317,8 +345,38 @@ void TypeInfo::GetInterfaces(std::vector<TypeInfo*> &itfs)
     }
 }
 
+// must be called with mTableMutex held.
+void TypeInfo::PublishMTableCache()
+{
+    // a pending mTable is incomplete, its lookups come from the traversal filling it.
+    if (mTableDesc->pending) {
+        return;
+    }
+    MTableCache* oldCache = mTableDesc->mTableCache.load(std::memory_order_relaxed);
+    if (oldCache != nullptr && oldCache->count == mTableDesc->mTable.size()) {
+        return;
+    }
+    MTableCache* newCache = MTableCache::Create(mTableDesc->mTable);
+    if (newCache == nullptr) {
+        return;
+    }
+    newCache->retired = oldCache;
+    mTableDesc->mTableCache.store(newCache, std::memory_order_release);
+}
+
 std::pair<FuncPtr*, bool> TypeInfo::FindMTable(U32 itfUUID)
 {
+    // other typeinfos sharing the mTableDesc may have published a cache before the extension defs of this one were
+    // traversed, so the cache is only complete for this typeinfo once its own traversal is done. the cache is
+    // republished before validInheritNum is invalidated.
+    if (LIKELY(__atomic_load_n(&validInheritNum, __ATOMIC_ACQUIRE) == INVALID_INHERIT_NUM)) {
+        MTableCache* cache = mTableDesc->mTableCache.load(std::memory_order_acquire);
+        if (LIKELY(cache != nullptr)) {
+            FuncPtr* funcTable = nullptr;
+            bool found = cache->Find(itfUUID, funcTable);
+            return { funcTable, found };
+        }
+    }
     if (this->IsInheritNumValid()) {
         std::lock_guard<std::recursive_mutex> lock(mTableDesc->mTableMutex);
         if (this->IsInheritNumValid()) {
@@ -340,8 +398,13 @@ std::pair<FuncPtr*, bool> TypeInfo::FindMTable(U32 itfUUID)
             }
             TraverseInnerExtensionDefs();
             TraverseOuterExtensionDefs();
-            validInheritNum = INVALID_INHERIT_NUM;
+            PublishMTableCache();
+            __atomic_store_n(&validInheritNum, INVALID_INHERIT_NUM, __ATOMIC_RELEASE);
         }
+    } else if (mTableDesc->mTableCache.load(std::memory_order_relaxed) == nullptr) {
+        // nothing to traverse for this typeinfo, its entries are already in mTable.
+        std::lock_guard<std::recursive_mutex> lock(mTableDesc->mTableMutex);
+        PublishMTableCache();
     }
     auto& mTable = mTableDesc->mTable;
     auto it = mTable.find(itfUUID);
@@ -367,6 +430,52 @@ FuncPtr* TypeInfo::GetMTable(TypeInfo* itf)
     return funcTable;
 }
 
+void TypeInfo::InitSuperDisplay()
+{
+    if (!IsClass()) {
+        return;
+    }
+    U16 depth = 0;
+    for (TypeInfo* super = GetSuperTypeInfo(); super != nullptr; super = super->GetSuperTypeInfo()) {
+        // closure classes are tested by their function types rather than by inheritance.
+        if (super->IsFunc() || depth == MTableDesc::INVALID_SUPER_DEPTH - 1) {
+            return;
+        }
+        ++depth;
+    }
+    TryInitMTable();
+    MTableDesc* desc = GetMTableDesc();
+    std::lock_guard<std::recursive_mutex> lock(desc->mTableMutex);
+    if (desc->superDepth.load(std::memory_order_relaxed) != MTableDesc::INVALID_SUPER_DEPTH) {
+        return;
+    }
+    U16 curDepth = depth;
+    for (TypeInfo* cur = this; cur != nullptr; cur = cur->GetSuperTypeInfo(), --curDepth) {
+        if (curDepth < MTableDesc::SUPER_DISPLAY_SIZE) {
+            desc->superDisplay[curDepth] = cur->GetUUID();
+        }
+    }
+    desc->superDepth.store(depth, std::memory_order_release);
+}
+
+bool TypeInfo::IsSubClassByDisplay(TypeInfo* superTypeInfo, bool& isSubClass)
+{
+    if (IsMTableDescUnInitialized() || superTypeInfo->IsMTableDescUnInitialized()) {
+        return false;
+    }
+    MTableDesc* desc = GetMTableDesc();
+    MTableDesc* superDesc = superTypeInfo->GetMTableDesc();
+    U16 depth = desc->superDepth.load(std::memory_order_acquire);
+    U16 superDepth = superDesc->superDepth.load(std::memory_order_acquire);
+    if (depth == MTableDesc::INVALID_SUPER_DEPTH || superDepth == MTableDesc::INVALID_SUPER_DEPTH ||
+        superDepth >= MTableDesc::SUPER_DISPLAY_SIZE) {
+        return false;
+    }
+    // a class at depth d can only be the ancestor at depth d.
+    isSubClass = superDepth <= depth && desc->superDisplay[superDepth] == superDesc->superDisplay[superDepth];
+    return true;
+}
+
 bool TypeInfo::IsSubType(TypeInfo* typeInfo)
 {
     // All types are subtypes of the Any type.
@@ -429,6 +538,10 @@ bool TypeInfo::IsSubType(TypeInfo* typeInfo)
         if (objectTi != nullptr && typeInfo == objectTi) {
             return true;
         }
+        bool isSubClass = false;
+        if (LIKELY(IsSubClassByDisplay(typeInfo, isSubClass))) {
+            return isSubClass;
+        }
         while (super != nullptr) {
             if (super->GetUUID() == typeInfo->GetUUID()) {
                 return true;
@@ -8,7 +8,9 @@
 #ifndef MRT_MCLASS_H
 #define MRT_MCLASS_H
 
+#include <atomic>
 #include <functional>
+#include <limits>
 #include <mutex>
 #include <unordered_map>
 
@@ -60,12 +62,63 @@ union MTableBitmap {
     }
 };
 
+// immutable open-addressed copy of an mTable. it is published by pointer swap so that interface calls and type
+// tests look it up without locking or hashing.
+struct MTableCache {
+    struct Entry {
+        U32 itfUUID; // 0 for empty slot, since uuid of interface is never 0.
+        FuncPtr* funcTable;
+    };
+
+    static MTableCache* Create(const std::unordered_map<U32, FuncPtr*>& mTable);
+    static void Destroy(MTableCache* cache);
+
+    // funcTable may be null for interfaces without methods, so a hit is reported by the return value.
+    bool Find(U32 itfUUID, FuncPtr*& funcTable) const
+    {
+        // uuids are allocated sequentially, so they spread well without hashing.
+        for (U32 idx = itfUUID & mask;; idx = (idx + 1) & mask) {
+            const Entry& entry = entries[idx];
+            if (entry.itfUUID == itfUUID) {
+                funcTable = entry.funcTable;
+                return true;
+            }
+            if (entry.itfUUID == 0) {
+                return false;
+            }
+        }
+    }
+
+    U32 mask;
+    U32 count; // size of the mTable it was built from.
+    MTableCache* retired; // older caches of the same mTable, readers may still hold them.
+    Entry entries[0];
+};
+
 struct MTableDesc {
     std::unordered_map<U32, FuncPtr*> mTable;
     MTableBitmap mTableBitmap;
     std::recursive_mutex mTableMutex;
     bool pending = false;
+    // typeinfos of different generic instantiations may share one mTableDesc and fill mTable in turn, so the cache
+    // is rebuilt whenever one of them completes its traversal. replaced caches are kept until the desc dies.
+    std::atomic<MTableCache*> mTableCache = { nullptr };
+    // superclass display of a class: uuids of its ancestors indexed by depth, the root class is at depth 0 and the
+    // class itself is at superDepth. ancestors deeper than SUPER_DISPLAY_SIZE are not recorded.
+    static constexpr U16 SUPER_DISPLAY_SIZE = 16;
+    static constexpr U16 INVALID_SUPER_DEPTH = std::numeric_limits<U16>::max();
+    std::atomic<U16> superDepth = { INVALID_SUPER_DEPTH };
+    U32 superDisplay[SUPER_DISPLAY_SIZE] = { 0 };
     explicit MTableDesc(U64 bitmap_) { mTableBitmap.tag = bitmap_; }
+    ~MTableDesc()
+    {
+        MTableCache* cache = mTableCache.load(std::memory_order_relaxed);
+        while (cache != nullptr) {
+            MTableCache* retired = cache->retired;
+            MTableCache::Destroy(cache);
+            cache = retired;
+        }
+    }
     MTableDesc() = delete;
 };
 
@@ -84,6 +137,17 @@ struct ShortGCTib {
             fieldAddr += sizeof(RefField<>);
         }
     }
+    // Same walk as ForEachBitmapWord, but inlines the visitor and jumps straight from one ref bit to the next.
+    template<typename Visitor>
+    void VisitRefFields(MAddress fieldAddr, Visitor& visitor) const
+    {
+        U64 gcInfo = bitmap & (~SIGN_BIT_64);
+        while (gcInfo != 0) {
+            U32 index = static_cast<U32>(__builtin_ctzll(gcInfo));
+            visitor(*reinterpret_cast<RefField<>*>(fieldAddr + index * sizeof(RefField<>)));
+            gcInfo &= gcInfo - 1;
+        }
+    }
     void ForEachBitmapWordInRange(MAddress baseAddr, const RefFieldVisitor& visitor, MAddress rangeStart,
                                   MAddress rangeEnd) const
     {
@@ -151,6 +215,19 @@ struct StdGCTib {
             baseAddr += (sizeof(RefField<>) * REFS_PER_BIT_WORD);
         }
     }
+    template<typename Visitor>
+    void VisitRefFields(MAddress contentAddr, Visitor& visitor) const
+    {
+        for (U32 i = 0; i < nBitmapWords; ++i) {
+            U32 bitmapWord = bitmapWords[i];
+            MAddress baseAddr = contentAddr + i * (sizeof(RefField<>) * REFS_PER_BIT_WORD);
+            while (bitmapWord != 0) {
+                U32 index = static_cast<U32>(__builtin_ctz(bitmapWord));
+                visitor(*reinterpret_cast<RefField<>*>(baseAddr + index * sizeof(RefField<>)));
+                bitmapWord &= bitmapWord - 1;
+            }
+        }
+    }
     void ForEachBitmapWordInRange(MAddress contentAddr, const RefFieldVisitor& visitor, MAddress rangeStart,
                                   MAddress rangeEnd) const
     {
@@ -201,6 +278,17 @@ union GCTib {
         }
     }
 
+    template<typename Visitor>
+    void VisitRefFields(MAddress contentAddr, Visitor& visitor) const
+    {
+        static_assert(BITS_FOR_REF == 1, "VisitRefFields expects one bitmap bit per ref word");
+        if (IsGCTibWord()) {
+            bitmap.VisitRefFields(contentAddr, visitor);
+        } else {
+            gctib->VisitRefFields(contentAddr, visitor);
+        }
+    }
+
     void ForEachBitmapWordInRange(MAddress contentAddr, const RefFieldVisitor& visitor, MAddress rangeStart,
                                   MAddress rangeEnd) const
     {
@@ -488,6 +576,8 @@ public:
     void TryInitMTable();
     void TryInitMTableNoLock();
     void GetInterfaces(std::vector<TypeInfo*> &itfs);
+    // compute superclass display of a class, called when it is registered.
+    void InitSuperDisplay();
 private:
     TypeInfo() = delete;
     ~TypeInfo() = delete;
@@ -496,6 +586,9 @@ private:
     void TraverseOuterExtensionDefs(std::function<void(TypeInfo*)> getInterface = nullptr);
     // 0: functable, 1: is_sub_type
     std::pair<FuncPtr*, bool> FindMTable(U32 itfUUID);
+    void PublishMTableCache();
+    // return false if display of either class is not ready, otherwise the result is set to isSubClass.
+    bool IsSubClassByDisplay(TypeInfo* superTypeInfo, bool& isSubClass);
 
     inline bool IsMTableDescUnInitialized() { return validInheritNum >> 15 == 1; }
     // This function must be called before mTableDesc is overwritten.
@@ -116,6 +116,45 @@ void StackManager::RecordLiteFrameInfos(std::vector<uint64_t>& liteFrameInfos, s
     printStackInfo.ExtractLiteFrameInfoFromStack(liteFrameInfos, steps);
 }
 
+bool StackManager::IsLazyStackTraceEnabled()
+{
+    static bool enabled = []() {
+        auto env = std::getenv("cjLazyStackTrace");
+        return env != nullptr && CString::ParseFlagFromEnv(env);
+    }();
+    return enabled;
+}
+
+size_t StackManager::GetLazyStackTraceDepth()
+{
+    static size_t depth = []() {
+        constexpr size_t defaultDepth = 64;
+        auto env = std::getenv("cjLazyStackTraceDepth");
+        if (env == nullptr) {
+            return defaultDepth;
+        }
+        size_t parsed = CString::ParsePosNumFromEnv(env);
+        if (parsed == 0) {
+            LOG(RTLOG_ERROR, "unsupported cjLazyStackTraceDepth, it should be a positive number.\n");
+            return defaultDepth;
+        }
+        return parsed;
+    }();
+    return depth;
+}
+
+void StackManager::RecordLazyFrameInfos(std::vector<uint64_t>& liteFrameInfos)
+{
+    constexpr size_t liteFrameInfoElementSize = 3;
+    size_t maxFrames = GetLazyStackTraceDepth();
+    // Reserve the bounded capacity up front so later throws on this mutator never grow the buffer.
+    if (liteFrameInfos.capacity() < maxFrames * liteFrameInfoElementSize) {
+        liteFrameInfos.reserve(maxFrames * liteFrameInfoElementSize);
+    }
+    PrintStackInfo printStackInfo(nullptr, 0);
+    printStackInfo.FillInLiteFrameInfos(liteFrameInfos, maxFrames);
+}
+
 void StackManager::GetStackTraceByLiteFrameInfos(const std::vector<uint64_t>& liteFrameInfos,
                                                  std::vector<StackTraceElement>& stackTrace)
 {
@@ -43,6 +43,12 @@ public:
 
     static void RecordLiteFrameInfos(std::vector<uint64_t>& liteFrameInfos, size_t steps = STACK_UNWIND_STEP_MAX);
 
+    // Lazy stack trace mode (cjLazyStackTrace=1): a throw only records the innermost
+    // cjLazyStackTraceDepth frames into a buffer reserved once per mutator.
+    static bool IsLazyStackTraceEnabled();
+    static size_t GetLazyStackTraceDepth();
+    static void RecordLazyFrameInfos(std::vector<uint64_t>& liteFrameInfos);
+
     static void GetStackTraceByLiteFrameInfos(const std::vector<uint64_t>& liteFrameInfos,
                                               std::vector<StackTraceElement>& stackTrace);
 
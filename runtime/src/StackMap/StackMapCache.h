@@ -0,0 +1,207 @@
+// Copyright (c) Huawei Technologies Co., Ltd. 2025. All rights reserved.
+// This source file is part of the Cangjie project, licensed under Apache-2.0
+// with Runtime Library Exception.
+//
+// See https://cangjie-lang.cn/pages/LICENSE for license information.
+
+
+#ifndef MRT_STACKMAP_CACHE_H
+#define MRT_STACKMAP_CACHE_H
+#include <atomic>
+#include <list>
+#include <new>
+
+#include "Base/LogFile.h"
+#include "StackMap/StackMap.h"
+namespace MapleRuntime {
+// Stack map of one (startPC, framePC) pair decoded into plain root lists. It does not depend on the frame
+// address, so every frame returning to the same pc can share it.
+class DecodedStackMap {
+public:
+    DecodedStackMap(Uptr, PrologueRegisterClosure&& prologue)
+        : isValid(false), calleeSavedPrologue(std::move(prologue)) {}
+    DecodedStackMap(bool valid, Uptr, const StackMapEntry& entry, PrologueRegisterClosure&& prologue)
+        : isValid(valid), calleeSavedPrologue(std::move(prologue)), slotRoot(entry.BuildSlotRoot()),
+          regRoot(entry.BuildRegRoot()), derivedPtr(entry.BuildDerivedPtrRoot()) {}
+
+    bool IsValid() const { return isValid; }
+
+    // ATTENTION: same ordering rules as HeapReferenceMap, derived pointers must be visited last.
+    bool VisitRegRoots(const RootVisitor& visitor, const RegDebugVisitor& debugFunc, RegSlotsMap& regSlotsMap,
+                       std::list<Uptr>* rootsList = nullptr) const
+    {
+        return regRoot.VisitGCRoots(visitor, debugFunc, regSlotsMap, rootsList);
+    }
+
+    void VisitSlotRoots(const RootVisitor& visitor, const SlotDebugVisitor& debugFunc, Uptr stackBase,
+                        std::list<Uptr>* rootsList = nullptr) const
+    {
+        slotRoot.VisitGCRoots(visitor, debugFunc, stackBase, rootsList);
+    }
+
+    void VisitDerivedPtr(const DerivedPtrVisitor& derivedVisitor, const DerivedPtrDebugVisitor debugVisitor,
+                         RegSlotsMap& regSlotsMap, const std::list<Uptr>& rootsList, Uptr stackBase) const
+    {
+        // DerivedPtr advances its row cursor while visiting, so walk a private copy.
+        DerivedPtr cursor = derivedPtr;
+        for (auto it = rootsList.begin(); it != rootsList.end(); ++it) {
+            if (!cursor.VisitDerivedPtr(derivedVisitor, debugVisitor, regSlotsMap, *it, stackBase)) {
+                break;
+            }
+        }
+    }
+
+    void RecordCalleeSaved(RegSlotsMap& regSlotsMap, Uptr stackBase) const
+    {
+        calleeSavedPrologue.RecordCalleeSaved(regSlotsMap, stackBase);
+    }
+
+private:
+    friend class StackMapCache;
+
+    Uptr startPC = 0;
+    Uptr framePC = 0;
+    uint64_t generation = 0;
+    DecodedStackMap* nextRetired = nullptr;
+
+    bool isValid;
+    PrologueRegisterClosure calleeSavedPrologue;
+    SlotRoot slotRoot;
+    RegRoot regRoot;
+    DerivedPtr derivedPtr;
+};
+
+// Bounded, direct-mapped cache from return pc to its decoded stack map, shared by all root enumeration
+// threads without locks. A colliding entry is replaced and retired; retired entries are only freed by
+// Reclaim() while no stack walk holds a ReadScope.
+class StackMapCache {
+public:
+    // Held across a whole stack walk, so that the maps it got are not freed under it.
+    class ReadScope {
+    public:
+        ReadScope() { Instance().readers.fetch_add(1, std::memory_order_seq_cst); }
+        ~ReadScope() { Instance().readers.fetch_sub(1, std::memory_order_release); }
+        ReadScope(const ReadScope&) = delete;
+        ReadScope& operator=(const ReadScope&) = delete;
+    };
+
+    static StackMapCache& Instance()
+    {
+        static StackMapCache cache;
+        return cache;
+    }
+
+    // The caller must hold a ReadScope, the returned map stays valid until it is released.
+    const DecodedStackMap* Get(Uptr startPC, Uptr framePC, Uptr frameAddress)
+    {
+        std::atomic<DecodedStackMap*>& slot = slots[Hash(framePC)];
+        uint64_t gen = generation.load(std::memory_order_acquire);
+        DecodedStackMap* cached = slot.load(std::memory_order_acquire);
+        if (cached != nullptr && cached->framePC == framePC && cached->startPC == startPC &&
+            cached->generation == gen) {
+            hits.fetch_add(1, std::memory_order_relaxed);
+            return cached;
+        }
+        misses.fetch_add(1, std::memory_order_relaxed);
+
+        StackMapBuilder builder(startPC, framePC, frameAddress);
+        DecodedStackMap* decoded = new (std::nothrow) DecodedStackMap(builder.Build<DecodedStackMap>());
+        if (decoded == nullptr) {
+            LOG(RTLOG_FATAL, "new DecodedStackMap failed");
+        }
+        decoded->startPC = startPC;
+        decoded->framePC = framePC;
+        decoded->generation = gen;
+        if (slot.compare_exchange_strong(cached, decoded, std::memory_order_acq_rel)) {
+            if (cached != nullptr) {
+                Retire(cached);
+            }
+        } else {
+            // Lost the race, the caller still uses our copy until the next reclamation.
+            Retire(decoded);
+        }
+        return decoded;
+    }
+
+    // Entries decoded before this call are never hit again, e.g. after the owning library is unloaded.
+    void Invalidate() { generation.fetch_add(1, std::memory_order_acq_rel); }
+
+    // Free the retired entries unless a stack walk, e.g. of a heap dump, is in progress. In that case
+    // they are kept for the next call.
+    void Reclaim()
+    {
+        if (readers.load(std::memory_order_acquire) != 0) {
+            return;
+        }
+        DecodedStackMap* entry = retired.exchange(nullptr, std::memory_order_seq_cst);
+        if (entry == nullptr) {
+            return;
+        }
+        // A walk that started before the exchange may still use a detached entry. Walks starting after
+        // this check only see entries that are still cached, or private copies they retire themselves.
+        if (readers.load(std::memory_order_seq_cst) != 0) {
+            DecodedStackMap* tail = entry;
+            while (tail->nextRetired != nullptr) {
+                tail = tail->nextRetired;
+            }
+            RetireList(entry, tail);
+            return;
+        }
+        while (entry != nullptr) {
+            DecodedStackMap* next = entry->nextRetired;
+            delete entry;
+            entry = next;
+        }
+    }
+
+    void DumpAndResetStats()
+    {
+        size_t hitCount = hits.exchange(0, std::memory_order_relaxed);
+        size_t missCount = misses.exchange(0, std::memory_order_relaxed);
+        size_t total = hitCount + missCount;
+        if (total == 0) {
+            return;
+        }
+        constexpr double percent = 100.0;
+        VLOG(REPORT, "stack map cache: hits %zu, misses %zu, hit rate %.2f%%", hitCount, missCount,
+             percent * hitCount / total);
+    }
+
+private:
+    StackMapCache()
+    {
+        for (size_t i = 0; i < CACHE_SIZE; ++i) {
+            slots[i].store(nullptr, std::memory_order_relaxed);
+        }
+    }
+    ~StackMapCache() = default;
+
+    static size_t Hash(Uptr framePC)
+    {
+        constexpr uint64_t golden = 0x9E3779B97F4A7C15ULL;
+        constexpr uint32_t hashBits = 64;
+        return static_cast<size_t>((static_cast<uint64_t>(framePC) * golden) >> (hashBits - CACHE_SIZE_BITS));
+    }
+
+    void Retire(DecodedStackMap* entry) { RetireList(entry, entry); }
+
+    void RetireList(DecodedStackMap* first, DecodedStackMap* last)
+    {
+        DecodedStackMap* head = retired.load(std::memory_order_relaxed);
+        do {
+            last->nextRetired = head;
+        } while (!retired.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    static constexpr uint32_t CACHE_SIZE_BITS = 13;
+    static constexpr size_t CACHE_SIZE = static_cast<size_t>(1) << CACHE_SIZE_BITS;
+
+    std::atomic<DecodedStackMap*> slots[CACHE_SIZE];
+    std::atomic<DecodedStackMap*> retired{ nullptr };
+    std::atomic<uint64_t> generation{ 0 };
+    std::atomic<size_t> readers{ 0 };
+    std::atomic<size_t> hits{ 0 };
+    std::atomic<size_t> misses{ 0 };
+};
+} // namespace MapleRuntime
+#endif // ~MRT_STACKMAP_CACHE_H
@@ -401,6 +401,7 @@ void TypeInfoManager::FillRemainingField(GenericTiDesc* &tiDesc, TypeTemplate* t
     newTypeInfo->SetSuperTypeInfo(super);
     AddTypeInfo(newTypeInfo);
     AddMTable(tt, newTypeInfo, argSize, args);
+    newTypeInfo->InitSuperDisplay();
     if (tt->ReflectInfoIsNull()) {
         tiDesc->SetTypeInfoStatus(TypeInfoStatus::TYPEINFO_INITED);
         return;
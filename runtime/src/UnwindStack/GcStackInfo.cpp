@@ -11,6 +11,7 @@
 
 #include "Collector/TracingCollector.h"
 #include "Common/StackType.h"
+#include "StackMap/StackMapCache.h"
 
 namespace MapleRuntime {
 void GCStackInfo::FillInStackTrace()
@@ -36,6 +37,7 @@ void GCStackInfo::FillInStackTrace()
 
 void GCStackInfo::VisitStackRoots(const RootVisitor& func, Mutator& mutator) const
 {
+    StackMapCache::ReadScope stackMapScope;
     RegSlotsMap regSlotsMap;
     for (auto frame : stack) {
         switch (frame.GetFrameType()) {
@@ -61,6 +63,7 @@ void GCStackInfo::VisitStackRoots(const RootVisitor& func, Mutator& mutator) con
 void GCStackInfo::VisitHeapReferencesOnStack(const RootVisitor& rootVisitor, const DerivedPtrVisitor& derivedPtrVisitor,
                                              Mutator& mutator) const
 {
+    StackMapCache::ReadScope stackMapScope;
     RegSlotsMap regSlotsMap;
     for (auto frame : stack) {
         switch (frame.GetFrameType()) {
@@ -108,6 +111,7 @@ void RecordStackInfo::FillInStackTrace()
 
 void RecordStackInfo::VisitStackRoots(const RootVisitor &func, Mutator &mutator)
 {
+    StackMapCache::ReadScope stackMapScope;
     RegSlotsMap regSlotsMap;
     for (auto frame : stacks) {
         FrameInfo &ref = *frame;
@@ -8,6 +8,7 @@
 #include "PrintStackInfo.h"
 
 #include "Common/StackType.h"
+#include "ObjectModel/MFuncdesc.inline.h"
 
 namespace MapleRuntime {
 void PrintStackInfo::FillInStackTrace()
@@ -34,6 +35,41 @@ void PrintStackInfo::FillInStackTrace()
     }
 }
 
+void PrintStackInfo::FillInLiteFrameInfos(std::vector<uint64_t>& liteFrameInfos, size_t maxFrames)
+{
+    constexpr size_t liteFrameInfoElementSize = 3;
+    UnwindContext uwContext;
+    CheckTopUnwindContextAndInit(uwContext);
+    while (!uwContext.frameInfo.mFrame.IsAnchorFrame(anchorFA)) {
+        AnalyseAndSetFrameType(uwContext);
+        if (uwContext.frameInfo.GetFrameType() == FrameType::MANAGED) {
+            if (liteFrameInfos.size() >= maxFrames * liteFrameInfoElementSize) {
+                return;
+            }
+            const FrameInfo& frameInfo = uwContext.frameInfo;
+            liteFrameInfos.push_back(reinterpret_cast<uint64_t>(frameInfo.mFrame.GetIP()));
+            liteFrameInfos.push_back(reinterpret_cast<uint64_t>(frameInfo.GetStartProc()));
+#ifdef __APPLE__
+            FuncDescRef funcDesc = MFuncDesc::GetFuncDesc(frameInfo.mFrame.GetFA());
+#else
+            FuncDescRef funcDesc = MFuncDesc::GetFuncDesc(reinterpret_cast<Uptr>(frameInfo.GetStartProc()));
+#endif
+            liteFrameInfos.push_back(reinterpret_cast<uint64_t>(funcDesc));
+        }
+
+        UnwindContext caller;
+        lastFrameType = uwContext.frameInfo.GetFrameType();
+#ifndef _WIN64
+        if (uwContext.UnwindToCallerContext(caller) == false) {
+#else
+        if (uwContext.UnwindToCallerContext(caller, uwCtxStatus) == false) {
+#endif
+            return;
+        }
+        uwContext = caller;
+    }
+}
+
 void PrintStackInfo::PrintStackTrace() const
 {
 #if defined(MRT_DEBUG) && (MRT_DEBUG == 1)
@@ -14,7 +14,8 @@
 namespace MapleRuntime {
 class PrintStackInfo : public StackInfo {
 public:
-    explicit PrintStackInfo(const UnwindContext* context = nullptr) : StackInfo(context)
+    explicit PrintStackInfo(const UnwindContext* context = nullptr, size_t presetStackLength = PRESET_STACK_LENGTH)
+        : StackInfo(context, presetStackLength)
     {
 #if defined(MRT_DEBUG) && (MRT_DEBUG == 1)
         DLOG(UNWIND, "Print Stack Info");
@@ -28,6 +29,9 @@ public:
 
     ~PrintStackInfo() override = default;
     void FillInStackTrace() override;
+    // Unwind straight into {ip, startPC, funcDesc} triples without materializing FrameInfos,
+    // stopping after maxFrames managed frames.
+    void FillInLiteFrameInfos(std::vector<uint64_t>& liteFrameInfos, size_t maxFrames);
     virtual void PrintStackTrace() const;
 };
 } // namespace MapleRuntime
@@ -17,7 +17,7 @@ namespace MapleRuntime {
 class Mutator;
 class StackInfo {
 public:
-    explicit StackInfo(const UnwindContext* context = nullptr)
+    explicit StackInfo(const UnwindContext* context = nullptr, size_t presetStackLength = PRESET_STACK_LENGTH)
         : n2cCount(0), lastFrameType(FrameType::UNKNOWN), topContext(context), isReliableN2CStub(false)
     {
         if (context == nullptr) {
@@ -25,8 +25,9 @@ public:
         } else {
             anchorFA = context->anchorFA;
         }
-        constexpr int presetStackLength = 32;
-        stack.reserve(presetStackLength);
+        if (presetStackLength > 0) {
+            stack.reserve(presetStackLength);
+        }
     }
 
     virtual ~StackInfo()
@@ -57,6 +58,7 @@ public:
     virtual void FillInStackTrace() = 0;
 
     static const int NEED_FILTED_FLAG;
+    static constexpr size_t PRESET_STACK_LENGTH = 32;
 
 protected:
     // frame info stack vector
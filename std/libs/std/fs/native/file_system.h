@@ -35,6 +35,7 @@
 #define DEFFILEMODE (S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH)                                // 0666
 #define DEF_DIR_MODE (S_IRUSR | S_IWUSR | S_IXUSR | S_IRGRP | S_IWGRP | S_IXGRP | S_IROTH | S_IWOTH | S_IXOTH) // 0777
 #define BUF_SIZE (1024)
+#define COPY_BUF_SIZE (256 * 1024)
 
 #define CJ_RDONLY 0
 #define CJ_WRONLY 1
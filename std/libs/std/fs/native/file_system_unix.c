@@ -9,6 +9,13 @@
 #include <limits.h>
 #include <sys/types.h>
 #include "file_system.h"
+#if defined(__linux__)
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#elif defined(__APPLE__)
+#include <copyfile.h>
+#endif
 
 static int64_t BuildSubPath(char* dirPath, const int64_t pathLen, const char* subName);
 static FsError* GetErrnoResult(void);
@@ -590,43 +597,160 @@ extern int CJ_FS_CopyLink(char* linkName1, char* linkName2)
     return 0;
 }
 
-/* Copy file */
-extern int CJ_FS_CopyREF(char* dir1, char* dir2)
+/*
+ * Copy engine of CJ_FS_CopyREF. Every kernel side method copies from the current file offsets and advances them,
+ * so when one turns out to be unsupported (e.g. across file systems) the next method resumes where it stopped.
+ * The kernel side methods return COPY_UNSUPPORTED in that case, and also when they hit the end before st_size
+ * bytes were copied, as some file systems (sysfs, FUSE, ...) report sizes their kernel side copies do not honor.
+ */
+#define COPY_DONE 0
+#define COPY_FAILED (-1)
+#define COPY_UNSUPPORTED 1
+#define COPY_CHUNK_SIZE ((size_t)1 << 30)
+
+#if defined(__linux__)
+#ifndef FICLONE
+#define FICLONE _IOW(0x94, 9, int)
+#endif
+
+static bool IsCopyUnsupported(int err)
 {
-    char buf[BUF_SIZE];
+    return err == ENOSYS || err == EXDEV || err == EINVAL || err == EOPNOTSUPP || err == ENOTSUP || err == EPERM ||
+        err == EBADF;
+}
 
-    int fd1 = open(dir1, O_RDONLY);
-    if (fd1 < 0) {
-        return -1;
+/* Shares the data blocks of a reflink capable file system (btrfs, xfs, ...), nothing is copied. */
+static int CopyByReflink(int fdIn, int fdOut)
+{
+    return ioctl(fdOut, FICLONE, fdIn) == 0 ? COPY_DONE : COPY_UNSUPPORTED;
+}
+
+#if defined(__NR_copy_file_range)
+static int CopyByCopyFileRange(int fdIn, int fdOut, off_t size, off_t* copied)
+{
+    while (true) {
+        ssize_t n = (ssize_t)syscall(__NR_copy_file_range, fdIn, NULL, fdOut, NULL, COPY_CHUNK_SIZE, 0U);
+        if (n > 0) {
+            *copied += n;
+            continue;
+        }
+        if (n == 0) {
+            return *copied < size ? COPY_UNSUPPORTED : COPY_DONE;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        return IsCopyUnsupported(errno) ? COPY_UNSUPPORTED : COPY_FAILED;
     }
-    int fd2 = open(dir2, O_WRONLY | O_CREAT | O_TRUNC, DEFFILEMODE);
-    if (fd2 < 0) {
-        (void)close(fd1);
-        return -1;
+}
+#endif
+
+static int CopyBySendfile(int fdIn, int fdOut, off_t size, off_t* copied)
+{
+    while (true) {
+        ssize_t n = sendfile(fdOut, fdIn, NULL, COPY_CHUNK_SIZE);
+        if (n > 0) {
+            *copied += n;
+            continue;
+        }
+        if (n == 0) {
+            return *copied < size ? COPY_UNSUPPORTED : COPY_DONE;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        return IsCopyUnsupported(errno) ? COPY_UNSUPPORTED : COPY_FAILED;
     }
+}
+#endif
 
-    int ret = (int)read(fd1, buf, sizeof(buf) - 1);
-    int sts = 0;
-    while (ret > 0) {
-        sts = (int)write(fd2, buf, (size_t)ret);
-        while (sts < ret) {
-            sts += (int)write(fd2, buf + sts, (size_t)(ret - sts));
+static int CopyByBuffer(int fdIn, int fdOut)
+{
+    char* buf = (char*)malloc(COPY_BUF_SIZE);
+    if (buf == NULL) {
+        return COPY_FAILED;
+    }
+    int ret = COPY_DONE;
+    while (true) {
+        ssize_t readLen = read(fdIn, buf, COPY_BUF_SIZE);
+        if (readLen == 0) {
+            break;
         }
-        if (memset_s(buf, sizeof(buf), 0, sizeof(buf)) != EOK) {
-            ret = -1;
+        if (readLen < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            ret = COPY_FAILED;
+            break;
+        }
+        ssize_t written = 0;
+        while (written < readLen) {
+            ssize_t n = write(fdOut, buf + written, (size_t)(readLen - written));
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                ret = COPY_FAILED;
+                break;
+            }
+            written += n;
+        }
+        if (ret != COPY_DONE) {
             break;
         }
-        ret = (int)read(fd1, buf, sizeof(buf) - 1);
     }
+    free(buf);
+    return ret;
+}
 
-    if (ret == -1) {
+/* Copies the content of fdIn to fdOut, trying reflink, copy_file_range and sendfile before a user space copy. */
+static int CopyFileData(int fdIn, int fdOut, const struct stat* info)
+{
+    // Kernel side copies rely on the file size, which is not meaningful for pipes, devices or files in /proc.
+    if (!S_ISREG(info->st_mode) || info->st_size == 0) {
+        return CopyByBuffer(fdIn, fdOut);
+    }
+#if defined(__linux__)
+    off_t copied = 0;
+    int ret = CopyByReflink(fdIn, fdOut);
+#if defined(__NR_copy_file_range)
+    if (ret == COPY_UNSUPPORTED) {
+        ret = CopyByCopyFileRange(fdIn, fdOut, info->st_size, &copied);
+    }
+#endif
+    if (ret == COPY_UNSUPPORTED) {
+        ret = CopyBySendfile(fdIn, fdOut, info->st_size, &copied);
+    }
+    if (ret != COPY_UNSUPPORTED) {
+        return ret;
+    }
+#elif defined(__APPLE__)
+    // uses clonefile semantics on APFS when possible.
+    if (fcopyfile(fdIn, fdOut, NULL, COPYFILE_DATA) == 0) {
+        return COPY_DONE;
+    }
+    if (lseek(fdIn, 0, SEEK_SET) < 0 || lseek(fdOut, 0, SEEK_SET) < 0 || ftruncate(fdOut, 0) != 0) {
+        return COPY_FAILED;
+    }
+#endif
+    return CopyByBuffer(fdIn, fdOut);
+}
+
+/* Copy file */
+extern int CJ_FS_CopyREF(char* dir1, char* dir2)
+{
+    int fd1 = open(dir1, O_RDONLY);
+    if (fd1 < 0) {
+        return -1;
+    }
+    int fd2 = open(dir2, O_WRONLY | O_CREAT | O_TRUNC, DEFFILEMODE);
+    if (fd2 < 0) {
         (void)close(fd1);
-        (void)close(fd2);
         return -1;
     }
 
     struct stat info;
-    if (fstat(fd1, &info) != 0) {
+    if (fstat(fd1, &info) != 0 || CopyFileData(fd1, fd2, &info) != COPY_DONE) {
         (void)close(fd1);
         (void)close(fd2);
         return -1;
@@ -57,11 +57,14 @@ extern SocketBuffer* CJ_SOCKET_BufferInit(long long handle, int32_t rBufSize, in
     atomic_init(&sockBuf->count, 1);
     sockBuf->rBufSize = rBufSize;
     sockBuf->wBufSize = wBufSize;
+    CJ_MCC_RegisterNativeAllocation(
+        CJ_NATIVE_SUBSYSTEM_SOCKET, sizeof(SocketBuffer) + (size_t)rBufSize + (size_t)wBufSize);
     return sockBuf;
 }
 
 static void CJ_SocketFreeWrapperBuffer(SocketBuffer* sockBuf)
 {
+    size_t nativeSize = sizeof(SocketBuffer) + (size_t)sockBuf->rBufSize + (size_t)sockBuf->wBufSize;
     char* itemR = sockBuf->rBuf;
     sockBuf->rBuf = NULL;
     sockBuf->rBufSize = 0;
@@ -71,6 +74,7 @@ static void CJ_SocketFreeWrapperBuffer(SocketBuffer* sockBuf)
     free(itemR);
     free(itemW);
     free(sockBuf);
+    CJ_MCC_RegisterNativeFree(CJ_NATIVE_SUBSYSTEM_SOCKET, nativeSize);
 }
 
 static bool CJ_SocketIncreaseRef(SocketBuffer* sockBuf)
@@ -201,6 +205,77 @@ extern int32_t CJ_SOCKET_BufferWCopy(SocketBuffer* sockBuf, const char* arrBuf,
     return -1;
 }
 
+/**
+ * Direct I/O between the socket and a caller owned buffer, usually a pinned Cangjie array, bypassing rBuf/wBuf.
+ * These never block: the caller must not keep the array pinned while waiting, so it waits for readiness with
+ * CJ_SOCKET_BufferWaitRecv/CJ_SOCKET_BufferWaitSend first and retries when -1 is returned with EAGAIN.
+ * @return bytes transferred, 0 if the socket is closed, -1 on error
+ */
+extern int32_t CJ_SOCKET_BufferRecvDirect(SocketBuffer* sockBuf, char* arrBuf, int32_t readSize, int32_t flags)
+{
+    if (readSize <= 0 || CJ_SocketIncreaseRef(sockBuf)) {
+        return 0;
+    }
+    long long handle = atomic_load(&sockBuf->handle);
+    int32_t recvLen = CJ_MRT_SockRecvNonBlock(handle, arrBuf, (unsigned int)readSize, flags);
+    if (CJ_SocketDecreaseRef(sockBuf)) {
+        return 0; // This affects subsequent operations. Therefore, return 0 directly.
+    }
+    return recvLen;
+}
+
+extern int32_t CJ_SOCKET_BufferSendDirect(SocketBuffer* sockBuf, const char* arrBuf, int32_t writeSize, int32_t flags)
+{
+    if (writeSize <= 0 || CJ_SocketIncreaseRef(sockBuf)) {
+        return 0;
+    }
+    long long handle = atomic_load(&sockBuf->handle);
+    int32_t sendLen = CJ_MRT_SockSendNonBlock(handle, arrBuf, (unsigned int)writeSize, flags);
+    (void)CJ_SocketDecreaseRef(sockBuf); // The value 0 is not returned because subsequent operations are not affected.
+    return sendLen;
+}
+
+/**
+ * Waits until the socket is readable (or writable), a negative timeout waits forever.
+ * @return 0 when ready, 1 if the socket is closed, -1 on error or timeout
+ */
+extern int32_t CJ_SOCKET_BufferWaitRecv(SocketBuffer* sockBuf, int64_t timeout)
+{
+    if (CJ_SocketIncreaseRef(sockBuf)) {
+        return 1;
+    }
+    long long handle = atomic_load(&sockBuf->handle);
+    int32_t ret = 0;
+    if (timeout < 0) {
+        ret = CJ_MRT_SockWaitRecv(handle);
+    } else {
+        // a timeout of zero is not allowed by the scheduler.
+        ret = CJ_MRT_SockWaitRecvTimeout(handle, timeout == 0 ? 1 : (uint64_t)timeout);
+    }
+    if (CJ_SocketDecreaseRef(sockBuf)) {
+        return 1;
+    }
+    return ret;
+}
+
+extern int32_t CJ_SOCKET_BufferWaitSend(SocketBuffer* sockBuf, int64_t timeout)
+{
+    if (CJ_SocketIncreaseRef(sockBuf)) {
+        return 1;
+    }
+    long long handle = atomic_load(&sockBuf->handle);
+    int32_t ret = 0;
+    if (timeout < 0) {
+        ret = CJ_MRT_SockWaitSend(handle);
+    } else {
+        ret = CJ_MRT_SockWaitSendTimeout(handle, timeout == 0 ? 1 : (uint64_t)timeout);
+    }
+    if (CJ_SocketDecreaseRef(sockBuf)) {
+        return 1;
+    }
+    return ret;
+}
+
 /**
  * Does close socket and derecare refcount causing memory removal if necessary.
  * The knownHandle different from -1 makes this function only work
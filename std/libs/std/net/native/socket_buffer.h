@@ -24,7 +24,18 @@ int32_t CJ_MRT_SockRecv(long long sock, const char* buf, unsigned int len, int f
 int32_t CJ_MRT_SockRecvTimeout(long long sock, const char* buf, unsigned int len, int flags, unsigned long long times);
 int32_t CJ_MRT_SockRecvfromTimeout(
     long long sock, void* buf, unsigned int len, int flags, struct SockAddr* addr, unsigned long long timeout);
+int32_t CJ_MRT_SockSendNonBlock(long long sock, const char* buf, unsigned int len, int flags);
+int32_t CJ_MRT_SockRecvNonBlock(long long sock, char* buf, unsigned int len, int flags);
+int32_t CJ_MRT_SockWaitSend(long long sock);
+int32_t CJ_MRT_SockWaitSendTimeout(long long sock, unsigned long long timeout);
+int32_t CJ_MRT_SockWaitRecv(long long sock);
+int32_t CJ_MRT_SockWaitRecvTimeout(long long sock, unsigned long long timeout);
 int32_t CJ_MRT_SockClose(long long sock);
 int32_t CJ_SockShutdown(long long sock);
 
+/* Native memory accounting of the runtime, the subsystem id matches NATIVE_SUBSYSTEM_SOCKET. */
+#define CJ_NATIVE_SUBSYSTEM_SOCKET 1
+void CJ_MCC_RegisterNativeAllocation(int32_t subsystem, size_t size);
+void CJ_MCC_RegisterNativeFree(int32_t subsystem, size_t size);
+
 #endif // CANGJIE_SOCKET_BUFFER_H
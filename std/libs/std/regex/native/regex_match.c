@@ -23,6 +23,11 @@
 #define ERR_MSG_LEN (256)
 #endif
 
+/* Native memory accounting of the runtime, the subsystem id matches NATIVE_SUBSYSTEM_REGEX. */
+#define CJ_NATIVE_SUBSYSTEM_REGEX 2
+extern void CJ_MCC_RegisterNativeAllocation(int32_t subsystem, size_t size);
+extern void CJ_MCC_RegisterNativeFree(int32_t subsystem, size_t size);
+
 typedef struct {
     pcre2_code* re;
     int errorCode;
@@ -46,6 +51,10 @@ extern CompileResult* CJ_REGEX_Compile(const unsigned char* pattern, const uint3
     PCRE2_SIZE errorOffset;
 
     pcre2_code* re = pcre2_compile(pattern, PCRE2_ZERO_TERMINATED, options, &errorCode, &errorOffset, NULL);
+    size_t codeSize;
+    if (re != NULL && pcre2_pattern_info(re, PCRE2_INFO_SIZE, &codeSize) == 0) {
+        CJ_MCC_RegisterNativeAllocation(CJ_NATIVE_SUBSYSTEM_REGEX, codeSize);
+    }
 
     result->re = re;
     result->errorCode = errorCode;
@@ -56,7 +65,11 @@ extern CompileResult* CJ_REGEX_Compile(const unsigned char* pattern, const uint3
 
 extern pcre2_match_data* CJ_REGEX_CreateMatchData(const pcre2_code* re)
 {
-    return pcre2_match_data_create_from_pattern(re, NULL);
+    pcre2_match_data* md = pcre2_match_data_create_from_pattern(re, NULL);
+    if (md != NULL) {
+        CJ_MCC_RegisterNativeAllocation(CJ_NATIVE_SUBSYSTEM_REGEX, pcre2_get_match_data_size(md));
+    }
+    return md;
 }
 
 extern int CJ_REGEX_Match(const pcre2_code* re, const unsigned char* subject, const PCRE2_SIZE length,
@@ -123,11 +136,18 @@ extern NamedTableInfo* CJ_REGEX_GetNameTableInfo(const pcre2_code* re)
 
 extern void CJ_REGEX_FreeCode(pcre2_code* re)
 {
+    size_t codeSize;
+    if (re != NULL && pcre2_pattern_info(re, PCRE2_INFO_SIZE, &codeSize) == 0) {
+        CJ_MCC_RegisterNativeFree(CJ_NATIVE_SUBSYSTEM_REGEX, codeSize);
+    }
     pcre2_code_free(re);
 }
 
 extern void CJ_REGEX_FreeMatchData(pcre2_match_data* md)
 {
+    if (md != NULL) {
+        CJ_MCC_RegisterNativeFree(CJ_NATIVE_SUBSYSTEM_REGEX, pcre2_get_match_data_size(md));
+    }
     pcre2_match_data_free(md);
 }
 